@@ -0,0 +1,308 @@
+/**
+ * @file    xbumparena.h
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ *
+ * 文件名称：xbumparena.h
+ * 创建日期：2019年04月01日
+ * 文件标识：
+ * 文件摘要：顺序分配（bump）的内存区域，以及适配 STL 容器的分配器，用于生命期一致的小对象（一次性整体释放）。
+ *
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2019年04月01日
+ * 版本摘要：
+ *
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#ifndef __XBUMPARENA_H__
+#define __XBUMPARENA_H__
+
+#include "xmempool.h"
+
+#include <stddef.h>
+#include <memory>
+#include <new>
+
+////////////////////////////////////////////////////////////////////////////////
+// x_bump_arena_t
+
+/**
+ * @class x_bump_arena_t
+ * @brief 顺序分配（bump）的内存区域。
+ *
+ * @note
+ * <pre>
+ *   1. 先从内嵌缓存中分配，不足时，从（构造时指定的）内存池申请内存块，继续顺序分配；
+ *   2. recyc() 只能回退最近一次分配的内存（后进先出），其他的内存直至 release() 时才一次性归还内存池；
+ *   3. release() 之后，此前分配的内存全部失效（其上的对象须已析构），对其调用 recyc() 为空操作；
+ *   4. 非线程安全，由所属对象的使用方保证串行访问。
+ * </pre>
+ */
+class x_bump_arena_t
+{
+    // common data types
+public:
+    /**
+     * @enum  emConstValue
+     * @brief 相关的枚举常量值。
+     */
+    typedef enum emConstValue
+    {
+        ECV_INLINE_SIZE = 256,        ///< 内嵌缓存的容量
+        ECV_CHUNK_SIZE  = 4 * 1024,   ///< 从内存池申请的内存块（最小）大小
+        ECV_ALIGN_SIZE  = 16,         ///< 分配的内存地址对齐值
+    } emConstValue;
+
+private:
+    /**
+     * @struct x_chunk_t
+     * @brief  从内存池申请的内存块头部（单向链表，其后为可分配的内存）。
+     */
+    typedef struct x_chunk_t
+    {
+        x_chunk_t * xnext_ptr;   ///< 链表中的前一内存块（较早申请的）
+        size_t      xst_size;    ///< 内存块的大小（含头部）
+    } x_chunk_t;
+
+    // constructor/destructor
+public:
+    explicit x_bump_arena_t(x_mempool_t & xmpool)
+        : m_xmpool(xmpool)
+        , m_xchunk_list(nullptr)
+        , m_xct_bpos(m_xct_inline)
+        , m_xct_epos(m_xct_inline + ECV_INLINE_SIZE)
+        , m_xct_last(nullptr)
+        , m_xst_nchunk(0)
+    {
+
+    }
+
+    ~x_bump_arena_t(void)
+    {
+        release();
+    }
+
+    x_bump_arena_t(x_bump_arena_t && xobject) = delete;
+    x_bump_arena_t & operator=(x_bump_arena_t && xobject) = delete;
+    x_bump_arena_t(const x_bump_arena_t & xobject) = delete;
+    x_bump_arena_t & operator=(const x_bump_arena_t & xobject) = delete;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 分配内存（按 ECV_ALIGN_SIZE 对齐）。
+     *
+     * @param [in ] xst_size : 内存大小。
+     *
+     * @return void *
+     *         - 成功，返回 内存地址；
+     *         - 失败，返回 nullptr（内存池申请失败）。
+     */
+    void * alloc(size_t xst_size)
+    {
+        xst_size = align_up(xst_size > 0 ? xst_size : 1);
+
+        if ((size_t)(m_xct_epos - m_xct_bpos) < xst_size)
+        {
+            if (!alloc_chunk(xst_size))
+                return nullptr;
+        }
+
+        m_xct_last  = m_xct_bpos;
+        m_xct_bpos += xst_size;
+
+        return m_xct_last;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 回收内存（仅最近一次分配的内存可回退，其他的为空操作）。
+     */
+    inline void recyc(void * xmem_ptr, size_t xst_size)
+    {
+        if ((nullptr != xmem_ptr) && (xmem_ptr == m_xct_last) &&
+            (m_xct_last + align_up(xst_size > 0 ? xst_size : 1) == m_xct_bpos))
+        {
+            m_xct_bpos = m_xct_last;
+            m_xct_last = nullptr;
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将所有内存块一次性归还内存池，恢复至初始状态（仅使用内嵌缓存）。
+     */
+    void release(void)
+    {
+        while (nullptr != m_xchunk_list)
+        {
+            x_chunk_t * xchunk_next = m_xchunk_list->xnext_ptr;
+            m_xmpool.recyc((mblock_t)m_xchunk_list);
+            m_xchunk_list = xchunk_next;
+        }
+
+        m_xct_bpos   = m_xct_inline;
+        m_xct_epos   = m_xct_inline + ECV_INLINE_SIZE;
+        m_xct_last   = nullptr;
+        m_xst_nchunk = 0;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 当前从内存池申请的内存块数量。
+     */
+    inline size_t chunk_count(void) const { return m_xst_nchunk; }
+
+    // internal invoking
+private:
+    /**********************************************************/
+    /**
+     * @brief 按 ECV_ALIGN_SIZE 向上对齐。
+     */
+    static inline size_t align_up(size_t xst_size)
+    {
+        return (xst_size + ECV_ALIGN_SIZE - 1) & ~((size_t)ECV_ALIGN_SIZE - 1);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从内存池申请新的内存块（可容纳 xst_size 大小的分配），作为当前的分配区域。
+     */
+    bool alloc_chunk(size_t xst_size)
+    {
+        size_t xst_csize = align_up(sizeof(x_chunk_t)) + xst_size;
+        if (xst_csize < ECV_CHUNK_SIZE)
+            xst_csize = ECV_CHUNK_SIZE;
+
+        x_chunk_t * xchunk_ptr = (x_chunk_t *)m_xmpool.alloc((msize_t)xst_csize);
+        if (nullptr == xchunk_ptr)
+        {
+            return false;
+        }
+
+        xchunk_ptr->xnext_ptr = m_xchunk_list;
+        xchunk_ptr->xst_size  = xst_csize;
+        m_xchunk_list = xchunk_ptr;
+        m_xst_nchunk += 1;
+
+        m_xct_bpos = (unsigned char *)xchunk_ptr + align_up(sizeof(x_chunk_t));
+        m_xct_epos = (unsigned char *)xchunk_ptr + xst_csize;
+        m_xct_last = nullptr;
+
+        return true;
+    }
+
+    // data members
+private:
+    x_mempool_t   & m_xmpool;       ///< 提供内存块的内存池
+    x_chunk_t     * m_xchunk_list;  ///< 已申请的内存块链表（表头为当前的分配区域）
+    unsigned char * m_xct_bpos;     ///< 当前分配区域中，下次分配的起始位置
+    unsigned char * m_xct_epos;     ///< 当前分配区域的结束位置
+    unsigned char * m_xct_last;     ///< 最近一次分配的内存地址（用于 recyc() 回退）
+    size_t          m_xst_nchunk;   ///< 已申请的内存块数量
+    alignas(ECV_ALIGN_SIZE) unsigned char m_xct_inline[ECV_INLINE_SIZE];  ///< 内嵌缓存
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// x_bump_allocator_t
+
+/**
+ * @class x_bump_allocator_t
+ * @brief 从 x_bump_arena_t 分配内存的 STL 分配器（deallocate() 仅回退最近一次的分配）。
+ * @note  容器之间的 移动/交换 操作随之转移分配器；所属的 x_bump_arena_t 执行 release() 前，
+ *        使用该分配器的容器须已释放其内存（如 与空容器交换）。
+ *
+ * @param [in ] _Ty : 分配的元素类型。
+ */
+template< typename _Ty >
+class x_bump_allocator_t
+{
+    template< typename _Uy > friend class x_bump_allocator_t;
+
+    // common data types
+public:
+    using value_type = _Ty;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    template< typename _Uy >
+    struct rebind
+    {
+        using other = x_bump_allocator_t< _Uy >;
+    };
+
+    // constructor/destructor
+public:
+    explicit x_bump_allocator_t(x_bump_arena_t * xarena_ptr)
+        : m_xarena_ptr(xarena_ptr)
+    {
+
+    }
+
+    template< typename _Uy >
+    x_bump_allocator_t(const x_bump_allocator_t< _Uy > & xobject)
+        : m_xarena_ptr(xobject.m_xarena_ptr)
+    {
+
+    }
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 分配 xst_count 个元素的内存（失败时抛出 std::bad_alloc 异常）。
+     */
+    _Ty * allocate(size_t xst_count)
+    {
+        void * xmem_ptr = m_xarena_ptr->alloc(xst_count * sizeof(_Ty));
+        if (nullptr == xmem_ptr)
+        {
+            throw std::bad_alloc();
+        }
+
+        return (_Ty *)xmem_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 回收内存（仅最近一次分配的内存可回退）。
+     */
+    inline void deallocate(_Ty * xmem_ptr, size_t xst_count)
+    {
+        m_xarena_ptr->recyc(xmem_ptr, xst_count * sizeof(_Ty));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回所使用的内存区域。
+     */
+    inline x_bump_arena_t * arena(void) const { return m_xarena_ptr; }
+
+    template< typename _Uy >
+    inline bool operator==(const x_bump_allocator_t< _Uy > & xobject) const
+    {
+        return (m_xarena_ptr == xobject.m_xarena_ptr);
+    }
+
+    template< typename _Uy >
+    inline bool operator!=(const x_bump_allocator_t< _Uy > & xobject) const
+    {
+        return (m_xarena_ptr != xobject.m_xarena_ptr);
+    }
+
+    // data members
+private:
+    x_bump_arena_t * m_xarena_ptr;  ///< 所使用的内存区域
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XBUMPARENA_H__
@@ -32,6 +32,7 @@
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <sched.h>
 #include <sys/syscall.h>
 #include <sys/time.h>
 #include <arpa/inet.h>
@@ -122,6 +123,99 @@ x_uint32_t get_tid(void)
 #endif // _MSC_VER
 }
 
+#ifndef _MSC_VER
+
+/**********************************************************/
+/**
+ * @brief 读取 cgroup 的 CPU 配额（向上取整后的核心数量）。
+ * 
+ * @return x_uint32_t
+ *         - 返回 0，表示未设置配额（或无法读取）。
+ */
+static x_uint32_t cgroup_cpu_quota(void)
+{
+    x_int64_t xlit_quota  = -1;
+    x_int64_t xlit_period = 0;
+    FILE    * xfile_ptr   = X_NULL;
+
+    // cgroup v2 : "max 100000" 或 "<quota> <period>"
+    xfile_ptr = fopen("/sys/fs/cgroup/cpu.max", "r");
+    if (X_NULL != xfile_ptr)
+    {
+        x_char_t xszt_quota[TEXT_LEN_32] = { '\0' };
+        if (2 == fscanf(xfile_ptr, "%31s %lld", xszt_quota, &xlit_period))
+        {
+            if (0 != strcmp(xszt_quota, "max"))
+                xlit_quota = (x_int64_t)atoll(xszt_quota);
+        }
+        fclose(xfile_ptr);
+
+        return ((xlit_quota > 0) && (xlit_period > 0)) ?
+               (x_uint32_t)((xlit_quota + xlit_period - 1) / xlit_period) : 0;
+    }
+
+    // cgroup v1
+    x_cstring_t xszt_dirs[] = { "/sys/fs/cgroup/cpu", "/sys/fs/cgroup/cpu,cpuacct" };
+    x_char_t    xszt_path[TEXT_LEN_256] = { '\0' };
+
+    for (x_uint32_t xut_iter = 0; xut_iter < sizeof(xszt_dirs) / sizeof(xszt_dirs[0]); ++xut_iter)
+    {
+        xlit_quota  = -1;
+        xlit_period = 0;
+
+        snprintf(xszt_path, TEXT_LEN_256, "%s/cpu.cfs_quota_us", xszt_dirs[xut_iter]);
+        xfile_ptr = fopen(xszt_path, "r");
+        if (X_NULL == xfile_ptr)
+            continue;
+        if (1 != fscanf(xfile_ptr, "%lld", &xlit_quota))
+            xlit_quota = -1;
+        fclose(xfile_ptr);
+
+        snprintf(xszt_path, TEXT_LEN_256, "%s/cpu.cfs_period_us", xszt_dirs[xut_iter]);
+        xfile_ptr = fopen(xszt_path, "r");
+        if (X_NULL == xfile_ptr)
+            continue;
+        if (1 != fscanf(xfile_ptr, "%lld", &xlit_period))
+            xlit_period = 0;
+        fclose(xfile_ptr);
+
+        return ((xlit_quota > 0) && (xlit_period > 0)) ?
+               (x_uint32_t)((xlit_quota + xlit_period - 1) / xlit_period) : 0;
+    }
+
+    return 0;
+}
+
+#endif // !_MSC_VER
+
+/**********************************************************/
+/**
+ * @brief 获取当前进程可使用的 CPU 核心数量。
+ */
+x_uint32_t get_cpu_limit(void)
+{
+    x_uint32_t xut_limit = (x_uint32_t)std::thread::hardware_concurrency();
+    if (0 == xut_limit)
+        xut_limit = 1;
+
+#ifndef _MSC_VER
+    cpu_set_t xcpu_set;
+    CPU_ZERO(&xcpu_set);
+    if (0 == sched_getaffinity(0, sizeof(cpu_set_t), &xcpu_set))
+    {
+        x_uint32_t xut_count = (x_uint32_t)CPU_COUNT(&xcpu_set);
+        if ((xut_count > 0) && (xut_count < xut_limit))
+            xut_limit = xut_count;
+    }
+
+    x_uint32_t xut_quota = cgroup_cpu_quota();
+    if ((xut_quota > 0) && (xut_quota < xut_limit))
+        xut_limit = xut_quota;
+#endif // !_MSC_VER
+
+    return xut_limit;
+}
+
 /**********************************************************/
 /**
  * @brief 从文件全路径名中，获取其文件名（例如：/Folder/filename.txt 返回 filename.txt）。
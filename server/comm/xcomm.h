@@ -183,6 +183,19 @@ x_uint32_t get_pid(void);
  */
 x_uint32_t get_tid(void);
 
+/**********************************************************/
+/**
+ * @brief 获取当前进程可使用的 CPU 核心数量。
+ * @note
+ * <pre>
+ *   取以下各值的最小者（至少为 1）：
+ *   1. std::thread::hardware_concurrency()；
+ *   2. 进程 CPU 亲和掩码（sched_getaffinity）中的核心数量；
+ *   3. cgroup 的 CPU 配额（v2：cpu.max；v1：cpu.cfs_quota_us / cpu.cfs_period_us），向上取整。
+ * </pre>
+ */
+x_uint32_t get_cpu_limit(void);
+
 /**********************************************************/
 /**
  * @brief 从文件全路径名中，获取其文件名（例如：/Folder/filename.txt 返回 filename.txt）。
@@ -8,24 +8,54 @@
  * 文件标识：
  * 文件摘要：内存池管理，实现多类型的内存块（不同内存块大小的）内存池。
  *
- * 当前版本：1.0.0.0
+ * 当前版本：2.5.0.0
  * 作    者：
- * 完成日期：2015年04月24日
- * 版本摘要：
+ * 完成日期：2019年03月31日
+ * 版本摘要：增加 NUMA 模式，各节点独立的 slab 管理信息，跨节点回收的内存块经远程回收栈惰性归还。
+ *
+ * 历史版本：2.4.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月30日
+ * 版本摘要：增加 snapshot() 接口，返回各个尺寸级别的统计信息。
+ *
+ * 历史版本：2.3.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月29日
+ * 版本摘要：增加 trim() 接口，在限定的时间预算内增量式释放空闲的 slab。
+ *
+ * 历史版本：2.2.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月28日
+ * 版本摘要：增加 内存区域（大页内存）模式，slab 从 mmap() 映射的内存区域中切分。
  *
- * 历史版本：
+ * 历史版本：2.1.0.0
  * 原作者  ：
- * 完成日期：
+ * 完成日期：2019年03月27日
+ * 版本摘要：增加线程本地缓存，稳态下的 申请/回收 操作无需加锁。
+ *
+ * 历史版本：2.0.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月26日
+ * 版本摘要：改为 固定尺寸分级（size class）的 slab 分配器，申请/回收操作均为 O(1)。
+ *
+ * 历史版本：1.0.0.0
+ * 原作者  ：
+ * 完成日期：2015年04月24日
  * 版本摘要：
  * </pre>
  */
 
 #include "xmempool.h"
 
+#include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <malloc.h>
 #include <assert.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <chrono>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -145,13 +175,161 @@ x_mempool_t::x_memlocker_t::~x_memlocker_t(void)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// x_mempool_t
 
-//====================================================================
+/**********************************************************/
+/**
+ * @brief 映射（按 xst_align 对齐的）内存区域：优先使用 MAP_HUGETLB，失败则映射普通页面，并建议使用透明大页。
+ *
+ * @param [in ] xst_size  : 内存区域大小。
+ * @param [in ] xst_align : 对齐值（大页内存的大小）。
+ * @param [out] xbt_huge  : 是否以 MAP_HUGETLB 映射。
+ *
+ * @return void *
+ *         - 成功，返回 内存区域的起始地址；
+ *         - 失败，返回 NULL。
+ */
+static void * mmap_arena(size_t xst_size, size_t xst_align, bool & xbt_huge)
+{
+    void * xmap_ptr = MAP_FAILED;
 
-// 
-// x_mempool_t : commom invoking
-// 
+    xbt_huge = false;
+
+#ifdef MAP_HUGETLB
+    xmap_ptr = mmap(NULL, xst_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (MAP_FAILED != xmap_ptr)
+    {
+        xbt_huge = true;
+        return xmap_ptr;
+    }
+#endif // MAP_HUGETLB
+
+    // 多映射 xst_align 大小，再裁剪首尾，得到对齐的内存区域（透明大页 须按大页大小对齐）
+    xmap_ptr = mmap(NULL, xst_size + xst_align, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (MAP_FAILED == xmap_ptr)
+    {
+        return NULL;
+    }
+
+    size_t xst_head = (xst_align - ((size_t)xmap_ptr % xst_align)) % xst_align;
+    if (xst_head > 0)
+    {
+        munmap(xmap_ptr, xst_head);
+    }
+    if (xst_align > xst_head)
+    {
+        munmap((unsigned char *)xmap_ptr + xst_head + xst_size, xst_align - xst_head);
+    }
+
+    xmap_ptr = (unsigned char *)xmap_ptr + xst_head;
+
+#ifdef MADV_HUGEPAGE
+    madvise(xmap_ptr, xst_size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+
+    return xmap_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 将（尚未访问过的）内存区域优先绑定至指定的 NUMA 节点（失败时忽略，仍按默认策略分配物理页面）。
+ */
+static void mbind_node(void * xmem_ptr, size_t xst_size, unsigned int mut_node)
+{
+#ifdef SYS_mbind
+    unsigned long xult_mask = 1UL << mut_node;
+    syscall(SYS_mbind, xmem_ptr, xst_size, 1 /* MPOL_PREFERRED */, &xult_mask, 8 * sizeof(xult_mask), 0);
+#else // !SYS_mbind
+    (void)xmem_ptr;
+    (void)xst_size;
+    (void)mut_node;
+#endif // SYS_mbind
+}
+
+/**********************************************************/
+/**
+ * @brief 返回系统的 NUMA 节点数量（不超过 mut_limit；无法获取时，返回 1）。
+ */
+static unsigned int numa_node_count(unsigned int mut_limit)
+{
+    unsigned int mut_count = 0;
+    char xszt_path[64];
+
+    for (; mut_count < mut_limit; ++mut_count)
+    {
+        snprintf(xszt_path, sizeof(xszt_path), "/sys/devices/system/node/node%u", mut_count);
+        if (0 != access(xszt_path, F_OK))
+            break;
+    }
+
+    return (mut_count > 0) ? mut_count : 1;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回当前线程所在的 NUMA 节点（每 x_mempool_t::ECV_NUMA_RECHECK 次调用才重新获取一次）。
+ */
+static unsigned int thread_numa_node(void)
+{
+    static thread_local unsigned int mut_node  = 0;
+    static thread_local unsigned int mut_ticks = 0;
+
+    if (0 == (mut_ticks++ % x_mempool_t::ECV_NUMA_RECHECK))
+    {
+#ifdef SYS_getcpu
+        unsigned int mut_cpu  = 0;
+        unsigned int mut_numa = 0;
+        if (0 == syscall(SYS_getcpu, &mut_cpu, &mut_numa, NULL))
+            mut_node = mut_numa;
+#endif // SYS_getcpu
+    }
+
+    return mut_node;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// x_mempool_t::x_mtlocal_t
+
+/**
+ * @struct x_mempool_t::x_mtlocal_t
+ * @brief  线程本地缓存表（以内存池的槽位为索引），线程退出时，将缓存的内存块归还至各自的内存池。
+ */
+struct x_mempool_t::x_mtlocal_t
+{
+    x_mtcache_t * xtc_slot[ECV_TCACHE_SLOTS];
+
+    x_mtlocal_t(void)
+    {
+        memset(xtc_slot, 0, sizeof(xtc_slot));
+    }
+
+    ~x_mtlocal_t(void)
+    {
+        for (unsigned int mut_iter = 0; mut_iter < ECV_TCACHE_SLOTS; ++mut_iter)
+        {
+            x_mtcache_t * xtc_ptr = xtc_slot[mut_iter];
+            if (NULL == xtc_ptr)
+                continue;
+
+            // 内存池已销毁，或已执行过 release_pool()，缓存的内存块已失效
+            x_mempool_t * xpool_ptr = xtc_ptr->xpool_ptr;
+            if ((NULL != xpool_ptr) &&
+                (xpool_ptr == _S_xpool_slot[mut_iter].load(std::memory_order_acquire)) &&
+                (xtc_ptr->mut_epoch == xpool_ptr->m_mut_epoch.load(std::memory_order_acquire)))
+            {
+                xpool_ptr->flush_tcache(xtc_ptr);
+            }
+
+            free(xtc_ptr);
+            xtc_slot[mut_iter] = NULL;
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// x_mempool_t
+
+std::atomic< x_mempool_t * > x_mempool_t::_S_xpool_slot[x_mempool_t::ECV_TCACHE_SLOTS];
+std::atomic< unsigned int >  x_mempool_t::_S_mut_epoch(0);
 
 //====================================================================
 
@@ -159,14 +337,62 @@ x_mempool_t::x_memlocker_t::~x_memlocker_t(void)
 // x_mempool_t : constructor/destructor
 // 
 
-x_mempool_t::x_mempool_t(void)
+x_mempool_t::x_mempool_t(unsigned int mut_flags /* = 0 */)
+    : m_st_alloc_size(0)
+    , m_st_recyc_size(0)
+    , m_mut_flags(mut_flags)
+    , m_mut_nnodes((0 != (mut_flags & EMP_NUMA)) ? numa_node_count(ECV_NUMA_NODES) : 1)
+    , m_mut_tslot(ECV_TCACHE_SLOTS)
+    , m_mut_epoch(_S_mut_epoch.fetch_add(1, std::memory_order_relaxed) + 1)
+    , m_ullt_tc_hits(0)
+    , m_ullt_tc_miss(0)
+    , m_mut_trim_next(0)
 {
-    m_st_alloc_size = 0;
-    m_st_recyc_size = 0;
+    for (unsigned int mut_node = 0; mut_node < ECV_NUMA_NODES; ++mut_node)
+    {
+        m_xarena_list[mut_node] = NULL;
+
+        for (unsigned int mut_iter = 0; mut_iter <= ECV_CLASS_COUNT; ++mut_iter)
+        {
+            x_mclass_t & xclass = m_xclass[mut_node][mut_iter];
+
+            for (unsigned int mut_list = 0; mut_list < EMS_COUNT; ++mut_list)
+            {
+                xclass.xlst_slab[mut_list].xhead_ptr = NULL;
+                xclass.xlst_slab[mut_list].xtail_ptr = NULL;
+            }
+
+            xclass.mst_nslab = 0;
+            xclass.mst_nlive = 0;
+            xclass.mst_nfree = 0;
+            xclass.mst_npeak = 0;
+            xclass.ullt_nalloc.store(0, std::memory_order_relaxed);
+            xclass.ullt_rbytes.store(0, std::memory_order_relaxed);
+            xclass.ullt_abytes.store(0, std::memory_order_relaxed);
+            xclass.ullt_remote.store(0, std::memory_order_relaxed);
+            xclass.mbt_remote.store(NULL, std::memory_order_relaxed);
+        }
+    }
+
+    // 占用空闲的线程本地缓存槽位
+    for (unsigned int mut_iter = 0; (0 != (mut_flags & EMP_TCACHE)) && (mut_iter < ECV_TCACHE_SLOTS); ++mut_iter)
+    {
+        x_mempool_t * xpool_null = NULL;
+        if (_S_xpool_slot[mut_iter].compare_exchange_strong(xpool_null, this, std::memory_order_acq_rel))
+        {
+            m_mut_tslot = mut_iter;
+            break;
+        }
+    }
 }
 
 x_mempool_t::~x_mempool_t(void)
 {
+    if (m_mut_tslot < ECV_TCACHE_SLOTS)
+    {
+        _S_xpool_slot[m_mut_tslot].store(NULL, std::memory_order_release);
+    }
+
     release_pool();
 }
 
@@ -188,31 +414,56 @@ x_mempool_t::~x_mempool_t(void)
  */
 mblock_t x_mempool_t::alloc(msize_t mst_size)
 {
-    mblock_t memblock = NULL;
-
     if ((mst_size <= 0) || (mst_size > 0x7FFFFFFF))
     {
         return NULL;
     }
 
-    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_locker);
-
-    msize_t mst_xsize = align_size(mst_size);
-
-    do 
+    unsigned int  mut_node  = local_node();
+    unsigned int  mut_class = size_class(mst_size);
+    x_mtcache_t * xtc_ptr   = (mut_class < ECV_TCACHE_CLASS) ? tcache() : NULL;
+    if (NULL == xtc_ptr)
     {
-        memblock = pop_recyc_block(mst_xsize);
+        mblock_t memblock = alloc_chunk(mut_node, mut_class, mst_size);
         if (NULL != memblock)
-            break;
+        {
+            x_mclass_t & xclass = m_xclass[mut_node][mut_class];
+            xclass.ullt_nalloc.fetch_add(1, std::memory_order_relaxed);
+            xclass.ullt_rbytes.fetch_add(mst_size, std::memory_order_relaxed);
+            xclass.ullt_abytes.fetch_add(
+                ((x_mchunk_t *)(memblock - ECV_CHUNK_HSIZE))->xslab_ptr->mst_csize, std::memory_order_relaxed);
+        }
 
-        memblock = (mblock_t)malloc(mst_xsize);
-        if (NULL == memblock)
-            break;
+        return memblock;
+    }
 
-        m_map_alloc.insert(std::pair< mblock_t, msize_t >(memblock, mst_xsize));
-        m_st_alloc_size += mst_xsize;
+    //======================================
+    // 从线程本地缓存中取出内存块，缓存为空时，从 slab 批量取出
 
-    } while (0);
+    x_mtbin_t & xbin = xtc_ptr->xbin[mut_class];
+    if (0 == xbin.mut_count)
+    {
+        xbin.mut_count = alloc_batch(mut_node, mut_class, xbin.mbt_block, tcache_batch(mut_class));
+        m_ullt_tc_miss.fetch_add(1, std::memory_order_relaxed);
+        if (0 == xbin.mut_count)
+        {
+            return NULL;
+        }
+    }
+    else
+    {
+        xbin.mut_nhits += 1;
+    }
+
+    xbin.mut_nalloc  += 1;
+    xbin.ullt_rbytes += mst_size;
+    if (xbin.mut_nalloc >= ECV_TCACHE_PUBLISH)
+    {
+        publish_tcbin(mut_class, xbin);
+    }
+
+    mblock_t memblock = xbin.mbt_block[--xbin.mut_count];
+    ((x_mchunk_t *)(memblock - ECV_CHUNK_HSIZE))->mut_magic = ECV_MAGIC_USED;
 
     return memblock;
 }
@@ -237,35 +488,27 @@ mblock_t x_mempool_t::ralloc(mblock_t mbt_dptr, msize_t mst_size)
         return NULL;
     }
 
-    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_locker);
-
-    msize_t mst_xsize = align_size(mst_size);
-
     do 
     {
-        mapblock_t::iterator itfind = m_map_alloc.find(mbt_dptr);
-        if (itfind == m_map_alloc.end())
+        x_mchunk_t * xchunk_ptr = chunk_of(mbt_dptr);
+        if (NULL == xchunk_ptr)
         {
             break;
         }
 
-        if (itfind->second >= mst_xsize)
+        msize_t mst_csize = xchunk_ptr->xslab_ptr->mst_csize;
+        if (mst_csize >= mst_size)
         {
             memblock = mbt_dptr;
             break;
         }
 
-        memblock = pop_recyc_block(mst_xsize);
-        if (NULL == memblock)
-            memblock = (mblock_t)malloc(mst_xsize);
+        memblock = alloc(mst_size);
         if (NULL == memblock)
             break;
 
-        memcpy(memblock, mbt_dptr, itfind->second);
-        push_recyc_block(mbt_dptr);
-
-        m_map_alloc.insert(std::pair< mblock_t, msize_t >(memblock, mst_xsize));
-        m_st_alloc_size += mst_xsize;
+        memcpy(memblock, mbt_dptr, mst_csize);
+        recyc(mbt_dptr);
 
     } while (0);
 
@@ -293,27 +536,11 @@ mblock_t x_mempool_t::zalloc(msize_t mst_memb_nums, msize_t mst_memb_size)
         return NULL;
     }
 
-    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_locker);
-
-    msize_t mst_xsize = align_size(mst_zalloc_size);
-
-    do 
+    memblock = alloc(mst_zalloc_size);
+    if (NULL != memblock)
     {
-        memblock = pop_recyc_block(mst_xsize);
-        if (NULL != memblock)
-        {
-            memset(memblock, 0, mst_xsize);
-            break;
-        }
-
-        memblock = (mblock_t)calloc(mst_xsize, 1);
-        if (NULL == memblock)
-            break;
-
-        m_map_alloc.insert(std::pair< mblock_t, msize_t >(memblock, mst_xsize));
-        m_st_alloc_size += mst_xsize;
-
-    } while (0);
+        memset(memblock, 0, ((x_mchunk_t *)(memblock - ECV_CHUNK_HSIZE))->xslab_ptr->mst_csize);
+    }
 
     return memblock;
 }
@@ -330,8 +557,126 @@ mblock_t x_mempool_t::zalloc(msize_t mst_memb_nums, msize_t mst_memb_size)
  */
 bool x_mempool_t::recyc(mblock_t mbt_dptr)
 {
-    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_locker);
-    return push_recyc_block(mbt_dptr);
+    if (NULL == mbt_dptr)
+    {
+        return false;
+    }
+
+    x_mchunk_t * xchunk_ptr = (x_mchunk_t *)(mbt_dptr - ECV_CHUNK_HSIZE);
+    x_mslab_t  * xslab_ptr  = xchunk_ptr->xslab_ptr;
+
+    // 防止重复回收相同的内存块
+    if ((ECV_MAGIC_FREE   == xchunk_ptr->mut_magic) ||
+        (ECV_MAGIC_TCACHE == xchunk_ptr->mut_magic) ||
+        (ECV_MAGIC_REMOTE == xchunk_ptr->mut_magic))
+    {
+        return (NULL != xslab_ptr) && (this == xslab_ptr->xpool_ptr);
+    }
+
+    if (NULL == chunk_of(mbt_dptr))
+    {
+        return false;
+    }
+
+    unsigned int mut_class = xchunk_ptr->mut_class;
+
+    // 其他节点的内存块，压入所属节点的远程回收栈，由所属节点惰性归还（巨型内存块除外）
+    if ((m_mut_nnodes > 1) && (mut_class < ECV_CLASS_COUNT) && (xslab_ptr->mut_node != local_node()))
+    {
+        remote_push(xchunk_ptr);
+        return true;
+    }
+
+    x_mtcache_t * xtc_ptr = (mut_class < ECV_TCACHE_CLASS) ? tcache() : NULL;
+    if (NULL == xtc_ptr)
+    {
+        x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)class_of(xslab_ptr).xmt_locker);
+        if (ECV_MAGIC_USED == xchunk_ptr->mut_magic)
+        {
+            recyc_chunk(xchunk_ptr);
+        }
+
+        return true;
+    }
+
+    //======================================
+    // 压入线程本地缓存，超出容量时，将较早压入的一半批量归还至 slab
+
+    x_mtbin_t & xbin = xtc_ptr->xbin[mut_class];
+
+    xchunk_ptr->mut_magic = ECV_MAGIC_TCACHE;
+    xbin.mbt_block[xbin.mut_count++] = mbt_dptr;
+
+    unsigned int mut_batch = tcache_batch(mut_class);
+    if (xbin.mut_count >= 2 * mut_batch)
+    {
+        recyc_batch(mut_class, xbin.mbt_block, mut_batch);
+        xbin.mut_count -= mut_batch;
+        memmove(xbin.mbt_block, xbin.mbt_block + mut_batch, xbin.mut_count * sizeof(mblock_t));
+    }
+
+    return true;
+}
+
+/**********************************************************/
+/**
+ * @brief 将当前线程的本地缓存中所有内存块归还至 slab。
+ */
+void x_mempool_t::flush_tcache(void)
+{
+    x_mtcache_t * xtc_ptr = tcache();
+    if (NULL != xtc_ptr)
+    {
+        flush_tcache(xtc_ptr);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 读取各个尺寸级别的统计信息快照（末项为巨型内存块）。
+ *
+ * @param [out] xstat_ptr : 操作返回的统计信息数组。
+ * @param [in ] mut_count : 统计信息数组的容量（至多返回 ECV_CLASS_COUNT + 1 项）。
+ *
+ * @return unsigned int
+ *         - 返回 写入 xstat_ptr 的项数。
+ */
+unsigned int x_mempool_t::snapshot(x_mpstat_t * xstat_ptr, unsigned int mut_count) const
+{
+    if (NULL == xstat_ptr)
+    {
+        return 0;
+    }
+
+    if (mut_count > ECV_CLASS_COUNT + 1)
+    {
+        mut_count = ECV_CLASS_COUNT + 1;
+    }
+
+    for (unsigned int mut_iter = 0; mut_iter < mut_count; ++mut_iter)
+    {
+        x_mpstat_t & xstat = xstat_ptr[mut_iter];
+        memset(&xstat, 0, sizeof(x_mpstat_t));
+        xstat.mst_csize = (mut_iter < ECV_CLASS_COUNT) ? class_size(mut_iter) : 0;
+
+        for (unsigned int mut_node = 0; mut_node < m_mut_nnodes; ++mut_node)
+        {
+            x_mclass_t & xclass = m_xclass[mut_node][mut_iter];
+
+            xstat.ullt_nalloc += xclass.ullt_nalloc.load(std::memory_order_relaxed);
+            xstat.ullt_rbytes += xclass.ullt_rbytes.load(std::memory_order_relaxed);
+            xstat.ullt_abytes += xclass.ullt_abytes.load(std::memory_order_relaxed);
+            xstat.ullt_remote += xclass.ullt_remote.load(std::memory_order_relaxed);
+
+            x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)xclass.xmt_locker);
+            xstat.mst_nslab += xclass.mst_nslab;
+            xstat.mst_nlive += xclass.mst_nlive;
+            xstat.mst_nfree += xclass.mst_nfree;
+            xstat.mst_npeak += xclass.mst_npeak;
+        }
+    }
+
+    return mut_count;
 }
 
 /**********************************************************/
@@ -343,33 +688,82 @@ bool x_mempool_t::recyc(mblock_t mbt_dptr)
  */
 void x_mempool_t::release_timeout_memblock(mtime_t mtt_timeout)
 {
-    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_locker);
-
     mtime_t mtt_now = (mtime_t)time(NULL);
 
-    mmapblock_t::iterator itmmap = m_mmap_recyc.begin();
-    for (; itmmap != m_mmap_recyc.end(); )
+    for (unsigned int mut_iter = 0; mut_iter < m_mut_nnodes * ECV_CLASS_COUNT; ++mut_iter)
     {
-        if (mtt_now >= (mtt_timeout + itmmap->second.second))
+        x_mclass_t & xclass = m_xclass[mut_iter / ECV_CLASS_COUNT][mut_iter % ECV_CLASS_COUNT];
+        x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)xclass.xmt_locker);
+
+        remote_drain(xclass);
+
+        // 链表尾部的 slab 最早变为空闲状态，遇到未超时的即可结束
+        x_mslab_t * xslab_ptr = xclass.xlst_slab[EMS_EMPTY].xtail_ptr;
+        while ((NULL != xslab_ptr) && (mtt_now >= (mtt_timeout + xslab_ptr->mtt_empty)))
         {
-            m_st_alloc_size -= itmmap->first;
-            m_st_recyc_size -= itmmap->first;
+            x_mslab_t * xslab_prev = xslab_ptr->xprev_ptr;
+            destroy_slab(xslab_ptr);
+            xslab_ptr = xslab_prev;
+        }
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 增量式释放空闲的 slab（适合后台定时调用，不会长时间阻塞 申请/回收 操作）。
+ *
+ * @param [in ] mst_retain    : 保留的空闲内存大小（目标值）。
+ * @param [in ] mtt_idle      : slab 的最短空闲时间（单位按 秒 计）。
+ * @param [in ] mut_budget_us : 本次操作的时间预算（单位按 微秒 计）。
+ *
+ * @return msize_t
+ *         - 返回 释放的内存大小。
+ */
+msize_t x_mempool_t::trim(msize_t mst_retain, mtime_t mtt_idle, unsigned int mut_budget_us)
+{
+    using x_clock_t = std::chrono::steady_clock;
 
-            mblock_t mbt_dptr = itmmap->second.first;
-            m_mset_recyc.erase(mbt_dptr);
-            m_mmap_recyc.erase(itmmap++);
-            m_map_alloc.erase(mbt_dptr);
+    x_clock_t::time_point xtm_deadline = x_clock_t::now() + std::chrono::microseconds(mut_budget_us);
+    mtime_t      mtt_now      = (mtime_t)time(NULL);
+    msize_t      mst_released = 0;
+    unsigned int mut_missed   = 0;
 
-            if (NULL != mbt_dptr)
-            {
-                free(mbt_dptr);
-            }
+    // 连续（所有节点的）ECV_CLASS_COUNT 个尺寸级别均无可释放的 slab 时，结束操作
+    unsigned int mut_nclass = m_mut_nnodes * ECV_CLASS_COUNT;
+    while ((recyc_size() > mst_retain) && (mut_missed < mut_nclass))
+    {
+        unsigned int mut_iter  = m_mut_trim_next.fetch_add(1, std::memory_order_relaxed) % mut_nclass;
+        x_mslab_t  * xslab_ptr = NULL;
+
+        {
+            x_mclass_t & xclass = m_xclass[mut_iter / ECV_CLASS_COUNT][mut_iter % ECV_CLASS_COUNT];
+            x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)xclass.xmt_locker);
+
+            remote_drain(xclass);
+
+            xslab_ptr = xclass.xlst_slab[EMS_EMPTY].xtail_ptr;
+            if ((NULL != xslab_ptr) && (mtt_now >= (mtt_idle + xslab_ptr->mtt_empty)))
+                mst_released += unlink_slab(xslab_ptr);
+            else
+                xslab_ptr = NULL;
         }
-        else
+
+        if (NULL == xslab_ptr)
+        {
+            mut_missed += 1;
+            continue;
+        }
+
+        mut_missed = 0;
+        free_slab(xslab_ptr);
+
+        if (x_clock_t::now() >= xtm_deadline)
         {
-            ++itmmap;
+            break;
         }
     }
+
+    return mst_released;
 }
 
 /**********************************************************/
@@ -378,114 +772,676 @@ void x_mempool_t::release_timeout_memblock(mtime_t mtt_timeout)
  */
 void x_mempool_t::release_pool(void)
 {
-    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_locker);
+    // 更新时代值，令各个线程本地缓存中的内存块失效
+    m_mut_epoch.store(_S_mut_epoch.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_release);
 
-    mapblock_t::iterator itmap = m_map_alloc.begin();
-    for (; itmap != m_map_alloc.end(); ++itmap)
+    for (unsigned int mut_iter = 0; mut_iter < m_mut_nnodes * (ECV_CLASS_COUNT + 1); ++mut_iter)
     {
-        mblock_t mbt_dptr = itmap->first;
+        x_mclass_t & xclass = m_xclass[mut_iter / (ECV_CLASS_COUNT + 1)][mut_iter % (ECV_CLASS_COUNT + 1)];
+        x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)xclass.xmt_locker);
 
+        // 远程回收栈中的内存块，随所属的 slab 一并释放
+        xclass.mbt_remote.store(NULL, std::memory_order_relaxed);
+
+        for (unsigned int mut_list = 0; mut_list < EMS_COUNT; ++mut_list)
+        {
+            while (NULL != xclass.xlst_slab[mut_list].xhead_ptr)
+            {
 #ifdef MP_DEBUG_VIEW
-        m_mset_recyc.erase(mbt_dptr);
+                if (xclass.xlst_slab[mut_list].xhead_ptr->mut_nused > 0)
+                {
+                    TRACE("memory leak in slab : %p\n", xclass.xlst_slab[mut_list].xhead_ptr);
+                }
 #endif // MP_DEBUG_VIEW
 
-        if (NULL != mbt_dptr)
-        {
-            free(mbt_dptr);
+                destroy_slab(xclass.xlst_slab[mut_list].xhead_ptr);
+            }
         }
     }
+}
 
-#ifdef MP_DEBUG_VIEW
-    msetblock_t::iterator itmset = m_mset_recyc.begin();
-    for (; itmset != m_mset_recyc.end(); ++itmset)
+//====================================================================
+
+// 
+// x_mempool_t : inner invoking methods
+// 
+
+/**********************************************************/
+/**
+ * @brief 校验内存块地址，返回其块头部。
+ *
+ * @param [in ] mbt_dptr : 内存块地址。
+ *
+ * @return x_mchunk_t *
+ *         - 成功，返回 块头部；
+ *         - 失败，返回 NULL，表示内存块并非本对象所管理，或已处于回收状态。
+ */
+x_mempool_t::x_mchunk_t * x_mempool_t::chunk_of(mblock_t mbt_dptr) const
+{
+    if (NULL == mbt_dptr)
     {
-        TRACE("memory leak in address : %08X\n", (msize_t)*itmset);
+        return NULL;
     }
-#endif // MP_DEBUG_VIEW
 
-    m_map_alloc.clear();
-    m_mset_recyc.clear();
-    m_mmap_recyc.clear();
+    x_mchunk_t * xchunk_ptr = (x_mchunk_t *)(mbt_dptr - ECV_CHUNK_HSIZE);
+    if ((ECV_MAGIC_USED != xchunk_ptr->mut_magic) ||
+        (xchunk_ptr->mut_class > ECV_CLASS_COUNT) ||
+        (NULL == xchunk_ptr->xslab_ptr) ||
+        (this != xchunk_ptr->xslab_ptr->xpool_ptr))
+    {
+        return NULL;
+    }
 
-    m_st_alloc_size = 0;
-    m_st_recyc_size = 0;
+    return xchunk_ptr;
 }
 
-//====================================================================
+/**********************************************************/
+/**
+ * @brief 返回当前线程所在的节点（在内存池使用的节点范围内；未启用 NUMA 模式时，总是为 0）。
+ */
+unsigned int x_mempool_t::local_node(void) const
+{
+    if (m_mut_nnodes <= 1)
+    {
+        return 0;
+    }
 
-// 
-// x_mempool_t : inner invoking methods
-// 
+    return thread_numa_node() % m_mut_nnodes;
+}
+
+/**********************************************************/
+/**
+ * @brief 将（已校验过的）其他节点的内存块压入所属节点的远程回收栈（无锁操作）。
+ */
+void x_mempool_t::remote_push(x_mchunk_t * xchunk_ptr)
+{
+    x_mclass_t & xclass    = class_of(xchunk_ptr->xslab_ptr);
+    mblock_t     mbt_chunk = (mblock_t)xchunk_ptr;
+    mblock_t     mbt_head  = xclass.mbt_remote.load(std::memory_order_relaxed);
+
+    xchunk_ptr->mut_magic = ECV_MAGIC_REMOTE;
+
+    // 只压入、一次性整体弹出（remote_drain()），不存在 ABA 问题
+    do
+    {
+        *(mblock_t *)(mbt_chunk + ECV_CHUNK_HSIZE) = mbt_head;
+    } while (!xclass.mbt_remote.compare_exchange_weak(mbt_head, mbt_chunk,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed));
+}
+
+/**********************************************************/
+/**
+ * @brief 将远程回收栈中的内存块归还至 slab（调用方须持有尺寸级别的访问控制锁）。
+ */
+void x_mempool_t::remote_drain(x_mclass_t & xclass)
+{
+    if (NULL == xclass.mbt_remote.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    mblock_t mbt_chunk = xclass.mbt_remote.exchange(NULL, std::memory_order_acquire);
+    unsigned long long ullt_count = 0;
+
+    while (NULL != mbt_chunk)
+    {
+        mblock_t mbt_next = *(mblock_t *)(mbt_chunk + ECV_CHUNK_HSIZE);
+        recyc_chunk((x_mchunk_t *)mbt_chunk);
+        mbt_chunk   = mbt_next;
+        ullt_count += 1;
+    }
+
+    xclass.ullt_remote.fetch_add(ullt_count, std::memory_order_relaxed);
+}
 
 /**********************************************************/
 /**
- * @brief 按指定的大小从回收的内存块中取出内存块。
+ * @brief 从指定尺寸级别的 slab 中申请内存块。
  *
- * @param [in ] mst_size : 指定的内存块大小。
+ * @param [in ] mut_node  : 所在的节点。
+ * @param [in ] mut_class : 尺寸级别。
+ * @param [in ] mst_size  : 申请的内存块长度（仅对巨型内存块有效）。
  *
  * @return mblock_t
- *         - 成功，返回 内存块 地址；
+ *         - 成功，返回 内存块地址；
  *         - 失败，返回 NULL。
  */
-mblock_t x_mempool_t::pop_recyc_block(msize_t mst_size)
+mblock_t x_mempool_t::alloc_chunk(unsigned int mut_node, unsigned int mut_class, msize_t mst_size)
 {
-    mblock_t mbt_dptr = NULL;
+    x_mclass_t & xclass = m_xclass[mut_node][mut_class];
+    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)xclass.xmt_locker);
 
-    do 
+    remote_drain(xclass);
+
+    x_mslab_t * xslab_ptr = (mut_class >= ECV_CLASS_COUNT) ?
+                            create_slab(mut_node, mut_class, align_size(mst_size)) : pick_slab(mut_node, mut_class);
+    if (NULL == xslab_ptr)
     {
-        if (m_mmap_recyc.empty())
-            break;
+        return NULL;
+    }
+
+    return carve_chunk(xslab_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 从指定尺寸级别的 slab 中批量申请内存块（只加锁一次）。
+ *
+ * @param [in ] mut_node  : 所在的节点。
+ * @param [in ] mut_class : 尺寸级别（不可为巨型内存块）。
+ * @param [out] mbt_block : 操作成功返回的内存块。
+ * @param [in ] mut_count : 申请的内存块数量。
+ *
+ * @return unsigned int
+ *         - 返回 成功申请的内存块数量。
+ */
+unsigned int x_mempool_t::alloc_batch(unsigned int mut_node, unsigned int mut_class, mblock_t * mbt_block, unsigned int mut_count)
+{
+    assert(mut_class < ECV_CLASS_COUNT);
+
+    x_mclass_t & xclass = m_xclass[mut_node][mut_class];
+    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)xclass.xmt_locker);
 
-        mmapblock_t::iterator itfind = m_mmap_recyc.find(mst_size);
-        if (itfind == m_mmap_recyc.end())
+    remote_drain(xclass);
+
+    unsigned int mut_iter = 0;
+    for (; mut_iter < mut_count; ++mut_iter)
+    {
+        x_mslab_t * xslab_ptr = pick_slab(mut_node, mut_class);
+        if (NULL == xslab_ptr)
             break;
 
-        mbt_dptr = itfind->second.first;
+        mbt_block[mut_iter] = carve_chunk(xslab_ptr);
+        ((x_mchunk_t *)(mbt_block[mut_iter] - ECV_CHUNK_HSIZE))->mut_magic = ECV_MAGIC_TCACHE;
+    }
 
-        m_mset_recyc.erase(mbt_dptr);
-        m_mmap_recyc.erase(itfind);
+    return mut_iter;
+}
 
-        m_st_recyc_size -= mst_size;
+/**********************************************************/
+/**
+ * @brief 将（已校验过的）同一尺寸级别的内存块批量回收至 slab（同一节点的连续内存块只加锁一次）。
+ */
+void x_mempool_t::recyc_batch(unsigned int mut_class, mblock_t * mbt_block, unsigned int mut_count)
+{
+    unsigned int mut_iter = 0;
 
-    } while (0);
+    // 线程迁移至其他节点后，本地缓存中可能混有多个节点的内存块，按节点分段加锁
+    while (mut_iter < mut_count)
+    {
+        x_mslab_t * xslab_ptr = ((x_mchunk_t *)(mbt_block[mut_iter] - ECV_CHUNK_HSIZE))->xslab_ptr;
+        unsigned int mut_node = xslab_ptr->mut_node;
 
-    return mbt_dptr;
+        x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xclass[mut_node][mut_class].xmt_locker);
+
+        for (; mut_iter < mut_count; ++mut_iter)
+        {
+            x_mchunk_t * xchunk_ptr = (x_mchunk_t *)(mbt_block[mut_iter] - ECV_CHUNK_HSIZE);
+            if (xchunk_ptr->xslab_ptr->mut_node != mut_node)
+                break;
+
+            recyc_chunk(xchunk_ptr);
+        }
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 确定可用于申请内存块的 slab：部分使用的 > 最近变为空闲的 > 新建的（调用方须持有尺寸级别的访问控制锁）。
+ */
+x_mempool_t::x_mslab_t * x_mempool_t::pick_slab(unsigned int mut_node, unsigned int mut_class)
+{
+    x_mclass_t & xclass = m_xclass[mut_node][mut_class];
+
+    if (NULL != xclass.xlst_slab[EMS_PARTIAL].xhead_ptr)
+    {
+        return xclass.xlst_slab[EMS_PARTIAL].xhead_ptr;
+    }
+
+    x_mslab_t * xslab_ptr = xclass.xlst_slab[EMS_EMPTY].xhead_ptr;
+    if (NULL != xslab_ptr)
+    {
+        move_slab(xslab_ptr, EMS_PARTIAL);
+        return xslab_ptr;
+    }
+
+    return create_slab(mut_node, mut_class, class_size(mut_class));
 }
 
 /**********************************************************/
 /**
- * @brief 将内存块压入回收的内存块管理队列中。
+ * @brief 从 slab 中取出一个内存块（调用方须持有尺寸级别的访问控制锁）。
+ */
+mblock_t x_mempool_t::carve_chunk(x_mslab_t * xslab_ptr)
+{
+    mblock_t mbt_chunk = NULL;
+
+    // 优先取空闲链表中的内存块，其次从尚未切分的区域切分
+    if (NULL != xslab_ptr->mbt_free)
+    {
+        mbt_chunk = xslab_ptr->mbt_free;
+        xslab_ptr->mbt_free = *(mblock_t *)(mbt_chunk + ECV_CHUNK_HSIZE);
+    }
+    else
+    {
+        mbt_chunk = xslab_ptr->mbt_bump;
+        xslab_ptr->mbt_bump += ECV_CHUNK_HSIZE + xslab_ptr->mst_csize;
+
+        ((x_mchunk_t *)mbt_chunk)->xslab_ptr = xslab_ptr;
+        ((x_mchunk_t *)mbt_chunk)->mut_class = xslab_ptr->mut_class;
+    }
+
+    ((x_mchunk_t *)mbt_chunk)->mut_magic = ECV_MAGIC_USED;
+    m_st_recyc_size.fetch_sub(xslab_ptr->mst_csize, std::memory_order_relaxed);
+
+    x_mclass_t & xclass = class_of(xslab_ptr);
+    xclass.mst_nfree -= 1;
+    if (++xclass.mst_nlive > xclass.mst_npeak)
+        xclass.mst_npeak = xclass.mst_nlive;
+
+    if (++xslab_ptr->mut_nused == xslab_ptr->mut_total)
+    {
+        move_slab(xslab_ptr, EMS_FULL);
+    }
+
+    return (mbt_chunk + ECV_CHUNK_HSIZE);
+}
+
+/**********************************************************/
+/**
+ * @brief 将内存块归还至所属的 slab（调用方须持有尺寸级别的访问控制锁）。
+ */
+void x_mempool_t::recyc_chunk(x_mchunk_t * xchunk_ptr)
+{
+    x_mslab_t * xslab_ptr = xchunk_ptr->xslab_ptr;
+
+    xchunk_ptr->mut_magic = ECV_MAGIC_FREE;
+
+    // 巨型内存块，直接释放
+    if (xchunk_ptr->mut_class >= ECV_CLASS_COUNT)
+    {
+        destroy_slab(xslab_ptr);
+        return;
+    }
+
+    *(mblock_t *)((mblock_t)xchunk_ptr + ECV_CHUNK_HSIZE) = xslab_ptr->mbt_free;
+    xslab_ptr->mbt_free = (mblock_t)xchunk_ptr;
+    m_st_recyc_size.fetch_add(xslab_ptr->mst_csize, std::memory_order_relaxed);
+
+    class_of(xslab_ptr).mst_nlive -= 1;
+    class_of(xslab_ptr).mst_nfree += 1;
+
+    if (0 == --xslab_ptr->mut_nused)
+    {
+        xslab_ptr->mtt_empty = (mtime_t)time(NULL);
+        move_slab(xslab_ptr, EMS_EMPTY);
+    }
+    else if (EMS_FULL == xslab_ptr->mut_list)
+    {
+        move_slab(xslab_ptr, EMS_PARTIAL);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 创建 slab（调用方须持有尺寸级别的访问控制锁）。
  *
- * @param [in ] memblock : 回收的内存块。
+ * @param [in ] mut_node  : 所属的节点。
+ * @param [in ] mut_class : 尺寸级别。
+ * @param [in ] mst_csize : 内存块的大小。
  *
- * @return bool
- *         - 成功，返回 true；
- *         - 失败，返回 false，表示所要回收的内存块并非池管理的内存块。
+ * @return x_mslab_t *
+ *         - 成功，返回 slab 对象；
+ *         - 失败，返回 NULL。
  */
-bool x_mempool_t::push_recyc_block(mblock_t mbt_dptr)
+x_mempool_t::x_mslab_t * x_mempool_t::create_slab(unsigned int mut_node, unsigned int mut_class, msize_t mst_csize)
 {
-    if (NULL == mbt_dptr)
+    static_assert(sizeof(x_mchunk_t) <= ECV_CHUNK_HSIZE, "sizeof(x_mchunk_t) > ECV_CHUNK_HSIZE");
+    static_assert(sizeof(x_mslab_t) <= ECV_SLAB_HSIZE, "sizeof(x_mslab_t) > ECV_SLAB_HSIZE");
+
+    x_mslab_t  * xslab_ptr  = NULL;
+    x_marena_t * xarena_ptr = NULL;
+    unsigned int mut_units  = 0;
+
+    // 巨型内存块独占一个 slab，其他尺寸级别的 slab 至少为 ECV_SLAB_SIZE 大小，且至少容纳 ECV_SLAB_MINCHUNKS 个内存块
+    msize_t mst_stride = ECV_CHUNK_HSIZE + mst_csize;
+    msize_t mst_ssize  = ECV_SLAB_HSIZE + mst_stride;
+    if (mut_class < ECV_CLASS_COUNT)
     {
-        return false;
+        mst_ssize = ECV_SLAB_HSIZE + mst_stride * ECV_SLAB_MINCHUNKS;
+        if (mst_ssize < ECV_SLAB_SIZE)
+            mst_ssize = ECV_SLAB_SIZE;
     }
 
-    // 确认是否为申请过的内存块
-    mapblock_t::iterator itfind = m_map_alloc.find(mbt_dptr);
-    if (itfind == m_map_alloc.end())
+    if ((0 != (m_mut_flags & EMP_ARENA)) && (mut_class < ECV_CLASS_COUNT))
     {
-        return false;
+        mut_units = (unsigned int)((mst_ssize + ECV_ARENA_UNIT - 1) / ECV_ARENA_UNIT);
+        xslab_ptr = (x_mslab_t *)arena_alloc(mut_node, mut_units, xarena_ptr);
+        if (NULL != xslab_ptr)
+            mst_ssize = (msize_t)mut_units * ECV_ARENA_UNIT;
+        else
+            mut_units = 0;
     }
 
-    // 若内存块未在回收集合表中，则可执行回收操作（防止重复回收相同的内存块）
-    if (m_mset_recyc.find(mbt_dptr) == m_mset_recyc.end())
+    if (NULL == xslab_ptr)
     {
-        m_mset_recyc.insert(mbt_dptr);
-        m_mmap_recyc.insert(
-            std::pair< msize_t, mmapblock_t::mapped_type >(
-                itfind->second,
-                mmapblock_t::mapped_type(mbt_dptr, (mtime_t)time(NULL))));
-        m_st_recyc_size += itfind->second;
+        xslab_ptr = (x_mslab_t *)malloc(mst_ssize);
+        if (NULL == xslab_ptr)
+        {
+            return NULL;
+        }
     }
 
-    return true;
+    xslab_ptr->xprev_ptr  = NULL;
+    xslab_ptr->xnext_ptr  = NULL;
+    xslab_ptr->xpool_ptr  = this;
+    xslab_ptr->xarena_ptr = xarena_ptr;
+    xslab_ptr->mbt_free  = NULL;
+    xslab_ptr->mbt_bump  = (mblock_t)xslab_ptr + ECV_SLAB_HSIZE;
+    xslab_ptr->mst_csize = mst_csize;
+    xslab_ptr->mut_class = mut_class;
+    xslab_ptr->mut_list  = EMS_PARTIAL;
+    xslab_ptr->mut_nused = 0;
+    xslab_ptr->mut_total = (unsigned int)((mst_ssize - ECV_SLAB_HSIZE) / mst_stride);
+    xslab_ptr->mut_units = mut_units;
+    xslab_ptr->mut_node  = mut_node;
+    xslab_ptr->mtt_empty = 0;
+
+    // 挂入 部分使用 链表的头部
+    x_mclass_t & xclass = m_xclass[mut_node][mut_class];
+    x_mslist_t & xlist  = xclass.xlst_slab[EMS_PARTIAL];
+    xslab_ptr->xnext_ptr = xlist.xhead_ptr;
+    if (NULL != xlist.xhead_ptr)
+        xlist.xhead_ptr->xprev_ptr = xslab_ptr;
+    else
+        xlist.xtail_ptr = xslab_ptr;
+    xlist.xhead_ptr = xslab_ptr;
+
+    m_st_alloc_size.fetch_add(xslab_ptr->mut_total * mst_csize, std::memory_order_relaxed);
+    m_st_recyc_size.fetch_add(xslab_ptr->mut_total * mst_csize, std::memory_order_relaxed);
+
+    xclass.mst_nslab += 1;
+    xclass.mst_nfree += xslab_ptr->mut_total;
+
+    return xslab_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 从所在的链表中移除，并释放 slab（调用方须持有尺寸级别的访问控制锁）。
+ */
+void x_mempool_t::destroy_slab(x_mslab_t * xslab_ptr)
+{
+    unlink_slab(xslab_ptr);
+    free_slab(xslab_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 将 slab 从所在的链表中移除，并扣除其统计值（调用方须持有尺寸级别的访问控制锁）。
+ *
+ * @return msize_t
+ *         - 返回 slab 所占用的内存大小（内存块容量）。
+ */
+msize_t x_mempool_t::unlink_slab(x_mslab_t * xslab_ptr)
+{
+    x_mclass_t & xclass = class_of(xslab_ptr);
+    x_mslist_t & xlist  = xclass.xlst_slab[xslab_ptr->mut_list];
+
+    if (NULL != xslab_ptr->xprev_ptr)
+        xslab_ptr->xprev_ptr->xnext_ptr = xslab_ptr->xnext_ptr;
+    else
+        xlist.xhead_ptr = xslab_ptr->xnext_ptr;
+    if (NULL != xslab_ptr->xnext_ptr)
+        xslab_ptr->xnext_ptr->xprev_ptr = xslab_ptr->xprev_ptr;
+    else
+        xlist.xtail_ptr = xslab_ptr->xprev_ptr;
+
+    xslab_ptr->xprev_ptr = NULL;
+    xslab_ptr->xnext_ptr = NULL;
+
+    msize_t mst_ssize = xslab_ptr->mut_total * xslab_ptr->mst_csize;
+
+    xclass.mst_nslab -= 1;
+    xclass.mst_nlive -= xslab_ptr->mut_nused;
+    xclass.mst_nfree -= (xslab_ptr->mut_total - xslab_ptr->mut_nused);
+
+    m_st_alloc_size.fetch_sub(mst_ssize, std::memory_order_relaxed);
+    m_st_recyc_size.fetch_sub((xslab_ptr->mut_total - xslab_ptr->mut_nused) * xslab_ptr->mst_csize,
+                              std::memory_order_relaxed);
+
+    return mst_ssize;
+}
+
+/**********************************************************/
+/**
+ * @brief 释放（已移除的）slab 的内存（无需持有尺寸级别的访问控制锁）。
+ */
+void x_mempool_t::free_slab(x_mslab_t * xslab_ptr)
+{
+    if (NULL != xslab_ptr->xarena_ptr)
+        arena_free(xslab_ptr->mut_node, xslab_ptr->xarena_ptr, (mblock_t)xslab_ptr, xslab_ptr->mut_units);
+    else
+        free(xslab_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 从（所属节点的）内存区域中分配连续的单位。
+ *
+ * @param [in ] mut_node   : 所属的节点。
+ * @param [in ] mut_units  : 单位数量（不超过 ECV_ARENA_UNITS）。
+ * @param [out] xarena_ptr : 操作成功返回所在的内存区域。
+ *
+ * @return mblock_t
+ *         - 成功，返回 分配的起始地址；
+ *         - 失败，返回 NULL（映射新的内存区域失败）。
+ */
+mblock_t x_mempool_t::arena_alloc(unsigned int mut_node, unsigned int mut_units, x_marena_t *& xarena_ptr)
+{
+    static_assert(ECV_ARENA_UNITS * ECV_ARENA_UNIT == ECV_ARENA_SIZE, "ECV_ARENA_UNITS * ECV_ARENA_UNIT != ECV_ARENA_SIZE");
+    static_assert(ECV_ARENA_UNITS == 8 * sizeof(unsigned long long), "ECV_ARENA_UNITS != bits of x_marena_t::ullt_bitmap");
+
+    assert((mut_units > 0) && (mut_units <= ECV_ARENA_UNITS));
+
+    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_arena);
+
+    unsigned long long ullt_mask = (mut_units >= ECV_ARENA_UNITS) ? ~0ULL : ((1ULL << mut_units) - 1);
+
+    //======================================
+    // 在已有的内存区域中，首次适配连续空闲的单位
+
+    x_marena_t *& xarena_list = m_xarena_list[mut_node];
+
+    for (xarena_ptr = xarena_list; NULL != xarena_ptr; xarena_ptr = xarena_ptr->xnext_ptr)
+    {
+        if ((ECV_ARENA_UNITS - xarena_ptr->mut_nused) < mut_units)
+            continue;
+
+        for (unsigned int mut_upos = 0; mut_upos + mut_units <= ECV_ARENA_UNITS; ++mut_upos)
+        {
+            if (0 == (xarena_ptr->ullt_bitmap & (ullt_mask << mut_upos)))
+            {
+                xarena_ptr->ullt_bitmap |= (ullt_mask << mut_upos);
+                xarena_ptr->mut_nused   += mut_units;
+                return (xarena_ptr->mbt_base + (msize_t)mut_upos * ECV_ARENA_UNIT);
+            }
+        }
+    }
+
+    //======================================
+    // 映射新的内存区域
+
+    xarena_ptr = (x_marena_t *)malloc(sizeof(x_marena_t));
+    if (NULL == xarena_ptr)
+    {
+        return NULL;
+    }
+
+    bool xbt_huge = false;
+    xarena_ptr->mbt_base = (mblock_t)mmap_arena(ECV_ARENA_SIZE, ECV_HUGEPAGE_SIZE, xbt_huge);
+    if (NULL == xarena_ptr->mbt_base)
+    {
+        free(xarena_ptr);
+        xarena_ptr = NULL;
+        return NULL;
+    }
+
+    // 物理页面尚未分配，此时绑定节点，首次访问时即从所属节点分配
+    if (m_mut_nnodes > 1)
+    {
+        mbind_node(xarena_ptr->mbt_base, ECV_ARENA_SIZE, mut_node);
+    }
+
+    xarena_ptr->ullt_bitmap = ullt_mask;
+    xarena_ptr->mut_nused   = mut_units;
+    xarena_ptr->mut_hugetlb = xbt_huge ? 1 : 0;
+
+    xarena_ptr->xprev_ptr = NULL;
+    xarena_ptr->xnext_ptr = xarena_list;
+    if (NULL != xarena_list)
+        xarena_list->xprev_ptr = xarena_ptr;
+    xarena_list = xarena_ptr;
+
+    return xarena_ptr->mbt_base;
+}
+
+/**********************************************************/
+/**
+ * @brief 归还内存区域中的单位，内存区域全部空闲时，解除映射（归还给系统）。
+ */
+void x_mempool_t::arena_free(unsigned int mut_node, x_marena_t * xarena_ptr, mblock_t mbt_dptr, unsigned int mut_units)
+{
+    x_memautolock_t xautolock((x_memlock_t *)(mhandle_t)m_xmt_arena);
+
+    unsigned int mut_upos = (unsigned int)((mbt_dptr - xarena_ptr->mbt_base) / ECV_ARENA_UNIT);
+    unsigned long long ullt_mask = (mut_units >= ECV_ARENA_UNITS) ? ~0ULL : ((1ULL << mut_units) - 1);
+
+    assert((xarena_ptr->ullt_bitmap & (ullt_mask << mut_upos)) == (ullt_mask << mut_upos));
+
+    xarena_ptr->ullt_bitmap &= ~(ullt_mask << mut_upos);
+    xarena_ptr->mut_nused   -= mut_units;
+    if (xarena_ptr->mut_nused > 0)
+    {
+        return;
+    }
+
+    if (NULL != xarena_ptr->xprev_ptr)
+        xarena_ptr->xprev_ptr->xnext_ptr = xarena_ptr->xnext_ptr;
+    else
+        m_xarena_list[mut_node] = xarena_ptr->xnext_ptr;
+    if (NULL != xarena_ptr->xnext_ptr)
+        xarena_ptr->xnext_ptr->xprev_ptr = xarena_ptr->xprev_ptr;
+
+    munmap(xarena_ptr->mbt_base, ECV_ARENA_SIZE);
+    free(xarena_ptr);
+}
+
+/**********************************************************/
+/**
+ * @brief 将 slab 从所在的链表，转移至指定链表的头部（调用方须持有尺寸级别的访问控制锁）。
+ */
+void x_mempool_t::move_slab(x_mslab_t * xslab_ptr, unsigned int mut_list)
+{
+    x_mclass_t & xclass = class_of(xslab_ptr);
+    x_mslist_t & xlsrc  = xclass.xlst_slab[xslab_ptr->mut_list];
+    x_mslist_t & xldst  = xclass.xlst_slab[mut_list];
+
+    if (NULL != xslab_ptr->xprev_ptr)
+        xslab_ptr->xprev_ptr->xnext_ptr = xslab_ptr->xnext_ptr;
+    else
+        xlsrc.xhead_ptr = xslab_ptr->xnext_ptr;
+    if (NULL != xslab_ptr->xnext_ptr)
+        xslab_ptr->xnext_ptr->xprev_ptr = xslab_ptr->xprev_ptr;
+    else
+        xlsrc.xtail_ptr = xslab_ptr->xprev_ptr;
+
+    xslab_ptr->xprev_ptr = NULL;
+    xslab_ptr->xnext_ptr = xldst.xhead_ptr;
+    if (NULL != xldst.xhead_ptr)
+        xldst.xhead_ptr->xprev_ptr = xslab_ptr;
+    else
+        xldst.xtail_ptr = xslab_ptr;
+    xldst.xhead_ptr = xslab_ptr;
+
+    xslab_ptr->mut_list = mut_list;
+}
+
+/**********************************************************/
+/**
+ * @brief 返回当前线程的本地缓存（未启用线程本地缓存时，返回 NULL）。
+ */
+x_mempool_t::x_mtcache_t * x_mempool_t::tcache(void)
+{
+    if (m_mut_tslot >= ECV_TCACHE_SLOTS)
+    {
+        return NULL;
+    }
+
+    static thread_local x_mtlocal_t xmt_local;
+
+    x_mtcache_t *& xtc_ptr = xmt_local.xtc_slot[m_mut_tslot];
+    if (NULL == xtc_ptr)
+    {
+        xtc_ptr = (x_mtcache_t *)calloc(1, sizeof(x_mtcache_t));
+        if (NULL == xtc_ptr)
+        {
+            return NULL;
+        }
+    }
+
+    // 槽位曾属于已销毁的内存池，或本内存池已执行过 release_pool()，丢弃失效的缓存内容
+    unsigned int mut_epoch = m_mut_epoch.load(std::memory_order_acquire);
+    if ((this != xtc_ptr->xpool_ptr) || (mut_epoch != xtc_ptr->mut_epoch))
+    {
+        memset(xtc_ptr, 0, sizeof(x_mtcache_t));
+        xtc_ptr->xpool_ptr = this;
+        xtc_ptr->mut_epoch = mut_epoch;
+    }
+
+    return xtc_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief 将线程本地缓存中所有内存块归还至 slab，并累加统计值。
+ */
+void x_mempool_t::flush_tcache(x_mtcache_t * xtc_ptr)
+{
+    for (unsigned int mut_iter = 0; mut_iter < ECV_TCACHE_CLASS; ++mut_iter)
+    {
+        x_mtbin_t & xbin = xtc_ptr->xbin[mut_iter];
+        if (xbin.mut_count > 0)
+        {
+            recyc_batch(mut_iter, xbin.mbt_block, xbin.mut_count);
+            xbin.mut_count = 0;
+        }
+
+        publish_tcbin(mut_iter, xbin);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 将线程本地缓存中（单个尺寸级别的）统计值累加至内存池。
+ */
+void x_mempool_t::publish_tcbin(unsigned int mut_class, x_mtbin_t & xbin)
+{
+    if (xbin.mut_nalloc > 0)
+    {
+        x_mclass_t & xclass = m_xclass[local_node()][mut_class];
+        xclass.ullt_nalloc.fetch_add(xbin.mut_nalloc, std::memory_order_relaxed);
+        xclass.ullt_rbytes.fetch_add(xbin.ullt_rbytes, std::memory_order_relaxed);
+        xclass.ullt_abytes.fetch_add(xbin.mut_nalloc * (unsigned long long)class_size(mut_class), std::memory_order_relaxed);
+    }
+
+    if (xbin.mut_nhits > 0)
+    {
+        m_ullt_tc_hits.fetch_add(xbin.mut_nhits, std::memory_order_relaxed);
+    }
+
+    xbin.mut_nhits   = 0;
+    xbin.mut_nalloc  = 0;
+    xbin.ullt_rbytes = 0;
 }
@@ -8,14 +8,47 @@
  * 文件标识：
  * 文件摘要：内存池管理，实现多类型的内存块（不同内存块大小的）内存池。
  *
- * 当前版本：1.0.0.0
+ * 当前版本：2.5.0.0
  * 作    者：
- * 完成日期：2015年04月24日
- * 版本摘要：
+ * 完成日期：2019年03月31日
+ * 版本摘要：增加 NUMA 模式（EMP_NUMA）：各个 NUMA 节点拥有独立的 slab 管理信息（及内存区域），
+ *          线程从所在节点的 slab 中申请内存块；其他节点的线程回收的内存块，以无锁栈暂存于所属节点，
+ *          由所属节点在下次批量申请（或 trim()）时惰性归还至 slab。
+ *
+ * 历史版本：2.4.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月30日
+ * 版本摘要：增加 snapshot() 接口，返回各个尺寸级别的统计信息（slab 数量、使用中/空闲/峰值 内存块数量、
+ *          累计申请次数、请求字节数 与 对齐后字节数，据此可计算 申请速率 与 对齐浪费的比例）。
  *
- * 历史版本：
+ * 历史版本：2.3.0.0
  * 原作者  ：
- * 完成日期：
+ * 完成日期：2019年03月29日
+ * 版本摘要：增加 trim() 接口：按 保留的空闲内存大小 的目标，在限定的时间预算内，
+ *          逐个释放空闲时间最久的 slab（加锁仅用于摘除 slab，内存在锁外释放），供后台定时调用。
+ *
+ * 历史版本：2.2.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月28日
+ * 版本摘要：增加 内存区域（arena）模式：slab 从大块的 mmap() 内存区域中切分，优先使用大页内存
+ *          （MAP_HUGETLB，失败则以 MADV_HUGEPAGE 建议透明大页），内存区域整体归还给系统。
+ *
+ * 历史版本：2.1.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月27日
+ * 版本摘要：增加线程本地缓存（thread cache）：每个线程按尺寸级别缓存空闲内存块，
+ *          缓存 空/满 时与中心的 slab 批量交换内存块，稳态下的 申请/回收 操作无需加锁。
+ *
+ * 历史版本：2.0.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月26日
+ * 版本摘要：改为 固定尺寸分级（size class）的 slab 分配器：每个内存块前置块头部（记录所属 slab），
+ *          slab 内以侵入式链表管理空闲内存块，申请/回收操作均为 O(1)，且不再分配任何容器节点；
+ *          各个尺寸级别使用独立的访问控制锁。
+ *
+ * 历史版本：1.0.0.0
+ * 原作者  ：
+ * 完成日期：2015年04月24日
  * 版本摘要：
  * </pre>
  */
@@ -23,8 +56,7 @@
 #ifndef __XMEMPOOL_H__
 #define __XMEMPOOL_H__
 
-#include <set>
-#include <map>
+#include <atomic>
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -50,6 +82,28 @@ typedef unsigned long long mtime_t;
 /**
  * @class x_mempool_t
  * @brief 内存管理类（内存池）。
+ *
+ * @note
+ * <pre>
+ *   1. 内存块尺寸分级：[1K, 4K] 按 1K 递增，(4K, 64K] 按 4K 递增，(64K, 1M] 按 2 的幂次递增，
+ *      超出 1M 的（巨型）内存块，则直接向系统申请，回收时直接释放；
+ *   2. 同一尺寸级别的内存块，从 slab（一次性申请的连续内存，按需切分）中分配，
+ *      每个内存块前置 ECV_CHUNK_HSIZE 字节的块头部，回收时据此 O(1) 定位所属 slab；
+ *   3. slab 按使用状态分别挂在 部分使用、全部使用、全部空闲 三个链表中，
+ *      全部空闲的 slab 由 release_timeout_memblock() 按超时时间释放；
+ *   4. 启用线程本地缓存的内存池（构造时指定），不超过 64K 的内存块优先在线程本地缓存中 申请/回收，
+ *      本地缓存为空时，从 slab 批量取出内存块，超出容量时，批量归还一半至 slab（各只加锁一次）；
+ *      线程本地缓存中的内存块，对 slab 而言仍处于使用中，alloc_size()/recyc_size() 不计入；
+ *   5. 启用线程本地缓存的内存池，其生命期应长于使用它的线程（线程退出时，本地缓存归还至内存池），
+ *      同时启用线程本地缓存的内存池，最多为 ECV_TCACHE_SLOTS 个（超出则不启用）；
+ *   6. 启用内存区域模式的内存池（构造时指定 EMP_ARENA），非巨型内存块的 slab 按 ECV_ARENA_UNIT 为单位，
+ *      从 ECV_ARENA_SIZE 大小的内存区域中分配，内存区域中的 slab 全部释放后，整个内存区域才归还给系统；
+ *      映射内存区域失败时，仍以 malloc() 申请 slab；
+ *   7. 启用 NUMA 模式的内存池（构造时指定 EMP_NUMA，且系统存在多个 NUMA 节点），按线程所在的节点选择 slab，
+ *      内存区域以 mbind() 优先绑定至所属节点，malloc() 申请的 slab 则依赖首次访问（first-touch）策略；
+ *      回收其他节点的内存块时，只压入所属节点的无锁栈（不加锁、不触及所属 slab），由所属节点惰性归还；
+ *      单节点的系统中，EMP_NUMA 不产生任何开销。
+ * </pre>
  */
 class x_mempool_t
 {
@@ -63,17 +117,156 @@ public:
     {
         ECV_ALLOC_SMALLER  = 1 * 1024,     ///< 较小的内存块分配粒度
         ECV_ALLOC_BIGGER   = 4 * 1024,     ///< 较大的内存块分配粒度
+        ECV_ALLOC_MIDDLE   = 64 * 1024,    ///< 按 ECV_ALLOC_BIGGER 粒度分级的内存块上限
+        ECV_ALLOC_LARGEST  = 1024 * 1024,  ///< 按 2 的幂次分级的内存块上限（超出则为巨型内存块）
+        ECV_CLASS_COUNT    = 23,           ///< 尺寸级别的数量（巨型内存块的级别索引值为 ECV_CLASS_COUNT）
+        ECV_SLAB_SIZE      = 256 * 1024,   ///< slab 的（最小）内存大小
+        ECV_SLAB_MINCHUNKS = 4,            ///< slab 容纳的（最少）内存块数量（巨型内存块除外）
+        ECV_SLAB_HSIZE     = 128,          ///< slab 头部的内存大小
+        ECV_CHUNK_HSIZE    = 16,           ///< 内存块头部的内存大小
+        ECV_MAGIC_USED     = 0x55534544,   ///< 内存块头部的状态标识：使用中
+        ECV_MAGIC_FREE     = 0x46524545,   ///< 内存块头部的状态标识：空闲
+        ECV_MAGIC_TCACHE   = 0x54434143,   ///< 内存块头部的状态标识：位于线程本地缓存中
+        ECV_MAGIC_REMOTE   = 0x52454D54,   ///< 内存块头部的状态标识：位于所属节点的远程回收栈中
+        ECV_TCACHE_CLASS   = 19,           ///< 使用线程本地缓存的尺寸级别数量（即 不超过 64K 的内存块）
+        ECV_TCACHE_SLOTS   = 8,            ///< 同时启用线程本地缓存的内存池数量上限
+        ECV_TCACHE_BATCH   = 32,           ///< 与 slab 批量交换的内存块数量上限（本地缓存容量为其 2 倍）
+        ECV_TCACHE_BYTES   = 64 * 1024,    ///< 与 slab 批量交换的内存大小（据此计算各尺寸级别的批量数）
+        ECV_TCACHE_PUBLISH = 1024,         ///< 线程本地的命中次数达到该值时，累加至内存池的统计值
+        ECV_ARENA_SIZE     = 16 * 1024 * 1024, ///< 内存区域的大小
+        ECV_ARENA_UNIT     = 256 * 1024,   ///< 内存区域中分配 slab 的单位
+        ECV_ARENA_UNITS    = 64,           ///< 内存区域中的单位数量（与分配位图的位数一致）
+        ECV_HUGEPAGE_SIZE  = 2 * 1024 * 1024, ///< 大页内存的大小（内存区域按此对齐）
+        ECV_NUMA_NODES     = 8,            ///< 支持的 NUMA 节点数量上限（超出的节点按取模合并）
+        ECV_NUMA_RECHECK   = 1024,         ///< 线程每执行该次数的 申请/回收 操作，重新获取所在的节点
     } emConstValue;
 
+    /**
+     * @enum  emPoolFlags
+     * @brief 内存池的构造标识。
+     */
+    typedef enum emPoolFlags
+    {
+        EMP_TCACHE = 0x0001,   ///< 启用线程本地缓存
+        EMP_ARENA  = 0x0002,   ///< 启用内存区域（大页内存）模式
+        EMP_NUMA   = 0x0004,   ///< 启用 NUMA 模式（各节点独立的 slab）
+    } emPoolFlags;
+
+    /**
+     * @struct x_mpstat_t
+     * @brief  尺寸级别的统计信息（参看 snapshot() 接口）。
+     */
+    typedef struct x_mpstat_t
+    {
+        msize_t            mst_csize;    ///< 内存块大小（巨型内存块为 0）
+        msize_t            mst_nslab;    ///< slab 数量
+        msize_t            mst_nlive;    ///< 使用中的内存块数量（含线程本地缓存中的）
+        msize_t            mst_nfree;    ///< slab 中空闲的内存块数量（含尚未切分的）
+        msize_t            mst_npeak;    ///< 使用中的内存块数量的峰值
+        unsigned long long ullt_nalloc;  ///< 累计申请次数
+        unsigned long long ullt_rbytes;  ///< 累计请求的字节数
+        unsigned long long ullt_abytes;  ///< 累计分配的（对齐后的）字节数（与 ullt_rbytes 之差，即为对齐浪费的字节数）
+        unsigned long long ullt_remote;  ///< 累计由其他节点回收（经远程回收栈归还）的内存块数量
+    } x_mpstat_t;
+
 protected:
-    /** [ 内存块缓存，内存块大小 ] */
-    typedef std::map< mblock_t, msize_t >   mapblock_t;
+    /**
+     * @enum  emSlabList
+     * @brief slab 所在的链表。
+     */
+    typedef enum emSlabList
+    {
+        EMS_PARTIAL = 0,   ///< 部分使用的 slab 链表
+        EMS_FULL    = 1,   ///< 全部使用的 slab 链表
+        EMS_EMPTY   = 2,   ///< 全部空闲的 slab 链表
+        EMS_COUNT   = 3,   ///< 链表数量
+    } emSlabList;
+
+    struct x_mslab_t;
+
+    /**
+     * @struct x_marena_t
+     * @brief  内存区域的描述信息（独立于内存区域申请）。
+     */
+    typedef struct x_marena_t
+    {
+        x_marena_t * xprev_ptr;    ///< 链表中的前一内存区域
+        x_marena_t * xnext_ptr;    ///< 链表中的后一内存区域
+        mblock_t     mbt_base;     ///< 内存区域的起始地址
+        unsigned long long ullt_bitmap;  ///< 单位分配位图（置位的为已分配的单位）
+        unsigned int mut_nused;    ///< 已分配的单位数量
+        unsigned int mut_hugetlb;  ///< 是否以 MAP_HUGETLB 映射
+    } x_marena_t;
 
-    /** [ 内存块大小，[内存块缓存，内存块回收的时间点] ] */
-    typedef std::multimap< msize_t, std::pair< mblock_t, mtime_t > >   mmapblock_t;
+    /**
+     * @struct x_mchunk_t
+     * @brief  内存块头部（其后紧随返回给调用方的内存块）。
+     */
+    typedef struct x_mchunk_t
+    {
+        x_mslab_t  * xslab_ptr;  ///< 所属的 slab
+        unsigned int mut_class;  ///< 尺寸级别
+        unsigned int mut_magic;  ///< 状态标识（ECV_MAGIC_USED/ECV_MAGIC_FREE 等）
+    } x_mchunk_t;
+
+    /**
+     * @struct x_mslab_t
+     * @brief  slab 头部（位于 slab 内存的起始处，其后为切分的各个内存块）。
+     * @note   空闲内存块的链接指针存放在内存块自身（块头部之后）的起始处。
+     */
+    typedef struct x_mslab_t
+    {
+        x_mslab_t  * xprev_ptr;  ///< 链表中的前一 slab
+        x_mslab_t  * xnext_ptr;  ///< 链表中的后一 slab
+        x_mempool_t* xpool_ptr;  ///< 所属的内存池
+        x_marena_t * xarena_ptr; ///< 所在的内存区域（以 malloc() 申请时为 NULL）
+        mblock_t     mbt_free;   ///< 空闲内存块链表（指向块头部）
+        mblock_t     mbt_bump;   ///< 尚未切分区域的起始位置
+        msize_t      mst_csize;  ///< 内存块的大小（不含块头部）
+        unsigned int mut_class;  ///< 尺寸级别
+        unsigned int mut_list;   ///< 所在的链表（参看 emSlabList 枚举值）
+        unsigned int mut_nused;  ///< 使用中的内存块数量
+        unsigned int mut_total;  ///< 内存块总数
+        unsigned int mut_units;  ///< 占用内存区域的单位数量
+        unsigned int mut_node;   ///< 所属的 NUMA 节点
+        mtime_t      mtt_empty;  ///< 变为全部空闲状态的时间点
+    } x_mslab_t;
+
+    /**
+     * @struct x_mslist_t
+     * @brief  slab 双向链表。
+     */
+    typedef struct x_mslist_t
+    {
+        x_mslab_t  * xhead_ptr;  ///< 链表头部（最近加入的 slab）
+        x_mslab_t  * xtail_ptr;  ///< 链表尾部（最早加入的 slab）
+    } x_mslist_t;
+
+    /**
+     * @struct x_mtbin_t
+     * @brief  线程本地缓存中，单个尺寸级别的空闲内存块栈。
+     */
+    typedef struct x_mtbin_t
+    {
+        unsigned int mut_count;                         ///< 缓存的内存块数量
+        unsigned int mut_nhits;                         ///< 尚未累加至内存池的命中次数
+        unsigned int mut_nalloc;                        ///< 尚未累加至内存池的申请次数
+        unsigned long long ullt_rbytes;                 ///< 尚未累加至内存池的请求字节数
+        mblock_t     mbt_block[2 * ECV_TCACHE_BATCH];   ///< 缓存的内存块（栈顶为最近回收的）
+    } x_mtbin_t;
+
+    /**
+     * @struct x_mtcache_t
+     * @brief  线程本地缓存（每个线程、每个启用线程本地缓存的内存池 各一个）。
+     */
+    typedef struct x_mtcache_t
+    {
+        x_mempool_t        * xpool_ptr;                 ///< 所属的内存池
+        unsigned int         mut_epoch;                 ///< 所属内存池的时代值（不一致时，缓存内容已失效）
+        x_mtbin_t            xbin[ECV_TCACHE_CLASS];    ///< 各个尺寸级别的空闲内存块栈
+    } x_mtcache_t;
 
-    /** [ 内存块缓存 ] */
-    typedef std::set< mblock_t > msetblock_t;
+    struct x_mtlocal_t;
 
     /**
      * @class x_memlocker_t
@@ -96,21 +289,80 @@ protected:
         mhandle_t  m_handle_lock;   ///< 锁操作句柄
     };
 
+    /**
+     * @struct x_mclass_t
+     * @brief  尺寸级别的 slab 管理信息。
+     */
+    typedef struct x_mclass_t
+    {
+        x_memlocker_t  xmt_locker;              ///< 访问控制锁
+        x_mslist_t     xlst_slab[EMS_COUNT];    ///< 各个状态的 slab 链表
+        msize_t        mst_nslab;               ///< slab 数量
+        msize_t        mst_nlive;               ///< 使用中的内存块数量
+        msize_t        mst_nfree;               ///< 空闲的内存块数量
+        msize_t        mst_npeak;               ///< 使用中的内存块数量的峰值
+        std::atomic< unsigned long long > ullt_nalloc;  ///< 累计申请次数
+        std::atomic< unsigned long long > ullt_rbytes;  ///< 累计请求的字节数
+        std::atomic< unsigned long long > ullt_abytes;  ///< 累计分配的（对齐后的）字节数
+        std::atomic< unsigned long long > ullt_remote;  ///< 累计经远程回收栈归还的内存块数量
+        std::atomic< mblock_t >           mbt_remote;   ///< 远程回收栈（其他节点的线程回收的内存块，指向块头部）
+    } x_mclass_t;
+
     // constructor/destructor
 public:
-    x_mempool_t(void);
+    /**********************************************************/
+    /**
+     * @brief 构造函数。
+     *
+     * @param [in ] mut_flags : 构造标识（参看 emPoolFlags 枚举值的组合）。
+     */
+    explicit x_mempool_t(unsigned int mut_flags = 0);
     ~x_mempool_t(void);
 
     // commom invoking
 public:
     /**********************************************************/
     /**
-     * @brief 按给定的（内存块）长度值，计算对齐后的数值。
+     * @brief 按给定的（内存块）长度值，计算所属的尺寸级别（巨型内存块返回 ECV_CLASS_COUNT）。
+     */
+    static inline unsigned int size_class(msize_t mst_size)
+    {
+        if (mst_size <= ECV_ALLOC_BIGGER)
+            return (mst_size <= ECV_ALLOC_SMALLER) ? 0 : (unsigned int)((mst_size - 1) / ECV_ALLOC_SMALLER);
+        if (mst_size <= ECV_ALLOC_MIDDLE)
+            return (unsigned int)((mst_size - 1) / ECV_ALLOC_BIGGER) + 3;
+        if (mst_size > ECV_ALLOC_LARGEST)
+            return ECV_CLASS_COUNT;
+
+        unsigned int mut_class = 19;
+        for (msize_t mst_csize = 2 * ECV_ALLOC_MIDDLE; mst_csize < mst_size; mst_csize <<= 1)
+            ++mut_class;
+        return mut_class;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回尺寸级别对应的内存块大小。
+     */
+    static inline msize_t class_size(unsigned int mut_class)
+    {
+        if (mut_class < 4)
+            return (msize_t)(mut_class + 1) * ECV_ALLOC_SMALLER;
+        if (mut_class < 19)
+            return (msize_t)(mut_class - 2) * ECV_ALLOC_BIGGER;
+        return ((msize_t)2 * ECV_ALLOC_MIDDLE) << (mut_class - 19);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 按给定的（内存块）长度值，计算对齐后的数值（即所属尺寸级别的内存块大小）。
      */
     static inline msize_t align_size(msize_t mst_size)
     {
-        msize_t mst_xpart = (mst_size > ECV_ALLOC_BIGGER) ? ECV_ALLOC_BIGGER : ECV_ALLOC_SMALLER;
-        return (mst_size + mst_xpart - 1) / mst_xpart * mst_xpart;
+        unsigned int mut_class = size_class(mst_size);
+        if (mut_class < ECV_CLASS_COUNT)
+            return class_size(mut_class);
+        return (mst_size + ECV_ALLOC_BIGGER - 1) / ECV_ALLOC_BIGGER * ECV_ALLOC_BIGGER;
     }
 
     // public interfaces
@@ -169,13 +421,51 @@ public:
     /**
      * @brief 返回当前池总共分配的内存大小。
      */
-    inline msize_t alloc_size(void) const { return m_st_alloc_size; }
+    inline msize_t alloc_size(void) const { return m_st_alloc_size.load(std::memory_order_relaxed); }
 
     /**********************************************************/
     /**
      * @brief 返回当前池回收到已分配的内存大小。
      */
-    inline msize_t recyc_size(void) const { return m_st_recyc_size; }
+    inline msize_t recyc_size(void) const { return m_st_recyc_size.load(std::memory_order_relaxed); }
+
+    /**********************************************************/
+    /**
+     * @brief 线程本地缓存的命中次数（各线程的命中次数批量累加，存在一定的滞后）。
+     */
+    inline unsigned long long tcache_hits(void) const { return m_ullt_tc_hits.load(std::memory_order_relaxed); }
+
+    /**********************************************************/
+    /**
+     * @brief 线程本地缓存的未命中次数（即 从 slab 批量取出内存块的次数）。
+     */
+    inline unsigned long long tcache_misses(void) const { return m_ullt_tc_miss.load(std::memory_order_relaxed); }
+
+    /**********************************************************/
+    /**
+     * @brief 内存池使用的 NUMA 节点数量（未启用 NUMA 模式，或系统只有单个节点时，为 1）。
+     */
+    inline unsigned int numa_nodes(void) const { return m_mut_nnodes; }
+
+    /**********************************************************/
+    /**
+     * @brief 将当前线程的本地缓存中所有内存块归还至 slab。
+     */
+    void flush_tcache(void);
+
+    /**********************************************************/
+    /**
+     * @brief 读取各个尺寸级别的统计信息快照（末项为巨型内存块）。
+     * @note  各尺寸级别逐个加锁读取，并非同一时刻的快照；线程本地缓存中的 申请次数/请求字节数 批量累加，存在一定的滞后；
+     *        NUMA 模式下，各项为所有节点之和（mst_npeak 为各节点峰值之和）。
+     *
+     * @param [out] xstat_ptr : 操作返回的统计信息数组。
+     * @param [in ] mut_count : 统计信息数组的容量（至多返回 ECV_CLASS_COUNT + 1 项）。
+     *
+     * @return unsigned int
+     *         - 返回 写入 xstat_ptr 的项数。
+     */
+    unsigned int snapshot(x_mpstat_t * xstat_ptr, unsigned int mut_count) const;
 
     /**********************************************************/
     /**
@@ -183,9 +473,29 @@ public:
      *
      * @param [in ] mtt_timeout : 超时时间（单位按 秒 计）；
      *                            若设置为 0，则可以释放掉所有处于回收状态的内存块。
+     * @note  以 slab 为单位释放：仅 全部空闲 且超时的 slab 被释放。
      */
     void release_timeout_memblock(mtime_t mtt_timeout);
 
+    /**********************************************************/
+    /**
+     * @brief 增量式释放空闲的 slab（适合后台定时调用，不会长时间阻塞 申请/回收 操作）。
+     * @note
+     * <pre>
+     *   1. 轮流从（各个节点的）各个尺寸级别中，先归还远程回收栈中的内存块，再摘除空闲时间最久的 slab
+     *      （每次加锁只摘除一个），在锁外释放其内存；
+     *   2. recyc_size() 不超过 mst_retain，或 没有满足空闲时间的 slab，或 耗时超出预算 时，结束操作。
+     * </pre>
+     *
+     * @param [in ] mst_retain    : 保留的空闲内存大小（目标值）。
+     * @param [in ] mtt_idle      : slab 的最短空闲时间（单位按 秒 计）。
+     * @param [in ] mut_budget_us : 本次操作的时间预算（单位按 微秒 计）。
+     *
+     * @return msize_t
+     *         - 返回 释放的内存大小。
+     */
+    msize_t trim(msize_t mst_retain, mtime_t mtt_idle, unsigned int mut_budget_us);
+
     /**********************************************************/
     /**
      * @brief 释放池空间（释放掉所有申请的内存块）。
@@ -196,36 +506,205 @@ public:
 protected:
     /**********************************************************/
     /**
-     * @brief 按指定的大小从回收的内存块中取出内存块。
+     * @brief 校验内存块地址，返回其块头部。
      *
-     * @param [in ] mst_size : 指定的内存块大小。
+     * @param [in ] mbt_dptr : 内存块地址。
+     *
+     * @return x_mchunk_t *
+     *         - 成功，返回 块头部；
+     *         - 失败，返回 NULL，表示内存块并非本对象所管理，或已处于回收状态。
+     */
+    x_mchunk_t * chunk_of(mblock_t mbt_dptr) const;
+
+    /**********************************************************/
+    /**
+     * @brief 返回当前线程所在的节点（在内存池使用的节点范围内；未启用 NUMA 模式时，总是为 0）。
+     */
+    unsigned int local_node(void) const;
+
+    /**********************************************************/
+    /**
+     * @brief 将（已校验过的）其他节点的内存块压入所属节点的远程回收栈（无锁操作）。
+     */
+    void remote_push(x_mchunk_t * xchunk_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 将远程回收栈中的内存块归还至 slab（调用方须持有尺寸级别的访问控制锁）。
+     */
+    void remote_drain(x_mclass_t & xclass);
+
+    /**********************************************************/
+    /**
+     * @brief 从指定尺寸级别的 slab 中申请内存块。
+     *
+     * @param [in ] mut_node  : 所在的节点。
+     * @param [in ] mut_class : 尺寸级别。
+     * @param [in ] mst_size  : 申请的内存块长度（仅对巨型内存块有效）。
      *
      * @return mblock_t
-     *         - 成功，返回 内存块 地址；
+     *         - 成功，返回 内存块地址；
      *         - 失败，返回 NULL。
      */
-    mblock_t pop_recyc_block(msize_t mst_size);
+    mblock_t alloc_chunk(unsigned int mut_node, unsigned int mut_class, msize_t mst_size);
 
     /**********************************************************/
     /**
-     * @brief 将内存块压入回收的内存块管理队列中。
+     * @brief 从指定尺寸级别的 slab 中批量申请内存块（只加锁一次）。
      *
-     * @param [in ] memblock : 回收的内存块。
+     * @param [in ] mut_node  : 所在的节点。
+     * @param [in ] mut_class : 尺寸级别（不可为巨型内存块）。
+     * @param [out] mbt_block : 操作成功返回的内存块。
+     * @param [in ] mut_count : 申请的内存块数量。
      *
-     * @return bool
-     *         - 成功，返回 true；
-     *         - 失败，返回 false，表示所要回收的内存块并非池管理的内存块。
+     * @return unsigned int
+     *         - 返回 成功申请的内存块数量。
+     */
+    unsigned int alloc_batch(unsigned int mut_node, unsigned int mut_class, mblock_t * mbt_block, unsigned int mut_count);
+
+    /**********************************************************/
+    /**
+     * @brief 将（已校验过的）同一尺寸级别的内存块批量回收至 slab（同一节点的连续内存块只加锁一次）。
      */
-    bool push_recyc_block(mblock_t memblock);
+    void recyc_batch(unsigned int mut_class, mblock_t * mbt_block, unsigned int mut_count);
+
+    /**********************************************************/
+    /**
+     * @brief 确定可用于申请内存块的 slab：部分使用的 > 最近变为空闲的 > 新建的（调用方须持有尺寸级别的访问控制锁）。
+     */
+    x_mslab_t * pick_slab(unsigned int mut_node, unsigned int mut_class);
+
+    /**********************************************************/
+    /**
+     * @brief 从 slab 中取出一个内存块（调用方须持有尺寸级别的访问控制锁）。
+     */
+    mblock_t carve_chunk(x_mslab_t * xslab_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 将内存块归还至所属的 slab（调用方须持有尺寸级别的访问控制锁）。
+     */
+    void recyc_chunk(x_mchunk_t * xchunk_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 返回当前线程的本地缓存（未启用线程本地缓存时，返回 NULL）。
+     */
+    x_mtcache_t * tcache(void);
+
+    /**********************************************************/
+    /**
+     * @brief 将线程本地缓存中所有内存块归还至 slab，并累加统计值。
+     */
+    void flush_tcache(x_mtcache_t * xtc_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 将线程本地缓存中（单个尺寸级别的）统计值累加至内存池。
+     */
+    void publish_tcbin(unsigned int mut_class, x_mtbin_t & xbin);
+
+    /**********************************************************/
+    /**
+     * @brief 尺寸级别与 slab 批量交换的内存块数量。
+     */
+    static inline unsigned int tcache_batch(unsigned int mut_class)
+    {
+        msize_t mst_count = ECV_TCACHE_BYTES / class_size(mut_class);
+        if (mst_count < 2)
+            return 2;
+        if (mst_count > ECV_TCACHE_BATCH)
+            return ECV_TCACHE_BATCH;
+        return (unsigned int)mst_count;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 创建 slab（调用方须持有尺寸级别的访问控制锁）。
+     *
+     * @param [in ] mut_node  : 所属的节点。
+     * @param [in ] mut_class : 尺寸级别。
+     * @param [in ] mst_csize : 内存块的大小。
+     *
+     * @return x_mslab_t *
+     *         - 成功，返回 slab 对象；
+     *         - 失败，返回 NULL。
+     */
+    x_mslab_t * create_slab(unsigned int mut_node, unsigned int mut_class, msize_t mst_csize);
+
+    /**********************************************************/
+    /**
+     * @brief 从所在的链表中移除，并释放 slab（调用方须持有尺寸级别的访问控制锁）。
+     */
+    void destroy_slab(x_mslab_t * xslab_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 将 slab 从所在的链表中移除，并扣除其统计值（调用方须持有尺寸级别的访问控制锁）。
+     *
+     * @return msize_t
+     *         - 返回 slab 所占用的内存大小（内存块容量）。
+     */
+    msize_t unlink_slab(x_mslab_t * xslab_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 释放（已移除的）slab 的内存（无需持有尺寸级别的访问控制锁）。
+     */
+    void free_slab(x_mslab_t * xslab_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 从（所属节点的）内存区域中分配连续的单位。
+     *
+     * @param [in ] mut_node   : 所属的节点。
+     * @param [in ] mut_units  : 单位数量（不超过 ECV_ARENA_UNITS）。
+     * @param [out] xarena_ptr : 操作成功返回所在的内存区域。
+     *
+     * @return mblock_t
+     *         - 成功，返回 分配的起始地址；
+     *         - 失败，返回 NULL（映射新的内存区域失败）。
+     */
+    mblock_t arena_alloc(unsigned int mut_node, unsigned int mut_units, x_marena_t *& xarena_ptr);
+
+    /**********************************************************/
+    /**
+     * @brief 归还内存区域中的单位，内存区域全部空闲时，解除映射（归还给系统）。
+     */
+    void arena_free(unsigned int mut_node, x_marena_t * xarena_ptr, mblock_t mbt_dptr, unsigned int mut_units);
+
+    /**********************************************************/
+    /**
+     * @brief 将 slab 从所在的链表，转移至指定链表的头部（调用方须持有尺寸级别的访问控制锁）。
+     */
+    void move_slab(x_mslab_t * xslab_ptr, unsigned int mut_list);
+
+    /**********************************************************/
+    /**
+     * @brief 返回 slab 所属的尺寸级别管理信息。
+     */
+    inline x_mclass_t & class_of(x_mslab_t * xslab_ptr) const
+    {
+        return m_xclass[xslab_ptr->mut_node][xslab_ptr->mut_class];
+    }
 
     // class data
 protected:
-    mutable x_memlocker_t  m_xmt_locker;    ///< 访问控制锁
-    mapblock_t             m_map_alloc;     ///< 创建的内存块映射表
-    msetblock_t            m_mset_recyc;    ///< 回收的内存块集合表（用于防止重复回收相同的内存块）
-    mmapblock_t            m_mmap_recyc;    ///< 回收的内存块映射表（明确内存块的大小和回收时间点信息）
-    msize_t                m_st_alloc_size; ///< 总共申请的内存大小
-    msize_t                m_st_recyc_size; ///< 未使用的（处于回收状态）内存大小
+    mutable x_mclass_t    m_xclass[ECV_NUMA_NODES][ECV_CLASS_COUNT + 1];  ///< 各个节点、各个尺寸级别的 slab 管理信息（末尾为巨型内存块）
+    std::atomic< msize_t > m_st_alloc_size;               ///< 总共申请的内存大小
+    std::atomic< msize_t > m_st_recyc_size;               ///< 未使用的（处于回收状态）内存大小
+    unsigned int           m_mut_flags;                   ///< 构造标识
+    unsigned int           m_mut_nnodes;                  ///< 使用的 NUMA 节点数量
+    unsigned int           m_mut_tslot;                   ///< 线程本地缓存的槽位（未启用时为 ECV_TCACHE_SLOTS）
+    std::atomic< unsigned int >        m_mut_epoch;       ///< 时代值（release_pool() 后更新，令线程本地缓存失效）
+    std::atomic< unsigned long long >  m_ullt_tc_hits;    ///< 线程本地缓存的命中次数
+    std::atomic< unsigned long long >  m_ullt_tc_miss;    ///< 线程本地缓存的未命中次数
+    std::atomic< unsigned int >        m_mut_trim_next;   ///< trim() 下次开始的尺寸级别
+    mutable x_memlocker_t  m_xmt_arena;                   ///< 内存区域链表的访问控制锁（持有尺寸级别的锁时才加锁）
+    x_marena_t           * m_xarena_list[ECV_NUMA_NODES]; ///< 各个节点的内存区域链表
+
+    static std::atomic< x_mempool_t * >  _S_xpool_slot[ECV_TCACHE_SLOTS];  ///< 各个槽位上启用线程本地缓存的内存池
+    static std::atomic< unsigned int >   _S_mut_epoch;                      ///< 时代值的分配计数
 };
 
 ////////////////////////////////////////////////////////////////////////////////
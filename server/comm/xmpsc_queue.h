@@ -0,0 +1,321 @@
+/**
+ * @file    xmpsc_queue.h
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xmpsc_queue.h
+ * 创建日期：2019年03月24日
+ * 文件标识：
+ * 文件摘要：实现无锁的 多生产者/单消费者（multiple producer/single consumer） FIFO 队列。
+ * 
+ * 特别声明：x_mpsc_queue_t 的设计，主要参考了 Dmitry Vyukov 的 non-intrusive MPSC node-based queue 。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2019年03月24日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#ifndef __XMPSC_QUEUE_H__
+#define __XMPSC_QUEUE_H__
+
+#include <memory>
+#include <atomic>
+#include <new>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ENABLE_XASSERT
+#if ((defined _DEBUG) || (defined DEBUG))
+#define ENABLE_XASSERT 1
+#else // !((defined _DEBUG) || (defined DEBUG))
+#define ENABLE_XASSERT 0
+#endif // ((defined _DEBUG) || (defined DEBUG))
+#endif // ENABLE_XASSERT
+
+#ifndef XASSERT
+#if ENABLE_XASSERT
+#include <cassert>
+#define XASSERT(xptr)    assert(xptr)
+#else // !ENABLE_XASSERT
+#define XASSERT(xptr)
+#endif // ENABLE_XASSERT
+#endif // XASSERT
+
+////////////////////////////////////////////////////////////////////////////////
+// x_mpsc_queue_t
+
+/**
+ * @class x_mpsc_queue_t
+ * @brief 实现无锁的 多生产者/单消费者（multiple producer/single consumer） FIFO 队列。
+ * 
+ * @note
+ * <pre>
+ *   1. push() 可由任意线程并发调用（一次原子交换操作，无自旋等待）；
+ *      front()、pop()、try_pop()、drain()、clear() 只能由唯一的消费者线程调用；
+ *   2. 生产者在元素链接入队列前，即已累加元素数量，故 size()/empty() 的判断偏于保守：
+ *      empty() 返回 false 时，消费者仍可能暂时取不到元素（生产者尚未完成链接），
+ *      消费者应以 try_pop()/drain() 的返回值为准；
+ *   3. 每个元素独占一个节点，节点内存由 _Alloc 分配。
+ * </pre>
+ * 
+ * @param [in ] _Ty    : 队列存储的元素类型。
+ * @param [in ] _Alloc : 元素分配器。
+ */
+template< typename _Ty, typename _Alloc = std::allocator< _Ty > >
+class x_mpsc_queue_t : protected _Alloc
+{
+    // common data types
+public:
+    using x_element_t = _Ty;
+
+private:
+    /**
+     * @struct x_node_t
+     * @brief  存储元素的链表节点。
+     */
+    typedef struct x_node_t
+    {
+        std::atomic< x_node_t * > xnext_ptr;  ///< 指向后一节点
+        x_element_t               xet_value;  ///< 元素值（队列头部的哑节点中，该值已被析构）
+    } x_node_t;
+
+    using x_node_ptr_t    = x_node_t *;
+    using x_atomic_ptr_t  = std::atomic< x_node_ptr_t >;
+    using x_atomic_size_t = std::atomic< size_t >;
+    using x_allocator_t   = _Alloc;
+    using x_node_alloc_t  = typename std::allocator_traits< x_allocator_t >::template rebind_alloc< x_node_t >;
+
+    // constructor/destructor
+public:
+    explicit x_mpsc_queue_t(void)
+        : m_xnode_head(nullptr)
+        , m_xst_queue_size(0)
+        , m_xnode_tail(nullptr)
+    {
+        m_xnode_head = alloc_node();
+        m_xnode_tail.store(m_xnode_head, std::memory_order_relaxed);
+    }
+
+    ~x_mpsc_queue_t(void)
+    {
+        clear();
+        free_node(m_xnode_head);
+    }
+
+    x_mpsc_queue_t(x_mpsc_queue_t && xobject) = delete;
+    x_mpsc_queue_t(const x_mpsc_queue_t & xobject) = delete;
+    x_mpsc_queue_t & operator=(const x_mpsc_queue_t & xobject) = delete;
+
+    // public interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 当前队列中的元素数量（含生产者正在链接的元素）。
+     */
+    inline size_t size(void) const
+    {
+        return m_xst_queue_size.load(std::memory_order_acquire);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断队列是否为空。
+     */
+    inline bool empty(void) const
+    {
+        return (0 == size());
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 向队列尾端压入一个元素（任意线程）。
+     */
+    void push(const x_element_t & xemt_value)
+    {
+        x_node_ptr_t xnode_ptr = alloc_node();
+        x_allocator_t::construct(&xnode_ptr->xet_value, xemt_value);
+        link_node(xnode_ptr);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 向队列尾端压入一个元素（任意线程）。
+     */
+    void push(x_element_t && xemt_value)
+    {
+        x_node_ptr_t xnode_ptr = alloc_node();
+        x_allocator_t::construct(&xnode_ptr->xet_value, std::forward< x_element_t >(xemt_value));
+        link_node(xnode_ptr);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回队列首个元素（仅限消费者线程；无可取的元素时，返回 nullptr）。
+     */
+    inline x_element_t * front(void)
+    {
+        x_node_ptr_t xnode_next = m_xnode_head->xnext_ptr.load(std::memory_order_acquire);
+        return (nullptr != xnode_next) ? &xnode_next->xet_value : nullptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从队列前端弹出一个元素（仅限消费者线程）。
+     * 
+     * @return bool
+     *         - 成功，返回 true；
+     *         - 失败，返回 false（无可取的元素）。
+     */
+    bool pop(void)
+    {
+        x_node_ptr_t xnode_next = m_xnode_head->xnext_ptr.load(std::memory_order_acquire);
+        if (nullptr == xnode_next)
+            return false;
+
+        x_allocator_t::destroy(&xnode_next->xet_value);
+        move_head(xnode_next);
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从队列前端取出一个元素（仅限消费者线程）。
+     * 
+     * @param [out] xemt_value : 操作成功返回的元素值。
+     * 
+     * @return bool
+     *         - 成功，返回 true；
+     *         - 失败，返回 false（无可取的元素）。
+     */
+    bool try_pop(x_element_t & xemt_value)
+    {
+        x_node_ptr_t xnode_next = m_xnode_head->xnext_ptr.load(std::memory_order_acquire);
+        if (nullptr == xnode_next)
+            return false;
+
+        xemt_value = std::move(xnode_next->xet_value);
+        x_allocator_t::destroy(&xnode_next->xet_value);
+        move_head(xnode_next);
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 批量取出队列前端的元素（仅限消费者线程）。
+     * @note  依序以各个元素调用 xfunc_accept(x_element_t &)，其返回 true 时，元素被取出（可 std::move() 转移），
+     *        返回 false 时，元素仍留在队列中，并终止操作；元素数量在操作结束时一次性更新。
+     * 
+     * @param [in ] xfunc_accept : 元素的接收操作。
+     * 
+     * @return size_t
+     *         - 返回取出的元素数量。
+     */
+    template< typename _Func >
+    size_t drain(_Func && xfunc_accept)
+    {
+        size_t       xst_count  = 0;
+        x_node_ptr_t xnode_head = m_xnode_head;
+        x_node_ptr_t xnode_next = nullptr;
+
+        while (nullptr != (xnode_next = xnode_head->xnext_ptr.load(std::memory_order_acquire)))
+        {
+            if (!xfunc_accept(xnode_next->xet_value))
+                break;
+
+            x_allocator_t::destroy(&xnode_next->xet_value);
+            free_node(xnode_head);
+            xnode_head = xnode_next;
+            xst_count += 1;
+        }
+
+        if (xst_count > 0)
+        {
+            m_xnode_head = xnode_head;
+            m_xst_queue_size.fetch_sub(xst_count, std::memory_order_release);
+        }
+
+        return xst_count;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 清除队列中（已完成链接）的所有元素（仅限消费者线程）。
+     */
+    void clear(void)
+    {
+        drain([](x_element_t &) -> bool { return true; });
+    }
+
+    // internal invoking
+private:
+    /**********************************************************/
+    /**
+     * @brief 申请一个节点（仅初始化 xnext_ptr，元素值由调用方构造）。
+     */
+    x_node_ptr_t alloc_node(void)
+    {
+        x_node_alloc_t xnode_allocator(*(x_allocator_t *)this);
+
+        x_node_ptr_t xnode_ptr = xnode_allocator.allocate(1);
+        XASSERT(nullptr != xnode_ptr);
+
+        new (&xnode_ptr->xnext_ptr) x_atomic_ptr_t(nullptr);
+        return xnode_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 释放一个节点（元素值须已析构）。
+     */
+    void free_node(x_node_ptr_t xnode_ptr)
+    {
+        if (nullptr != xnode_ptr)
+        {
+            xnode_ptr->xnext_ptr.~x_atomic_ptr_t();
+
+            x_node_alloc_t xnode_allocator(*(x_allocator_t *)this);
+            xnode_allocator.deallocate(xnode_ptr, 1);
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将节点链接至队列尾端（该接口仅由 push() 接口调用）。
+     */
+    void link_node(x_node_ptr_t xnode_ptr)
+    {
+        m_xst_queue_size.fetch_add(1, std::memory_order_release);
+
+        x_node_ptr_t xnode_prev = m_xnode_tail.exchange(xnode_ptr, std::memory_order_acq_rel);
+        xnode_prev->xnext_ptr.store(xnode_ptr, std::memory_order_release);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 释放队列头部的哑节点，以 xnode_next 作为新的哑节点（该接口仅由 pop()/try_pop() 接口调用）。
+     */
+    void move_head(x_node_ptr_t xnode_next)
+    {
+        free_node(m_xnode_head);
+        m_xnode_head = xnode_next;
+        m_xst_queue_size.fetch_sub(1, std::memory_order_release);
+    }
+
+    // data members
+protected:
+    x_node_ptr_t     m_xnode_head;     ///< 队列头部的哑节点（消费者独占）
+    x_atomic_size_t  m_xst_queue_size; ///< 队列中的元素数量
+    char             m_xct_pad[64];    ///< 隔离 消费者 与 生产者 所访问的数据，避免伪共享
+    x_atomic_ptr_t   m_xnode_tail;     ///< 队列尾端的节点（生产者以原子交换操作更新）
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XMPSC_QUEUE_H__
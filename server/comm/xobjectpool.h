@@ -8,14 +8,19 @@
  * 文件标识：
  * 文件摘要：对象池模板类。
  * 
- * 当前版本：1.0.0.0
+ * 当前版本：1.2.0.0
  * 作    者：
- * 完成日期：2019年02月09日
- * 版本摘要：
+ * 完成日期：2019年04月03日
+ * 版本摘要：x_objectpool_t 增加 原始内存的申请/回收、预分配 接口；增加 x_objectpool_allocator_t 分配器。
+ * 
+ * 历史版本：1.1.0.0
+ * 原作者  ：
+ * 完成日期：2019年04月02日
+ * 版本摘要：x_objectpool_t 改为无锁的侵入式空闲链表（带版本标签的 Treiber 栈），回收/申请不再额外分配内存。
  * 
- * 历史版本：
+ * 历史版本：1.0.0.0
  * 原作者  ：
- * 完成日期：
+ * 完成日期：2019年02月09日
  * 版本摘要：
  * </pre>
  */
@@ -23,17 +28,33 @@
 #ifndef __XOBJECTPOOL_H__
 #define __XOBJECTPOOL_H__
 
-#include <list>
 #include <set>
 #include <memory>
 #include <mutex>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
 
 ////////////////////////////////////////////////////////////////////////////////
 // x_objectpool_t
 
 /**
  * @class x_objectpool_t< _Ty, _ObjAllocator< _Ty > >
- * @brief 对象池模板类。
+ * @brief 对象池模板类（无锁）。
+ *
+ * @note
+ * <pre>
+ *   1. 已回收的对象（析构后）的内存，直接用作空闲链表的节点（侵入式），回收/申请操作不再额外分配内存；
+ *   2. 空闲链表为 Treiber 栈，栈顶指针的高位存放版本标签（每次 CAS 递增），以防止 ABA 问题：
+ *      64 位平台上取指针的低 48 位 + 16 位标签，32 位平台上取 32 位指针 + 32 位标签；
+ *   3. free_extra() 须在没有其他线程并发调用 alloc()/alloc_mem() 时执行（如 析构时），
+ *      因为 alloc() 可能正在读取某个空闲节点的链接指针；
+ *   4. alloc_mem()/recyc_mem() 只申请/回收对象的内存（不构造/析构对象），
+ *      可用于实现类的 operator new/delete，或作为分配器的内存来源（参看 x_objectpool_allocator_t）。
+ * </pre>
  */
 template< typename _Ty, typename _Alloc = std::allocator< _Ty > >
 class x_objectpool_t : protected _Alloc
@@ -46,15 +67,25 @@ public:
     using x_opsize_t     = size_t;
 
 private:
-    using x_locker_t     = std::mutex;
-    using x_autolock_t   = std::lock_guard< x_locker_t >;
-    using x_obj_queue_t  = typename std::list< x_object_ptr_t >;
-    using x_iterator_t   = typename std::list< x_object_ptr_t >::iterator;
+    /**
+     * @struct x_node_t
+     * @brief  空闲链表的节点（存放于已回收对象的内存中）。
+     */
+    typedef struct x_node_t
+    {
+        std::atomic< x_node_t * > xnext_ptr;  ///< 链表中的下一空闲节点
+    } x_node_t;
+
+    using x_tagptr_t = std::uint64_t;       ///< 带版本标签的栈顶指针
+
+    static constexpr unsigned   TAG_SHIFT = (sizeof(void *) >= 8) ? 48 : 32;
+    static constexpr x_tagptr_t PTR_MASK  = (((x_tagptr_t)1) << TAG_SHIFT) - 1;
 
     // constructor/destructor
 public:
     x_objectpool_t(void)
-        : m_que_size(0)
+        : m_xtp_head(0)
+        , m_que_size(0)
     {
 
     }
@@ -84,7 +115,7 @@ public:
     template< typename... _Args >
     x_object_ptr_t alloc(_Args && ... xargs)
     {
-        x_object_ptr_t xobj_ptr = alloc_obj_mem();
+        x_object_ptr_t xobj_ptr = alloc_mem();
         if (nullptr != xobj_ptr)
         {
             x_allocator_t::construct(xobj_ptr, std::forward< _Args >(xargs)...);
@@ -95,17 +126,53 @@ public:
 
     /**********************************************************/
     /**
-     * @brief 将对象回收至对象池中。
+     * @brief 将对象回收至对象池中（析构后，将其内存压入空闲链表）。
      */
     bool recyc(x_object_ptr_t xobj_ptr)
     {
         if (nullptr != xobj_ptr)
         {
-            x_autolock_t xautolock(m_sync_lock);
-
             x_allocator_t::destroy(xobj_ptr);
-            m_que_recyc.push_back(xobj_ptr);
-            m_que_size += 1;
+            return recyc_mem(xobj_ptr);
+        }
+
+        return false;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从对象池中申请对象的内存（不构造对象）。
+     * 
+     * @return x_object_ptr_t
+     *         - 返回 对象的内存地址（对象池为空时，新分配；分配失败时，抛出 std::bad_alloc 异常）。
+     */
+    x_object_ptr_t alloc_mem(void)
+    {
+        x_node_t * xnode_ptr = pop_node();
+        if (nullptr == xnode_ptr)
+        {
+            return x_allocator_t::allocate(1);
+        }
+
+        m_que_size.fetch_sub(1, std::memory_order_relaxed);
+        xnode_ptr->~x_node_t();
+
+        return (x_object_ptr_t)(void *)xnode_ptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将对象的内存（对象已析构）回收至对象池中。
+     */
+    bool recyc_mem(x_object_ptr_t xobj_ptr)
+    {
+        static_assert(sizeof(x_object_t) >= sizeof(x_node_t),
+                      "x_objectpool_t : sizeof(_Ty) must be no less than a pointer!");
+
+        if (nullptr != xobj_ptr)
+        {
+            push_node(::new ((void *)xobj_ptr) x_node_t);
+            m_que_size.fetch_add(1, std::memory_order_relaxed);
 
             return true;
         }
@@ -115,76 +182,275 @@ public:
 
     /**********************************************************/
     /**
-     * @brief 返回对象池缓存的对象数量。
+     * @brief 预分配对象的内存（预热），使对象池缓存的对象数量不少于 xst_count 。
+     * 
+     * @param [in ] xst_count : 期望缓存的对象数量。
+     * 
+     * @return x_opsize_t
+     *         - 返回 对象池缓存的对象数量（内存分配失败时，可能少于 xst_count）。
+     */
+    x_opsize_t reserve(x_opsize_t xst_count)
+    {
+        try
+        {
+            while (size() < xst_count)
+            {
+                recyc_mem(x_allocator_t::allocate(1));
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+        }
+
+        return size();
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回对象池缓存的对象数量（并发操作时为近似值）。
      */
     inline x_opsize_t size(void) const
     {
-        return m_que_size;
+        return m_que_size.load(std::memory_order_relaxed);
     }
 
     /**********************************************************/
     /**
-     * @brief 释放掉所有已经回收的对象。
+     * @brief 释放掉所有已经回收的对象（不可与 alloc() 并发执行）。
      */
     void free_extra(void)
     {
-        x_autolock_t xautolock(m_sync_lock);
+        x_tagptr_t xtp_head = m_xtp_head.load(std::memory_order_relaxed);
+        while (!m_xtp_head.compare_exchange_weak(
+                    xtp_head, make_tagptr(nullptr, tag_of(xtp_head) + 1),
+                    std::memory_order_acquire, std::memory_order_relaxed))
+        {
+        }
 
-        x_iterator_t   xobj_itr;
-        x_object_ptr_t xobj_ptr = nullptr;
+        x_node_t * xnode_ptr = ptr_of(xtp_head);
+        while (nullptr != xnode_ptr)
+        {
+            x_node_t * xnode_next = xnode_ptr->xnext_ptr.load(std::memory_order_relaxed);
 
-        //======================================
+            xnode_ptr->~x_node_t();
+            x_allocator_t::deallocate((x_object_ptr_t)(void *)xnode_ptr, 1);
+            m_que_size.fetch_sub(1, std::memory_order_relaxed);
 
-        for (xobj_itr = m_que_recyc.begin(); xobj_itr != m_que_recyc.end(); ++xobj_itr)
+            xnode_ptr = xnode_next;
+        }
+    }
+
+    // internal invoking
+private:
+    /**********************************************************/
+    /**
+     * @brief 组合 节点指针 与 版本标签。
+     */
+    static inline x_tagptr_t make_tagptr(x_node_t * xnode_ptr, x_tagptr_t xtag)
+    {
+        assert(0 == ((x_tagptr_t)(std::uintptr_t)xnode_ptr & ~PTR_MASK));
+        return ((x_tagptr_t)(std::uintptr_t)xnode_ptr) | (xtag << TAG_SHIFT);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 提取 节点指针。
+     */
+    static inline x_node_t * ptr_of(x_tagptr_t xtp_value)
+    {
+        return (x_node_t *)(std::uintptr_t)(xtp_value & PTR_MASK);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 提取 版本标签。
+     */
+    static inline x_tagptr_t tag_of(x_tagptr_t xtp_value)
+    {
+        return (xtp_value >> TAG_SHIFT);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 将空闲节点压入空闲链表。
+     */
+    void push_node(x_node_t * xnode_ptr)
+    {
+        x_tagptr_t xtp_head = m_xtp_head.load(std::memory_order_relaxed);
+        do
         {
-            xobj_ptr = *xobj_itr;
+            xnode_ptr->xnext_ptr.store(ptr_of(xtp_head), std::memory_order_relaxed);
+        } while (!m_xtp_head.compare_exchange_weak(
+                    xtp_head, make_tagptr(xnode_ptr, tag_of(xtp_head) + 1),
+                    std::memory_order_release, std::memory_order_relaxed));
+    }
 
-            if (nullptr != xobj_ptr)
+    /**********************************************************/
+    /**
+     * @brief 从空闲链表弹出空闲节点（链表为空时，返回 nullptr）。
+     */
+    x_node_t * pop_node(void)
+    {
+        x_tagptr_t xtp_head = m_xtp_head.load(std::memory_order_acquire);
+        x_node_t * xnode_ptr = ptr_of(xtp_head);
+
+        while (nullptr != xnode_ptr)
+        {
+            // 节点可能已被其他线程弹出并重用，读到的 xnext_ptr 无效，
+            // 但此时栈顶的版本标签已改变，随后的 CAS 必然失败
+            x_node_t * xnode_next = xnode_ptr->xnext_ptr.load(std::memory_order_relaxed);
+
+            if (m_xtp_head.compare_exchange_weak(
+                    xtp_head, make_tagptr(xnode_next, tag_of(xtp_head) + 1),
+                    std::memory_order_acquire, std::memory_order_acquire))
             {
-                x_allocator_t::deallocate(xobj_ptr, 1);
-                xobj_ptr = nullptr;
+                break;
             }
+
+            xnode_ptr = ptr_of(xtp_head);
         }
 
-        m_que_recyc.clear();
-        m_que_size = 0;
+        return xnode_ptr;
+    }
 
-        //======================================
+    // data members
+protected:
+    std::atomic< x_tagptr_t > m_xtp_head;  ///< 空闲链表的栈顶（带版本标签）
+    std::atomic< x_opsize_t > m_que_size;  ///< 空闲链表的节点数量
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// x_objectpool_allocator_t
+
+/**
+ * @brief 容纳 _Ty 对象及额外 _Extra 字节（如 std::allocate_shared() 的引用计数控制块）的内存块类型
+ *        （对齐值不小于 std::max_align_t 的，以便容纳包含 _Ty 对象的其他类型）。
+ */
+template< typename _Ty, size_t _Extra >
+using x_objectpool_block_t = typename std::aligned_storage<
+                                sizeof(_Ty) + _Extra,
+                                (alignof(_Ty) > alignof(std::max_align_t)) ?
+                                    alignof(_Ty) : alignof(std::max_align_t) >::type;
+
+/**
+ * @class x_objectpool_allocator_t< _Ty, _Block >
+ * @brief 以 x_objectpool_t< _Block > 为内存来源的 STL 分配器（无状态）。
+ * @note
+ * <pre>
+ *   1. 同一 _Block 类型的所有分配器（包括 rebind 后的），共用一个（进程内的）内存块对象池；
+ *   2. 单个元素、且大小/对齐不超出 _Block 的分配，从对象池申请内存块，其余的由 std::allocator 分配；
+ *   3. 常用于 std::allocate_shared()：对象与引用计数控制块在同一内存块中，一同分配、回收。
+ * </pre>
+ *
+ * @param [in ] _Ty    : 分配的元素类型。
+ * @param [in ] _Block : 对象池的内存块类型（参看 x_objectpool_block_t）。
+ */
+template< typename _Ty, typename _Block >
+class x_objectpool_allocator_t
+{
+    template< typename _Uy, typename _Vy > friend class x_objectpool_allocator_t;
+
+    // common data types
+public:
+    using value_type    = _Ty;
+    using x_blockpool_t = x_objectpool_t< _Block >;
+
+    template< typename _Uy >
+    struct rebind
+    {
+        using other = x_objectpool_allocator_t< _Uy, _Block >;
+    };
+
+    // common invoking
+public:
+    /**********************************************************/
+    /**
+     * @brief 共用的 内存块对象池（仅由 _Block 确定，rebind 后的分配器亦为同一对象池）。
+     */
+    static inline x_blockpool_t & blockpool(void)
+    {
+        return x_objectpool_allocator_t< _Block, _Block >::block_instance();
     }
 
-    // internal invoking
-private:
+    // constructor/destructor
+public:
+    x_objectpool_allocator_t(void)
+    {
+
+    }
+
+    template< typename _Uy >
+    x_objectpool_allocator_t(const x_objectpool_allocator_t< _Uy, _Block > & xobject)
+    {
+
+    }
+
+    // public interfaces
+public:
     /**********************************************************/
     /**
-     * @brief 申请对象缓存。
+     * @brief 分配 xst_count 个元素的内存（失败时抛出 std::bad_alloc 异常）。
      */
-    x_object_ptr_t alloc_obj_mem(void)
+    _Ty * allocate(size_t xst_count)
     {
-        x_object_ptr_t xobj_ptr = nullptr;
+        if (is_block_fit(xst_count))
+        {
+            return (_Ty *)(void *)blockpool().alloc_mem();
+        }
 
-        x_autolock_t xautolock(m_sync_lock);
+        return std::allocator< _Ty >().allocate(xst_count);
+    }
 
-        if (m_que_recyc.empty())
+    /**********************************************************/
+    /**
+     * @brief 回收 xst_count 个元素的内存。
+     */
+    void deallocate(_Ty * xmem_ptr, size_t xst_count)
+    {
+        if (is_block_fit(xst_count))
         {
-            xobj_ptr = x_allocator_t::allocate(1);
+            blockpool().recyc_mem((_Block *)(void *)xmem_ptr);
         }
         else
         {
-            xobj_ptr = m_que_recyc.front();
-            m_que_recyc.pop_front();
-            m_que_size -= 1;
+            std::allocator< _Ty >().deallocate(xmem_ptr, xst_count);
         }
+    }
 
-        return xobj_ptr;
+    template< typename _Uy >
+    inline bool operator==(const x_objectpool_allocator_t< _Uy, _Block > & xobject) const
+    {
+        return true;
     }
 
-    // data members
-protected:
-    x_locker_t     m_sync_lock;  ///< 数据同步锁
-    x_obj_queue_t  m_que_recyc;  ///< 回收的对象的存储队列
+    template< typename _Uy >
+    inline bool operator!=(const x_objectpool_allocator_t< _Uy, _Block > & xobject) const
+    {
+        return false;
+    }
+
+    // internal invoking
+private:
+    /**********************************************************/
+    /**
+     * @brief 内存块对象池的实例（由 x_objectpool_allocator_t< _Block, _Block > 持有）。
+     */
+    static inline x_blockpool_t & block_instance(void)
+    {
+        static x_blockpool_t _S_blockpool;
+        return _S_blockpool;
+    }
 
-    // 鉴于某些低版本的 stl 在实现 size() 接口上不理想，所以增加该成员变量记录队列大小
-    x_opsize_t     m_que_size;   ///< 存储队列大小
+    /**********************************************************/
+    /**
+     * @brief 判断 xst_count 个元素的分配，是否可使用对象池的内存块。
+     */
+    static inline bool is_block_fit(size_t xst_count)
+    {
+        return ((1 == xst_count) &&
+                (sizeof(_Ty) <= sizeof(_Block)) &&
+                (alignof(_Ty) <= alignof(_Block)));
+    }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
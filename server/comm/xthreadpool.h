@@ -8,7 +8,32 @@
  * 文件标识：
  * 文件摘要：使用 C++11 新标准 thread 线程对象实现的线程池类。
  * 
- * 当前版本：1.2.0.0
+ * 当前版本：1.6.0.0
+ * 作    者：
+ * 完成日期：2019年03月12日
+ * 版本摘要：增加批量提交任务对象的接口 submit_tasks()，
+ *          同一任务队列仅加锁一次，并按任务数量唤醒相应数量的工作线程。
+ * 
+ * 历史版本：1.5.0.0
+ * 作    者：
+ * 完成日期：2019年03月10日
+ * 版本摘要：增加“弹性伸缩”功能：统计任务对象的排队延迟与工作线程的繁忙时长，
+ *          由调控线程周期性地在 [下限, 上限] 区间内调整工作线程数量。
+ * 
+ * 历史版本：1.4.0.0
+ * 作    者：
+ * 完成日期：2019年03月06日
+ * 版本摘要：任务队列增加优先级通道（紧急/常规），紧急通道的任务对象优先提取执行；
+ *          紧急通道连续提取达到上限次数后，强制提取一次常规通道的任务，防止其饥饿。
+ * 
+ * 历史版本：1.3.0.0
+ * 作    者：
+ * 完成日期：2019年03月02日
+ * 版本摘要：增加“亲和调度”模式：每个工作线程持有独立的任务队列，
+ *          任务对象按 affinity_key() 散列至固定的工作线程执行，
+ *          并可在队列深度偏离均值过多时，由空闲线程进行任务窃取以达到负载均衡。
+ * 
+ * 历史版本：1.2.0.0
  * 作    者：
  * 完成日期：2019年01月18日
  * 版本摘要：任务对象增加挂起判断接口，解决“某一类任务对象在线程池中可顺序执行”的问题。
@@ -31,6 +56,7 @@
 #define __XTHREADPOOL_H__
 
 #include <list>
+#include <vector>
 #include <functional>
 #include <utility>
 #include <type_traits>
@@ -453,6 +479,21 @@ private:
     using x_locker_t = std::mutex;
 
 public:
+    using x_clock_t  = std::chrono::steady_clock;
+    using x_tick_t   = x_clock_t::rep;
+
+public:
+    /**
+     * @enum  emTaskPriority
+     * @brief 任务对象的优先级（即任务队列的执行通道）。
+     */
+    typedef enum emTaskPriority
+    {
+        ETASK_PRIORITY_URGENT = 0,  ///< 紧急通道（控制类的任务对象，优先提取执行）
+        ETASK_PRIORITY_NORMAL = 1,  ///< 常规通道
+        ETASK_PRIORITY_LEVELS = 2,  ///< 优先级通道的数量
+    } emTaskPriority;
+
     /** 前置声明 */
     struct x_running_checker_t;
     struct x_task_deleter_t;
@@ -495,6 +536,25 @@ public:
          */
         virtual void set_running_flag(bool xrunning_flag) { }
 
+        /**********************************************************/
+        /**
+         * @brief 返回任务对象的亲和键值（仅在 亲和调度 模式下生效）。
+         *
+         * @note
+         * <pre>
+         *   亲和键值相同的任务对象，总是被投递至同一个工作线程的任务队列中执行；
+         *   返回 x_threadpool_t::xaffinity_none() 时，则以轮询方式投递至各个工作线程。
+         * </pre>
+         */
+        virtual size_t affinity_key(void) const { return x_threadpool_t::xaffinity_none(); }
+
+        /**********************************************************/
+        /**
+         * @brief 返回任务对象的优先级（参看 emTaskPriority 枚举值）。
+         * @note  该接口在任务对象提交时被调用，以选定其所在的执行通道。
+         */
+        virtual size_t priority(void) const { return ETASK_PRIORITY_NORMAL; }
+
         /**********************************************************/
         /**
          * @brief 获取任务对象的删除器，重载该接口，可实现自定义的任务对象回收方式。
@@ -512,6 +572,19 @@ public:
         {
             return &x_threadpool_t::_S_task_common_deleter;
         }
+
+        // public interfaces
+    public:
+        /**********************************************************/
+        /**
+         * @brief 返回任务对象提交至线程池时的时间戳（std::chrono::steady_clock 的计数值）。
+         */
+        inline x_tick_t submit_tick(void) const { return m_xtick_submit; }
+
+        // data members
+    private:
+        friend x_threadpool_t;
+        x_tick_t m_xtick_submit = 0;  ///< 任务对象提交至线程池时的时间戳
     };
 
     /** 任务对象指针类型 */
@@ -603,6 +676,323 @@ private:
     /** 任务对象的通用删除器 */
     static x_task_deleter_t _S_task_common_deleter;
 
+    /**
+     * @enum  emConstValue
+     * @brief 相关的枚举常量值。
+     */
+    typedef enum emConstValue
+    {
+        ECV_STEAL_PERIOD = 10,   ///< 亲和调度模式下，空闲工作线程检测任务窃取的周期（单位 毫秒）
+        ECV_URGENT_BURST = 8,    ///< 紧急通道连续提取任务对象的上限次数（超出后须提取一次常规通道的任务对象）
+        ECV_ELASTIC_PERIOD = 1000, ///< 弹性伸缩的默认调控周期（单位 毫秒）
+    } emConstValue;
+
+    /**
+     * @class x_task_queue_t
+     * @brief 任务队列（由 提交队列 与 待执行队列 两级构成，降低 提交 与 提取 操作之间的锁竞争）。
+     */
+    class x_task_queue_t
+    {
+        // constructor/destructor
+    public:
+        x_task_queue_t(void)
+            : m_xst_urgent_burst(0)
+            , m_enable_get_task(true)
+            , m_xst_lst_tasks(0)
+        {
+
+        }
+
+        ~x_task_queue_t(void)
+        {
+
+        }
+
+        x_task_queue_t(x_task_queue_t && xobject) = delete;
+        x_task_queue_t & operator=(x_task_queue_t && xobject) = delete;
+        x_task_queue_t(const x_task_queue_t & xobject) = delete;
+        x_task_queue_t & operator=(const x_task_queue_t & xobject) = delete;
+
+        // public interfaces
+    public:
+        /**********************************************************/
+        /**
+         * @brief 返回任务队列中的对象数量。
+         */
+        inline size_t size(void) const
+        {
+            return m_xst_lst_tasks;
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 投递任务对象。
+         */
+        void push(x_task_ptr_t xtask_ptr)
+        {
+            size_t xst_lane = (nullptr != xtask_ptr) ? xtask_ptr->priority() : ETASK_PRIORITY_NORMAL;
+            if (xst_lane >= ETASK_PRIORITY_LEVELS)
+                xst_lane = ETASK_PRIORITY_LEVELS - 1;
+
+            std::lock_guard< x_locker_t > xautolock(m_lock_smt_task);
+
+            m_lst_smt_tasks[xst_lane].push_back(xtask_ptr);
+            m_xst_lst_tasks.fetch_add(1);
+
+            m_thds_notifier.notify_one();
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 批量投递任务对象（仅加锁一次，不进行唤醒通知）。
+         * 
+         * @param [in ] xiter_first : 区间的起始位置。
+         * @param [in ] xiter_last  : 区间的结束位置。
+         * @param [in ] xfunc_take  : 从区间元素中取出待投递的任务对象（返回 nullptr 时，跳过该元素）。
+         * 
+         * @return size_t
+         *         - 返回投递的任务对象数量。
+         */
+        template< typename _Iter, typename _Func >
+        size_t push(_Iter xiter_first, _Iter xiter_last, _Func && xfunc_take)
+        {
+            size_t xst_count = 0;
+
+            std::lock_guard< x_locker_t > xautolock(m_lock_smt_task);
+
+            for (; xiter_first != xiter_last; ++xiter_first)
+            {
+                x_task_ptr_t xtask_ptr = xfunc_take(*xiter_first);
+                if (nullptr == xtask_ptr)
+                {
+                    continue;
+                }
+
+                size_t xst_lane = xtask_ptr->priority();
+                if (xst_lane >= ETASK_PRIORITY_LEVELS)
+                    xst_lane = ETASK_PRIORITY_LEVELS - 1;
+
+                m_lst_smt_tasks[xst_lane].push_back(xtask_ptr);
+                xst_count += 1;
+            }
+
+            m_xst_lst_tasks.fetch_add(xst_count);
+
+            return xst_count;
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 唤醒 xst_wakes 个等待中的工作线程。
+         */
+        void notify(size_t xst_wakes)
+        {
+            std::lock_guard< x_locker_t > xautolock(m_lock_smt_task);
+            while (xst_wakes-- > 0)
+            {
+                m_thds_notifier.notify_one();
+            }
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 从任务队列中提取（非挂起状态的）任务对象。
+         */
+        x_task_ptr_t pop(void)
+        {
+            x_task_ptr_t xtask_ptr = nullptr;
+            if (!m_enable_get_task)
+            {
+                return nullptr;
+            }
+
+            std::lock_guard< x_locker_t > xautolock(m_lock_run_task);
+
+            {
+                m_lock_smt_task.lock();
+                for (size_t xst_lane = 0; xst_lane < ETASK_PRIORITY_LEVELS; ++xst_lane)
+                {
+                    if (!m_lst_smt_tasks[xst_lane].empty())
+                    {
+                        m_lst_run_tasks[xst_lane].splice(m_lst_run_tasks[xst_lane].end(),
+                                                         std::move(m_lst_smt_tasks[xst_lane]));
+                    }
+                }
+                m_lock_smt_task.unlock();
+            }
+
+            // 紧急通道连续提取的次数达到上限时，优先提取一次常规通道的任务对象
+            if (m_xst_urgent_burst >= ECV_URGENT_BURST)
+            {
+                xtask_ptr = pop_lane(ETASK_PRIORITY_NORMAL);
+                if (nullptr != xtask_ptr)
+                    m_xst_urgent_burst = 0;
+            }
+
+            for (size_t xst_lane = 0; (nullptr == xtask_ptr) && (xst_lane < ETASK_PRIORITY_LEVELS); ++xst_lane)
+            {
+                xtask_ptr = pop_lane(xst_lane);
+                if (nullptr != xtask_ptr)
+                {
+                    if (ETASK_PRIORITY_URGENT == xst_lane)
+                        m_xst_urgent_burst += 1;
+                    else
+                        m_xst_urgent_burst = 0;
+                }
+            }
+
+            if (nullptr != xtask_ptr)
+            {
+                xtask_ptr->set_running_flag(true);
+            }
+
+            return xtask_ptr;
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 任务对象执行完成后，将其转换为 非挂起状态。
+         * @note  加锁进行操作，是为了与 pop() 内的操作保持队列的同步。
+         */
+        void finish(x_task_ptr_t xtask_ptr)
+        {
+            // 标识当前不可提取待执行的任务对象，迫使 pop() 内部迅速解锁
+            m_enable_get_task = false;
+
+            m_lock_run_task.lock();
+            xtask_ptr->set_running_flag(false);
+            m_lock_run_task.unlock();
+
+            m_enable_get_task = true;
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 等待任务对象的投递通知。
+         */
+        template< typename _Pred >
+        void wait(_Pred xpred)
+        {
+            std::unique_lock< x_locker_t > xunique_locker(m_lock_smt_task);
+            m_thds_notifier.wait(xunique_locker, xpred);
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 等待任务对象的投递通知（限定超时时间，单位 毫秒）。
+         */
+        template< typename _Pred >
+        void wait_for(size_t xst_msecs, _Pred xpred)
+        {
+            std::unique_lock< x_locker_t > xunique_locker(m_lock_smt_task);
+            m_thds_notifier.wait_for(xunique_locker, std::chrono::milliseconds(xst_msecs), xpred);
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 通知所有等待中的工作线程。
+         */
+        void notify_all(void)
+        {
+            std::lock_guard< x_locker_t > xautolock(m_lock_smt_task);
+            m_thds_notifier.notify_all();
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 取出任务队列中所有的任务对象。
+         */
+        void take_all(std::list< x_task_ptr_t > & xlst_tasks)
+        {
+            m_enable_get_task = false;
+
+            std::lock_guard< x_locker_t > xautolock_run(m_lock_run_task);
+            std::lock_guard< x_locker_t > xautolock_smt(m_lock_smt_task);
+
+            for (size_t xst_lane = 0; xst_lane < ETASK_PRIORITY_LEVELS; ++xst_lane)
+            {
+                xlst_tasks.splice(xlst_tasks.end(), std::move(m_lst_run_tasks[xst_lane]));
+                xlst_tasks.splice(xlst_tasks.end(), std::move(m_lst_smt_tasks[xst_lane]));
+            }
+
+            m_xst_urgent_burst = 0;
+            m_enable_get_task = true;
+            m_xst_lst_tasks.store(0);
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 清除任务队列中所有的任务对象。
+         */
+        void cleanup(void)
+        {
+            x_task_ptr_t       xtask_ptr    = nullptr;
+            x_task_deleter_t * xdeleter_ptr = nullptr;
+
+            std::list< x_task_ptr_t > xlst_tasks;
+            take_all(xlst_tasks);
+
+            while (!xlst_tasks.empty())
+            {
+                xtask_ptr = xlst_tasks.front();
+                xlst_tasks.pop_front();
+
+                if (nullptr != xtask_ptr)
+                {
+                    xdeleter_ptr = const_cast< x_task_deleter_t * >(xtask_ptr->get_deleter());
+                    if (nullptr != xdeleter_ptr)
+                    {
+                        xdeleter_ptr->delete_task(xtask_ptr);
+                        xdeleter_ptr = nullptr;
+                    }
+
+                    xtask_ptr = nullptr;
+                }
+            }
+        }
+
+        // internal invoking
+    private:
+        /**********************************************************/
+        /**
+         * @brief 从指定通道的待执行队列中提取（非挂起状态的）任务对象（须在 m_lock_run_task 加锁状态下调用）。
+         */
+        x_task_ptr_t pop_lane(size_t xst_lane)
+        {
+            x_task_ptr_t xtask_ptr = nullptr;
+            std::list< x_task_ptr_t > & xlst_tasks = m_lst_run_tasks[xst_lane];
+
+            for (std::list< x_task_ptr_t >::iterator itlst = xlst_tasks.begin();
+                 (itlst != xlst_tasks.end()) && m_enable_get_task;
+                 ++itlst)
+            {
+                if ((nullptr == *itlst) || !(*itlst)->is_suspend())
+                {
+                    xtask_ptr = *itlst;
+                    xlst_tasks.erase(itlst);
+                    m_xst_lst_tasks.fetch_sub(1);
+                    break;
+                }
+            }
+
+            return xtask_ptr;
+        }
+
+        // data members
+    private:
+        std::condition_variable    m_thds_notifier;   ///< 工作线程对象的通知器（条件变量）
+
+        mutable x_locker_t         m_lock_smt_task;   ///< 用于提交操作的任务队列的同步操作锁
+        std::list< x_task_ptr_t >  m_lst_smt_tasks[ETASK_PRIORITY_LEVELS]; ///< 用于提交操作的任务队列（按优先级通道划分）
+
+        mutable x_locker_t         m_lock_run_task;   ///< 待执行的任务队列的同步操作锁
+        std::list< x_task_ptr_t >  m_lst_run_tasks[ETASK_PRIORITY_LEVELS]; ///< 待执行的任务队列（按优先级通道划分）
+        size_t                     m_xst_urgent_burst;///< 紧急通道连续提取任务对象的次数
+
+        volatile bool              m_enable_get_task; ///< 标识当前是否可提取待执行的任务对象
+        std::atomic< size_t >      m_xst_lst_tasks;   ///< 任务队列中的对象数量
+    };
+
 private:
     /**
      * @struct x_task_bind_t
@@ -732,13 +1122,32 @@ public:
         return std::thread::hardware_concurrency();
     }
 
+    /**********************************************************/
+    /**
+     * @brief 返回表示 “无亲和键值” 的常量值（参看 x_task_t::affinity_key() 接口）。
+     */
+    static inline size_t xaffinity_none(void) noexcept
+    {
+        return ~static_cast< size_t >(0);
+    }
+
     // constructor/destructor
 public:
     explicit x_threadpool_t(void) noexcept
         : m_enable_running(false)
         , m_xthds_capacity(0)
-        , m_enable_get_task(true)
-        , m_xst_lst_tasks(0)
+        , m_xbt_affinity(false)
+        , m_xst_rebalance(0)
+        , m_xst_queues(0)
+        , m_xst_round(0)
+        , m_xthds_min(0)
+        , m_xthds_max(0)
+        , m_xst_delay_us(0)
+        , m_xst_period_ms(ECV_ELASTIC_PERIOD)
+        , m_xbt_elastic_run(false)
+        , m_xlit_delay_sum(0)
+        , m_xst_delay_count(0)
+        , m_xlit_busy_sum(0)
         , m_xst_task_count(0)
     {
 
@@ -749,6 +1158,15 @@ public:
         if (is_startup())
             shutdown();
         cleanup_task();
+
+        for (std::vector< x_task_queue_t * >::iterator itvec = m_vec_queues.begin();
+             itvec != m_vec_queues.end();
+             ++itvec)
+        {
+            delete *itvec;
+        }
+        m_vec_queues.clear();
+        m_xst_queues.store(0);
     }
 
     x_threadpool_t(x_threadpool_t && xobject) = delete;
@@ -758,6 +1176,96 @@ public:
 
     // public interfaces
 public:
+    /**********************************************************/
+    /**
+     * @brief 设置 亲和调度 模式（须在线程池首次启动前调用）。
+     * 
+     * @note
+     * <pre>
+     *   亲和调度模式下，每个工作线程持有独立的任务队列，任务对象按 x_task_t::affinity_key()
+     *   散列至固定的工作线程执行，使同一关联对象的任务总在同一 CPU 核心上运行；
+     *   工作线程提取自身队列的任务时，几乎不存在锁竞争。
+     * </pre>
+     * 
+     * @param [in ] xenable       : 是否启用 亲和调度 模式。
+     * @param [in ] xst_rebalance : 负载均衡阈值，某个任务队列的深度超过 （均值 + xst_rebalance） 时，
+     *                              空闲的工作线程可从中窃取任务对象（为 0 时，不进行负载均衡）。
+     * 
+     * @return bool
+     *         - 成功，返回 true；
+     *         - 失败，返回 false（线程池已经启动过）。
+     */
+    bool set_affinity(bool xenable, size_t xst_rebalance = 0)
+    {
+        std::lock_guard< x_locker_t > xautolock_thds(m_lock_thread);
+
+        if (!m_lst_threads.empty() || (m_xst_queues > 0))
+        {
+            return false;
+        }
+
+        m_xbt_affinity  = xenable;
+        m_xst_rebalance = xst_rebalance;
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断是否启用 亲和调度 模式。
+     */
+    inline bool is_affinity(void) const { return m_xbt_affinity; }
+
+    /**********************************************************/
+    /**
+     * @brief 设置 弹性伸缩 功能（须在线程池启动前调用）。
+     * 
+     * @note
+     * <pre>
+     *   启用后，调控线程每隔 xst_period_ms 毫秒统计一次：
+     *   1. 任务对象的平均排队延迟（提交至被提取执行的时长）超过 xst_delay_us，
+     *      或周期内有任务积压却无任务被提取，则增加工作线程（约 1/4，至少 1 个）；
+     *   2. 平均排队延迟低于 xst_delay_us 的一半，且工作线程繁忙时长不足一半，
+     *      则减少 1 个工作线程。
+     *   工作线程数量始终保持在 [xthds_min, xthds_max] 区间内。
+     * </pre>
+     * 
+     * @param [in ] xthds_min     : 工作线程数量的下限（至少为 1）。
+     * @param [in ] xthds_max     : 工作线程数量的上限（不大于 xthds_min 时，不启用弹性伸缩）。
+     * @param [in ] xst_delay_us  : 排队延迟的目标值（单位 微秒，为 0 时，不启用弹性伸缩）。
+     * @param [in ] xst_period_ms : 调控周期（单位 毫秒）。
+     * 
+     * @return bool
+     *         - 成功，返回 true；
+     *         - 失败，返回 false（线程池已经启动）。
+     */
+    bool set_elastic(size_t xthds_min,
+                     size_t xthds_max,
+                     size_t xst_delay_us,
+                     size_t xst_period_ms = ECV_ELASTIC_PERIOD)
+    {
+        if (is_startup())
+        {
+            return false;
+        }
+
+        m_xthds_min    = (xthds_min > 0) ? xthds_min : 1;
+        m_xthds_max    = (xthds_max > m_xthds_min) ? xthds_max : m_xthds_min;
+        m_xst_delay_us = xst_delay_us;
+        m_xst_period_ms = (xst_period_ms > 0) ? xst_period_ms : ECV_ELASTIC_PERIOD;
+
+        return true;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断是否启用 弹性伸缩 功能。
+     */
+    inline bool is_elastic(void) const
+    {
+        return ((m_xst_delay_us > 0) && (m_xthds_max > m_xthds_min));
+    }
+
     /**********************************************************/
     /**
      * @brief 启动线程池。
@@ -777,8 +1285,16 @@ public:
         // 启动各个工作线程
         try
         {
-            m_enable_get_task = true;
-            resize((0 != xthds) ? xthds : (2 * hardware_concurrency() + 1));
+            xthds = (0 != xthds) ? xthds : (2 * hardware_concurrency() + 1);
+            if (is_elastic())
+                xthds = (xthds < m_xthds_min) ? m_xthds_min : ((xthds > m_xthds_max) ? m_xthds_max : xthds);
+
+            if (m_xbt_affinity)
+                build_affinity_queues(xthds);
+            resize(xthds);
+
+            if (is_elastic())
+                start_elastic();
         }
         catch(...)
         {
@@ -797,6 +1313,7 @@ public:
     {
         try
         {
+            stop_elastic();
             resize(0);
         }
         catch(...)
@@ -833,6 +1350,8 @@ public:
     /**********************************************************/
     /**
      * @brief 调整工作线程数量。
+     * @note  亲和调度模式下，任务队列的数量在启动时确定，此后不随工作线程数量变化：
+     *        缩减后遗留的任务队列由其他工作线程窃取执行；新增的工作线程仅进行任务窃取。
      */
     void resize(size_t xthds)
     {
@@ -859,10 +1378,7 @@ public:
         else if (xst_size > 0)
         {
             // 通知所有工作线程对象，检测退出事件
-            {
-                std::lock_guard< x_locker_t > xautolock_task(m_lock_smt_task);
-                m_thds_notifier.notify_all();
-            }
+            notify_all_queues();
 
             // 递减工作线程数量
             while (xst_size > xthds)
@@ -884,15 +1400,100 @@ public:
     {
         if (nullptr != xtask_ptr)
         {
-            m_lock_smt_task.lock();
+            xtask_ptr->m_xtick_submit = x_clock_t::now().time_since_epoch().count();
 
-            m_lst_smt_tasks.push_back(xtask_ptr);
-            m_xst_lst_tasks.fetch_add(1);
             m_xst_task_count.fetch_add(1);
+            select_queue(xtask_ptr).push(xtask_ptr);
+        }
+    }
 
-            m_thds_notifier.notify_one();
+    /**********************************************************/
+    /**
+     * @brief 批量提交任务对象（区间 [xiter_first, xiter_last) 中的元素为 x_task_ptr_t 类型）。
+     * 
+     * @note
+     * <pre>
+     *   与逐个调用 submit_task() 相比，同一任务队列仅加锁一次，
+     *   并按所投递的任务数量（不超过工作线程数量）唤醒工作线程；
+     *   区间中的 nullptr 元素将被忽略，同一任务队列中保持区间内的先后次序。
+     * </pre>
+     */
+    template< typename _Iter >
+    void submit_tasks(_Iter xiter_first, _Iter xiter_last)
+    {
+        using x_entry_t = std::pair< size_t, x_task_ptr_t >;
+
+        const x_tick_t xtick_submit = x_clock_t::now().time_since_epoch().count();
+        const size_t   xst_queues   = m_xst_queues.load(std::memory_order_acquire);
+
+        //======================================
+        // 共享任务队列
+
+        if (0 == xst_queues)
+        {
+            size_t xst_count = m_xqueue_shared.push(
+                xiter_first, xiter_last,
+                [this, xtick_submit](x_task_ptr_t xtask_ptr) -> x_task_ptr_t
+                {
+                    if (nullptr != xtask_ptr)
+                    {
+                        xtask_ptr->m_xtick_submit = xtick_submit;
+                        m_xst_task_count.fetch_add(1);
+                    }
+                    return xtask_ptr;
+                });
+
+            if (xst_count > 0)
+            {
+                const size_t xst_thds = m_xthds_capacity;
+                if (xst_count >= xst_thds)
+                    m_xqueue_shared.notify_all();
+                else
+                    m_xqueue_shared.notify(xst_count);
+            }
 
-            m_lock_smt_task.unlock();
+            return;
+        }
+
+        //======================================
+        // 亲和调度模式：先为各个任务对象选定任务队列，再按任务队列分组投递
+
+        std::vector< x_entry_t > xvec_entry;
+        for (; xiter_first != xiter_last; ++xiter_first)
+        {
+            x_task_ptr_t xtask_ptr = *xiter_first;
+            if (nullptr != xtask_ptr)
+            {
+                xtask_ptr->m_xtick_submit = xtick_submit;
+                xvec_entry.push_back(x_entry_t(select_index(xtask_ptr, xst_queues), xtask_ptr));
+            }
+        }
+
+        m_xst_task_count.fetch_add(xvec_entry.size());
+
+        for (size_t xiter = 0; xiter < xvec_entry.size(); ++xiter)
+        {
+            const size_t xst_index = xvec_entry[xiter].first;
+            if (xaffinity_none() == xst_index)
+            {
+                continue;
+            }
+
+            size_t xst_count = m_vec_queues[xst_index]->push(
+                xvec_entry.begin() + xiter, xvec_entry.end(),
+                [xst_index](x_entry_t & xentry) -> x_task_ptr_t
+                {
+                    if (xst_index != xentry.first)
+                        return nullptr;
+                    xentry.first = xaffinity_none();
+                    return xentry.second;
+                });
+
+            // 每个任务队列仅有一个驻守的工作线程在其上等待
+            if (xst_count > 0)
+            {
+                m_vec_queues[xst_index]->notify(1);
+            }
         }
     }
 
@@ -928,43 +1529,33 @@ public:
 
     /**********************************************************/
     /**
-     * @brief 清除任务队列中所有的任务对象。
+     * @brief 返回各个任务队列中（等待执行）的任务对象数量。
      */
-    void cleanup_task(void)
+    size_t queued_count(void) const
     {
-        x_task_ptr_t       xtask_ptr    = nullptr;
-        x_task_deleter_t * xdeleter_ptr = nullptr;
-
-        m_enable_get_task = false;
+        size_t xst_count = m_xqueue_shared.size();
 
-        std::lock_guard< x_locker_t > xautolock_run(m_lock_run_task);
-        std::lock_guard< x_locker_t > xautolock_smt(m_lock_smt_task);
-
-        if (!m_lst_smt_tasks.empty())
+        for (size_t xiter = 0, xst_queues = m_xst_queues; xiter < xst_queues; ++xiter)
         {
-            m_lst_run_tasks.splice(m_lst_run_tasks.end(), std::move(m_lst_smt_tasks));
+            xst_count += m_vec_queues[xiter]->size();
         }
 
-        while (!m_lst_run_tasks.empty())
-        {
-            xtask_ptr = m_lst_run_tasks.front();
-            m_lst_run_tasks.pop_front();
+        return xst_count;
+    }
 
-            if (nullptr != xtask_ptr)
-            {
-                xdeleter_ptr = const_cast< x_task_deleter_t * >(xtask_ptr->get_deleter());
-                if (nullptr != xdeleter_ptr)
-                {
-                    xdeleter_ptr->delete_task(xtask_ptr);
-                    xdeleter_ptr = nullptr;
-                }
+    /**********************************************************/
+    /**
+     * @brief 清除任务队列中所有的任务对象。
+     */
+    void cleanup_task(void)
+    {
+        m_xqueue_shared.cleanup();
 
-                xtask_ptr = nullptr;
-            }
+        for (size_t xiter = 0, xst_queues = m_xst_queues; xiter < xst_queues; ++xiter)
+        {
+            m_vec_queues[xiter]->cleanup();
         }
 
-        m_enable_get_task = true;
-        m_xst_lst_tasks.store(0);
         m_xst_task_count.store(0);
     }
 
@@ -972,55 +1563,78 @@ public:
 private:
     /**********************************************************/
     /**
-     * @brief 获取任务队列的任务数量。
+     * @brief 构建 亲和调度 模式下各个工作线程的任务队列，
+     *        并将启动前已提交至共享任务队列的任务对象重新分派。
      */
-    inline size_t get_lst_task_size(void) const
+    void build_affinity_queues(size_t xthds)
     {
-        return m_xst_lst_tasks;
+        if (m_xst_queues > 0)
+        {
+            return;
+        }
+
+        std::vector< x_task_queue_t * > xvec_queues;
+        xvec_queues.reserve(xthds);
+        for (size_t xiter = 0; xiter < xthds; ++xiter)
+        {
+            xvec_queues.push_back(new x_task_queue_t());
+        }
+
+        m_vec_queues.swap(xvec_queues);
+        m_xst_queues.store(m_vec_queues.size(), std::memory_order_release);
+
+        std::list< x_task_ptr_t > xlst_tasks;
+        m_xqueue_shared.take_all(xlst_tasks);
+
+        while (!xlst_tasks.empty())
+        {
+            select_queue(xlst_tasks.front()).push(xlst_tasks.front());
+            xlst_tasks.pop_front();
+        }
     }
 
     /**********************************************************/
     /**
-     * @brief 从任务队列中提取任务对象。
+     * @brief 为任务对象选取其所要投递的任务队列。
      */
-    x_task_ptr_t get_task(void)
+    x_task_queue_t & select_queue(x_task_ptr_t xtask_ptr)
     {
-        x_task_ptr_t xtask_ptr = nullptr;
-        if (!m_enable_get_task)
+        const size_t xst_queues = m_xst_queues.load(std::memory_order_acquire);
+        if (0 == xst_queues)
         {
-            return nullptr;
+            return m_xqueue_shared;
         }
 
-        std::lock_guard< x_locker_t > xautolock(m_lock_run_task);
+        return *m_vec_queues[select_index(xtask_ptr, xst_queues)];
+    }
 
+    /**********************************************************/
+    /**
+     * @brief 亲和调度模式下，为任务对象选取其所要投递的任务队列索引号。
+     */
+    size_t select_index(x_task_ptr_t xtask_ptr, size_t xst_queues)
+    {
+        size_t xst_key = xtask_ptr->affinity_key();
+        if (xaffinity_none() == xst_key)
         {
-            m_lock_smt_task.lock();
-            if (!m_lst_smt_tasks.empty())
-            {
-                m_lst_run_tasks.splice(m_lst_run_tasks.end(), std::move(m_lst_smt_tasks));
-            }
-            m_lock_smt_task.unlock();
+            xst_key = m_xst_round.fetch_add(1, std::memory_order_relaxed);
         }
 
-        for (std::list< x_task_ptr_t >::iterator itlst = m_lst_run_tasks.begin();
-             (itlst != m_lst_run_tasks.end()) && m_enable_get_task;
-             ++itlst)
-        {
-            if ((nullptr == *itlst) || !(*itlst)->is_suspend())
-            {
-                xtask_ptr = *itlst;
-                m_lst_run_tasks.erase(itlst);
-                m_xst_lst_tasks.fetch_sub(1);
-                break;
-            }
-        }
+        return (xst_key % xst_queues);
+    }
 
-        if (nullptr != xtask_ptr)
+    /**********************************************************/
+    /**
+     * @brief 通知所有任务队列上等待中的工作线程。
+     */
+    void notify_all_queues(void)
+    {
+        m_xqueue_shared.notify_all();
+
+        for (size_t xiter = 0, xst_queues = m_xst_queues; xiter < xst_queues; ++xiter)
         {
-            xtask_ptr->set_running_flag(true);
+            m_vec_queues[xiter]->notify_all();
         }
-
-        return xtask_ptr;
     }
 
     /**********************************************************/
@@ -1041,6 +1655,15 @@ private:
         return (xthread_index < m_xthds_capacity);
     }
 
+    /**********************************************************/
+    /**
+     * @brief 判断 亲和调度 模式下，空闲的工作线程是否需要定期检测任务窃取。
+     */
+    inline bool is_enable_steal(size_t xst_queues) const
+    {
+        return ((m_xst_rebalance > 0) || (m_xthds_capacity != xst_queues));
+    }
+
     /**********************************************************/
     /**
      * @brief 使当前线程让出 CPU 时间片。
@@ -1060,63 +1683,324 @@ private:
 
     /**********************************************************/
     /**
-     * @brief 工作线程的执行流程。
+     * @brief 从共享的任务队列中提取任务对象（常规调度模式）。
+     * 
+     * @param [in ] xht_checker : 工作线程的运行检测对象。
+     * @param [out] xcounter    : 让出 CPU 时间片的计数器。
+     * @param [out] xqueue_ptr  : 操作成功返回时，回参任务对象所提取自的任务队列。
+     * 
+     * @return x_task_ptr_t
+     *         - 成功，返回 任务对象；
+     *         - 失败，返回 nullptr。
      */
-    void thread_run(size_t xthread_index)
+    x_task_ptr_t get_shared_task(x_running_checker_t & xht_checker,
+                                 size_t & xcounter,
+                                 x_task_queue_t *& xqueue_ptr)
     {
-        x_running_checker_t xht_checker(this, xthread_index);
+        x_task_ptr_t xtask_ptr = nullptr;
 
-        x_task_ptr_t       xtask_ptr    = nullptr;
-        x_task_deleter_t * xdeleter_ptr = nullptr;
+        if (m_xqueue_shared.size() <= 0)
+        {
+            m_xqueue_shared.wait([this, &xht_checker](void) -> bool
+                                 {
+                                     return ((m_xqueue_shared.size() > 0) ||
+                                             (!xht_checker.is_enable_running()));
+                                 });
+        }
+
+        if (!xht_checker.is_enable_running())
+        {
+            return nullptr;
+        }
 
-        size_t xcounter = 0;
+        xtask_ptr = m_xqueue_shared.pop();
+        if (nullptr == xtask_ptr)
+        {
+            if (m_xqueue_shared.size() > 0)
+                thread_yield(xcounter);
+            return nullptr;
+        }
 
-        m_enable_get_task = true;
+        xqueue_ptr = &m_xqueue_shared;
+        return xtask_ptr;
+    }
 
-        while (xht_checker.is_enable_running())
+    /**********************************************************/
+    /**
+     * @brief 提取任务对象（亲和调度模式）。
+     * 
+     * @param [in ] xht_checker : 工作线程的运行检测对象。
+     * @param [out] xcounter    : 让出 CPU 时间片的计数器。
+     * @param [out] xqueue_ptr  : 操作成功返回时，回参任务对象所提取自的任务队列。
+     * 
+     * @return x_task_ptr_t
+     *         - 成功，返回 任务对象；
+     *         - 失败，返回 nullptr。
+     */
+    x_task_ptr_t get_affinity_task(x_running_checker_t & xht_checker,
+                                   size_t & xcounter,
+                                   x_task_queue_t *& xqueue_ptr)
+    {
+        const size_t xst_queues    = m_xst_queues.load(std::memory_order_acquire);
+        const size_t xthread_index = xht_checker.thread_index();
+
+        x_task_ptr_t     xtask_ptr = nullptr;
+        x_task_queue_t * xhome_ptr = (xthread_index < xst_queues) ?
+                                        m_vec_queues[xthread_index] : &m_xqueue_shared;
+
+        // 优先提取所属任务队列中的任务对象
+        if ((xhome_ptr->size() > 0) && (nullptr != (xtask_ptr = xhome_ptr->pop())))
         {
-            if (get_lst_task_size() <= 0)
+            xqueue_ptr = xhome_ptr;
+            return xtask_ptr;
+        }
+
+        // 提取共享任务队列中遗留的任务对象（亲和调度模式建立前提交的）
+        if ((xhome_ptr != &m_xqueue_shared) &&
+            (m_xqueue_shared.size() > 0) &&
+            (nullptr != (xtask_ptr = m_xqueue_shared.pop())))
+        {
+            xqueue_ptr = &m_xqueue_shared;
+            return xtask_ptr;
+        }
+
+        // 尝试从其他工作线程的任务队列中窃取任务对象
+        xtask_ptr = steal_task(xthread_index, xst_queues, xqueue_ptr);
+        if (nullptr != xtask_ptr)
+        {
+            return xtask_ptr;
+        }
+
+        // 所属任务队列中仅剩挂起状态的任务对象，让出 CPU 时间片后重试
+        if (xhome_ptr->size() > 0)
+        {
+            thread_yield(xcounter);
+            return nullptr;
+        }
+
+        // 等待新的任务对象
+        auto xfunc_pred = [xhome_ptr, &xht_checker](void) -> bool
+                          {
+                              return ((xhome_ptr->size() > 0) ||
+                                      (!xht_checker.is_enable_running()));
+                          };
+
+        if (is_enable_steal(xst_queues) || (m_xqueue_shared.size() > 0))
+            xhome_ptr->wait_for(ECV_STEAL_PERIOD, xfunc_pred);
+        else
+            xhome_ptr->wait(xfunc_pred);
+
+        return nullptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 从其他工作线程的任务队列中窃取任务对象（亲和调度模式）。
+     * 
+     * @note
+     * <pre>
+     *   可窃取的任务队列：
+     *   1. 工作线程数量缩减后，无工作线程驻守的任务队列；
+     *   2. 启用负载均衡时，队列深度超过 （均值 + m_xst_rebalance） 的任务队列；
+     *   3. 工作线程数量增加后，新增的（无所属任务队列的）工作线程，可窃取任意任务队列。
+     *   窃取到的任务对象，其运行标识的同步操作仍在原任务队列上进行，
+     *   故同一亲和键值的任务对象之间，依然保持互斥执行。
+     * </pre>
+     */
+    x_task_ptr_t steal_task(size_t xthread_index, size_t xst_queues, x_task_queue_t *& xqueue_ptr)
+    {
+        const size_t xst_capacity = m_xthds_capacity;
+
+        x_task_ptr_t     xtask_ptr   = nullptr;
+        x_task_queue_t * xvictim_ptr = nullptr;
+        size_t           xst_limit   = 0;
+        size_t           xst_depth   = 0;
+
+        if (m_xst_rebalance > 0)
+        {
+            for (size_t xiter = 0; xiter < xst_queues; ++xiter)
+                xst_limit += m_vec_queues[xiter]->size();
+            xst_limit = xst_limit / xst_queues + m_xst_rebalance;
+        }
+
+        for (size_t xiter = 1; xiter <= xst_queues; ++xiter)
+        {
+            size_t xst_index = (xthread_index + xiter) % xst_queues;
+            if (xst_index == xthread_index)
+                continue;
+
+            xvictim_ptr = m_vec_queues[xst_index];
+            xst_depth   = xvictim_ptr->size();
+            if (0 == xst_depth)
+                continue;
+
+            if ((xthread_index >= xst_queues) ||
+                (xst_index >= xst_capacity) ||
+                ((m_xst_rebalance > 0) && (xst_depth > xst_limit)))
             {
-                std::unique_lock< x_locker_t > xunique_locker(m_lock_smt_task);
-                m_thds_notifier.wait(xunique_locker,
-                                     [this, &xht_checker](void) -> bool
-                                     {
-                                         return ((get_lst_task_size() > 0) ||
-                                                 (!xht_checker.is_enable_running()));
-                                     });
+                xtask_ptr = xvictim_ptr->pop();
+                if (nullptr != xtask_ptr)
+                {
+                    xqueue_ptr = xvictim_ptr;
+                    return xtask_ptr;
+                }
             }
+        }
+
+        return nullptr;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 启动 弹性伸缩 的调控线程。
+     */
+    void start_elastic(void)
+    {
+        if (m_thd_elastic.joinable())
+        {
+            return;
+        }
+
+        m_xlit_delay_sum.store(0);
+        m_xst_delay_count.store(0);
+        m_xlit_busy_sum.store(0);
+
+        m_xbt_elastic_run = true;
+        m_thd_elastic = std::thread([this](void) -> void { thread_elastic(); });
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 停止 弹性伸缩 的调控线程。
+     */
+    void stop_elastic(void)
+    {
+        {
+            std::lock_guard< x_locker_t > xautolock(m_lock_elastic);
+            m_xbt_elastic_run = false;
+            m_elastic_notifier.notify_all();
+        }
 
-            if (!xht_checker.is_enable_running())
+        if (m_thd_elastic.joinable())
+        {
+            m_thd_elastic.join();
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 弹性伸缩 调控线程的执行流程。
+     */
+    void thread_elastic(void)
+    {
+        std::unique_lock< x_locker_t > xunique_locker(m_lock_elastic);
+
+        while (m_xbt_elastic_run)
+        {
+            m_elastic_notifier.wait_for(xunique_locker,
+                                        std::chrono::milliseconds(m_xst_period_ms),
+                                        [this](void) -> bool { return !m_xbt_elastic_run; });
+            if (!m_xbt_elastic_run)
             {
                 break;
             }
 
-            xtask_ptr = get_task();
+            xunique_locker.unlock();
+            elastic_adjust();
+            xunique_locker.lock();
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 依据统计周期内的 排队延迟 与 繁忙时长，调整工作线程数量。
+     */
+    void elastic_adjust(void)
+    {
+        using x_ns_t = std::chrono::nanoseconds;
+
+        const x_tick_t xtick_delay = m_xlit_delay_sum.exchange(0);
+        const size_t   xst_count   = m_xst_delay_count.exchange(0);
+        const x_tick_t xtick_busy  = m_xlit_busy_sum.exchange(0);
+        const size_t   xthds       = m_xthds_capacity;
+
+        if (0 == xthds)
+        {
+            return;
+        }
+
+        // 统一换算为 纳秒 进行比较
+        const long long xlit_avg    = (xst_count > 0) ?
+            std::chrono::duration_cast< x_ns_t >(x_clock_t::duration(xtick_delay / (x_tick_t)xst_count)).count() : 0;
+        const long long xlit_busy   =
+            std::chrono::duration_cast< x_ns_t >(x_clock_t::duration(xtick_busy)).count();
+        const long long xlit_target = (long long)m_xst_delay_us * 1000LL;
+        const long long xlit_window = (long long)m_xst_period_ms * 1000000LL * (long long)xthds;
+
+        // 周期内有任务积压，却无任务对象被提取执行
+        const bool xbt_backlog = (0 == xst_count) && (queued_count() > 0);
+
+        if (((xlit_avg > xlit_target) || xbt_backlog) && (xthds < m_xthds_max))
+        {
+            size_t xthds_new = xthds + ((xthds >= 8) ? (xthds / 4) : 1);
+            resize((xthds_new < m_xthds_max) ? xthds_new : m_xthds_max);
+        }
+        else if ((xlit_avg < (xlit_target / 2)) && ((2 * xlit_busy) < xlit_window) && (xthds > m_xthds_min))
+        {
+            resize(xthds - 1);
+        }
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 工作线程的执行流程。
+     */
+    void thread_run(size_t xthread_index)
+    {
+        x_running_checker_t xht_checker(this, xthread_index);
+
+        x_task_queue_t   * xqueue_ptr   = nullptr;
+        x_task_ptr_t       xtask_ptr    = nullptr;
+        x_task_deleter_t * xdeleter_ptr = nullptr;
+
+        size_t   xcounter    = 0;
+        bool     xbt_elastic = is_elastic();
+        x_tick_t xtick_start = 0;
+
+        while (xht_checker.is_enable_running())
+        {
+            if (m_xst_queues > 0)
+                xtask_ptr = get_affinity_task(xht_checker, xcounter, xqueue_ptr);
+            else
+                xtask_ptr = get_shared_task(xht_checker, xcounter, xqueue_ptr);
+
             if (nullptr == xtask_ptr)
             {
-                if (get_lst_task_size() > 0)
-                    thread_yield(xcounter);
                 continue;
             }
 
-            if (xht_checker.is_enable_running())
+            if (xbt_elastic)
             {
-                xtask_ptr->run(&xht_checker);
+                xtick_start = x_clock_t::now().time_since_epoch().count();
+                m_xlit_delay_sum.fetch_add(xtick_start - xtask_ptr->submit_tick(), std::memory_order_relaxed);
+                m_xst_delay_count.fetch_add(1, std::memory_order_relaxed);
             }
 
-            // 执行完任务对象后，将任务对象转换为 非挂起状态，
-            // 加锁进行操作，是为了与 get_task() 内的操作保持队列的同步
+            // 已提取的任务对象，仅在线程池关闭时跳过执行（工作线程数量缩减时，仍须执行完毕）
+            if (is_enable_running())
             {
-                // 标识当前不可提取待执行的任务对象，迫使 get_task() 内部迅速解锁
-                m_enable_get_task = false;
-
-                m_lock_run_task.lock();
-                xtask_ptr->set_running_flag(false);
-                m_lock_run_task.unlock();
+                xtask_ptr->run(&xht_checker);
+            }
 
-                m_enable_get_task = true;
+            if (xbt_elastic)
+            {
+                m_xlit_busy_sum.fetch_add(x_clock_t::now().time_since_epoch().count() - xtick_start,
+                                          std::memory_order_relaxed);
             }
 
+            // 执行完任务对象后，在其所提取自的任务队列上，将任务对象转换为 非挂起状态
+            xqueue_ptr->finish(xtask_ptr);
+
             xdeleter_ptr = const_cast< x_task_deleter_t * >(xtask_ptr->get_deleter());
             if (nullptr != xdeleter_ptr)
             {
@@ -1134,16 +2018,26 @@ private:
     volatile size_t            m_xthds_capacity;  ///< 工作线程对象的上限数量
     std::list< std::thread >   m_lst_threads;     ///< 工作线程对象的队列
 
-    std::condition_variable    m_thds_notifier;   ///< 工作线程对象的通知器（条件变量）
-
-    mutable x_locker_t         m_lock_smt_task;   ///< 用于提交操作的任务队列的同步操作锁
-    std::list< x_task_ptr_t >  m_lst_smt_tasks;   ///< 用于提交操作的任务队列
-
-    mutable x_locker_t         m_lock_run_task;   ///< 待执行的任务队列的同步操作锁
-    std::list< x_task_ptr_t >  m_lst_run_tasks;   ///< 待执行的任务队列
+    x_task_queue_t             m_xqueue_shared;   ///< 共享的任务队列（常规调度模式）
+
+    bool                       m_xbt_affinity;    ///< 是否启用 亲和调度 模式
+    size_t                     m_xst_rebalance;   ///< 亲和调度模式下的负载均衡阈值（为 0 时，不进行负载均衡）
+    std::vector< x_task_queue_t * > m_vec_queues; ///< 亲和调度模式下，各个工作线程的任务队列
+    std::atomic< size_t >      m_xst_queues;      ///< 亲和调度模式下，任务队列的数量
+    std::atomic< size_t >      m_xst_round;       ///< 无亲和键值的任务对象的轮询投递计数
+
+    size_t                     m_xthds_min;       ///< 弹性伸缩：工作线程数量的下限
+    size_t                     m_xthds_max;       ///< 弹性伸缩：工作线程数量的上限
+    size_t                     m_xst_delay_us;    ///< 弹性伸缩：排队延迟的目标值（单位 微秒）
+    size_t                     m_xst_period_ms;   ///< 弹性伸缩：调控周期（单位 毫秒）
+    volatile bool              m_xbt_elastic_run; ///< 弹性伸缩：调控线程继续运行的标识值
+    x_locker_t                 m_lock_elastic;    ///< 弹性伸缩：调控线程的同步操作锁
+    std::condition_variable    m_elastic_notifier;///< 弹性伸缩：调控线程的通知器（条件变量）
+    std::thread                m_thd_elastic;     ///< 弹性伸缩：调控线程
+    std::atomic< x_tick_t >    m_xlit_delay_sum;  ///< 弹性伸缩：统计周期内，任务对象排队延迟的累计值
+    std::atomic< size_t >      m_xst_delay_count; ///< 弹性伸缩：统计周期内，被提取执行的任务对象数量
+    std::atomic< x_tick_t >    m_xlit_busy_sum;   ///< 弹性伸缩：统计周期内，工作线程执行任务的累计时长
 
-    volatile bool              m_enable_get_task; ///< 标识当前是否可提取待执行的任务对象
-    std::atomic< size_t >      m_xst_lst_tasks;   ///< 任务队列中的对象数量
     std::atomic< size_t >      m_xst_task_count;  ///< 任务对象总数量的计数器
 };
 
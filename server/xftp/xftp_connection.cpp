@@ -24,71 +24,138 @@
 #include "xftp_connection.h"
 
 ////////////////////////////////////////////////////////////////////////////////
-// x_ftp_channel_t
+// x_ftp_decoder_t
+
+//====================================================================
+
+// 
+// x_ftp_decoder_t : constructor/destructor
+// 
+
+x_ftp_decoder_t::x_ftp_decoder_t(void)
+    : m_xut_flen(0)
+{
+
+}
+
+x_ftp_decoder_t::~x_ftp_decoder_t(void)
+{
+
+}
 
 //====================================================================
 
 // 
-// x_ftp_channel_t : common invoking
+// x_ftp_decoder_t : overrides
 // 
 
 /**********************************************************/
 /**
- * @brief IO 消息的分割处理接口（分包操作接口）。
+ * @brief 从未成帧的接收数据中，查找首个完整的帧。
  * 
- * @param [in,out] xio_message : 入参，待分割的 IO 消息对象；
- *                               回参，分割后剩余的部分（半包，也有可能为空）。
- * @param [out   ] xlst_iomsg  : 存储分割出来的多个完整 IO 消息对象。
+ * @param [in ] xct_dptr : 未成帧的接收数据。
+ * @param [in ] xut_dlen : 未成帧的接收数据长度。
+ * @param [out] xut_fpos : 帧的起始位置（返回 EDEC_RESULT_NEED 时，为可丢弃的无效数据长度）。
+ * @param [out] xut_flen : 帧的长度。
  * 
- * @return x_uint32_t
- *         - 返回分割到的 IO 消息数量。
+ * @return x_int32_t
+ *         - 返回 解码结果（参看 emDecodeResult 枚举值）。
  */
-x_uint32_t x_ftp_channel_t::xmsg_split(x_tcp_io_message_t & xio_message,
-                                       std::list< x_tcp_io_message_t > & xlst_iomsg)
+x_int32_t x_ftp_decoder_t::decode(const x_uchar_t * xct_dptr,
+                                  x_uint32_t xut_dlen,
+                                  x_uint32_t & xut_fpos,
+                                  x_uint32_t & xut_flen)
 {
-    x_uint32_t  xut_count = 0;
-
-    x_uchar_t * xct_dptr = xio_message.data();
-    x_uint32_t  xut_dlen = xio_message.rlen();
-    x_int32_t   xit_vpos = -1;
-    x_int32_t   xit_vlen = 0;
+    x_int32_t         xit_ecode  = IOCTX_ERR_UNKNOW;
+    x_bool_t          xbt_ldcode = X_FALSE;
+    const x_uchar_t * xct_iter   = xct_dptr;
+    const x_uchar_t * xct_eptr   = xct_dptr + xut_dlen;
 
     x_io_msgctxt_t xio_msgctxt;
 
-    if ((X_NULL == xct_dptr) || (xut_dlen <= 0))
-    {
-        return 0;
-    }
+    xut_fpos = 0;
+    xut_flen = 0;
+
+    //======================================
+    // 首部半包的数据仍未达到完整的帧长度，无需重复扫描
 
-    while (-1 != (xit_vpos = io_find_context(xct_dptr, xut_dlen, &xio_msgctxt)))
+    if ((m_xut_flen > 0) && (xut_dlen < m_xut_flen))
     {
-        xlst_iomsg.push_back(
-            std::forward< x_tcp_io_message_t >(
-                x_tcp_io_message_t(xct_dptr + xit_vpos, IO_HDSIZE + xio_msgctxt.io_size)));
-        xut_count += 1;
-
-        xit_vlen  = xit_vpos + IO_HDSIZE + xio_msgctxt.io_size;
-        xct_dptr += xit_vlen;
-        xut_dlen -= xit_vlen;
+        return EDEC_RESULT_NEED;
     }
 
-    if (xio_message.rlen() != xut_dlen)
+    m_xut_flen = 0;
+
+    //======================================
+    // 以 前导码 逐个定位消息头部
+
+    while ((xct_eptr - xct_iter) >= (x_int32_t)IO_LEAD_SIZE)
     {
-        if ((X_NULL != xct_dptr) && (xut_dlen > 0))
+        xct_iter = (const x_uchar_t *)memchr(xct_iter, 0xEF, (xct_eptr - xct_iter) - IO_LEAD_SIZE + 1);
+        if (X_NULL == xct_iter)
         {
-            // 将剩余的半包消息返还回去
-            xio_message = std::move(x_tcp_io_message_t(xct_dptr, xut_dlen));
+            xct_iter = xct_eptr - IO_LEAD_SIZE + 1;
+            break;
         }
-        else
+
+        if (0xFE != xct_iter[1])
         {
-            // 清空
-            xio_message = x_tcp_io_message_t();
+            xct_iter += 1;
+            continue;
         }
+
+        xbt_ldcode = X_TRUE;
+        xit_ecode  = io_get_context(xct_iter, (x_uint32_t)(xct_eptr - xct_iter), &xio_msgctxt);
+        if (IOCTX_ERR_OK == xit_ecode)
+        {
+            xut_fpos = (x_uint32_t)(xct_iter - xct_dptr);
+            xut_flen = IO_HDSIZE + xio_msgctxt.io_size;
+            return EDEC_RESULT_FRAME;
+        }
+
+        if (IOCTX_ERR_PART == xit_ecode)
+        {
+            // 丢弃前导码之前的无效数据，若已接收完整的消息头部，则记录完整的帧长度
+            xut_fpos = (x_uint32_t)(xct_iter - xct_dptr);
+            if ((xct_eptr - xct_iter) >= (x_int32_t)IO_HDSIZE)
+            {
+                m_xut_flen = IO_HDSIZE + vx_ntohs(((const x_io_msghead_t *)xct_iter)->io_size);
+            }
+
+            return EDEC_RESULT_NEED;
+        }
+
+        // 结构错误 或 校验和错误，则从下一字节继续查找
+        xct_iter += 1;
     }
 
-    return xut_count;
+    //======================================
+    // 未找到可用的消息头部，
+    // 若整段数据（不少于消息头部长度）中无 前导码，则可判断为 非法操作
+
+    if (!xbt_ldcode && (xut_dlen >= IO_HDSIZE))
+    {
+        return EDEC_RESULT_ERROR;
+    }
+
+    // 丢弃已扫描的数据，仅保留末尾可能构成前导码的字节
+    xut_fpos = (x_uint32_t)(xct_iter - xct_dptr);
+
+    return EDEC_RESULT_NEED;
 }
 
+/**********************************************************/
+/**
+ * @brief 重置解码状态。
+ */
+x_void_t x_ftp_decoder_t::reset(void)
+{
+    m_xut_flen = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// x_ftp_channel_t
+
 //====================================================================
 
 // 
@@ -98,7 +165,7 @@ x_uint32_t x_ftp_channel_t::xmsg_split(x_tcp_io_message_t & xio_message,
 x_ftp_channel_t::x_ftp_channel_t(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd)
     : x_tcp_io_channel_t(xht_manager, xfdt_sockfd)
 {
-
+    set_io_decoder(&m_xftp_decoder);
 }
 
 x_ftp_channel_t::~x_ftp_channel_t(void)
@@ -114,68 +181,17 @@ x_ftp_channel_t::~x_ftp_channel_t(void)
 
 /**********************************************************/
 /**
- * @brief 投递请求操作的 IO 消息。
- * 
- * @param [in,out] xio_message : 投递的 IO 消息。
- * 
- * @return x_int32_t
- *         - 返回值 >= 0，表示操作产生的事件数量。
- *         - 返回值 <  0，表示产生错误，后续则可关闭该业务层工作对象。
+ * @brief 判断请求操作的 IO 消息是否为紧急消息（依据 IO 消息的命令 ID，参看 is_urgent_cmid()）。
  */
-x_int32_t x_ftp_channel_t::post_req_xmsg(x_tcp_io_message_t & xio_message)
+x_bool_t x_ftp_channel_t::is_urgent_xmsg(const x_tcp_io_message_t & xio_message) const
 {
-    x_int32_t xit_count = 0;
-    std::list< x_tcp_io_message_t > xlst_iomsg;
-
-    //======================================
-
-    if (xio_message.rlen() < IO_HDSIZE)
-    {
-        return 0;
-    }
-
-    // 若整个 IO 消息数据包中无 前导码，则可判断为 非法操作
-    if (-1 == io_find_ldcode(xio_message.data(), xio_message.rlen()))
-    {
-        LOGE("[fd:%d]io_find_ldcode(xio_message.data(), xio_message.rlen()[%d]) return -1!",
-                get_sockfd(), xio_message.rlen());
-        return -1;
-    }
-
-    //======================================
-    // 分包操作
-
-    xit_count = xmsg_split(xio_message, xlst_iomsg);
-    if (xit_count <= 0)
-    {
-        // 若 IO 消息总长度达到上限值（64KB），
-        // 仍未能分包，则判断为 非法数据包
-        if (xio_message.rlen() >= 0xFFFF)
-        {
-            LOGE("[fd:%d]xio_message.rlen()[%d] >= 0xFFFF",
-                 get_sockfd(), xio_message.rlen());
-            return -1;
-        }
-        else
-        {
-            return 0;
-        }
-    }
-
-    //======================================
-    // 加入到请求操作的 IO 消息队列
-
-    x_mqautolock_t xautolock(m_xmqueue_req);
-    for (std::list< x_tcp_io_message_t >::iterator itlst = xlst_iomsg.begin();
-            itlst != xlst_iomsg.end();
-            ++itlst)
+    x_io_msgctxt_t xio_msgctxt;
+    if (IOCTX_ERR_OK != io_context_rinfo(xio_message.data(), xio_message.rlen(), &xio_msgctxt))
     {
-        m_xmqueue_req.push(std::move(*itlst));
+        return X_FALSE;
     }
 
-    //======================================
-
-    return xit_count;
+    return is_urgent_cmid(xio_msgctxt.io_cmid);
 }
 
 //====================================================================
@@ -215,3 +231,48 @@ x_int32_t x_ftp_channel_t::post_res_xmsg(const x_io_msgctxt_t & xio_msgctxt)
     return 0;
 }
 
+/**********************************************************/
+/**
+ * @brief 投递应答操作的 IO 消息（数据体为独立的 IO 消息对象，以数据体分段的方式链接，不拷贝数据）。
+ * 
+ * @param [in ] xut_seqn  : IO 应答消息的标识号。
+ * @param [in ] xut_cmid  : IO 应答消息的命令ID。
+ * @param [in ] xmsg_body : 数据体的 IO 消息对象（数据长度不可超过 0x0000FFFF）。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 0；
+ *         - 失败，返回 错误码。
+ */
+x_int32_t x_ftp_channel_t::post_res_xmsg(x_uint16_t xut_seqn, x_uint16_t xut_cmid, const x_tcp_io_message_t & xmsg_body)
+{
+    if (xmsg_body.rlen() > 0x0000FFFF)
+    {
+        LOGE("xmsg_body.rlen()[%d] > 0x0000FFFF", xmsg_body.rlen());
+        return -1;
+    }
+
+    x_io_msgctxt_t xio_msgctxt;
+    xio_msgctxt.io_seqn = xut_seqn;
+    xio_msgctxt.io_cmid = xut_cmid;
+    xio_msgctxt.io_size = xmsg_body.rlen();
+    xio_msgctxt.io_dptr = (x_uchar_t *)xmsg_body.data();
+
+    // 数据头部存放于 IO 消息对象的内嵌缓存中，数据体则共享 xmsg_body 的数据块
+    x_tcp_io_message_t xio_message(IO_HDSIZE);
+    if (IOCTX_ERR_OK != io_set_header(xio_message.data(), xio_message.capacity(), &xio_msgctxt))
+    {
+        return -1;
+    }
+
+    xio_message.reset(IO_HDSIZE, 0);
+
+    if (!xio_message.set_body(xmsg_body))
+    {
+        return -1;
+    }
+
+    push_res_xmsg(std::move(xio_message));
+
+    return 0;
+}
+
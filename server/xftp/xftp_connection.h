@@ -25,33 +25,54 @@
 
 #include "xtcp_io_channel.h"
 #include "xftp_msgctxt.h"
-#include <list>
+#include "xobjectpool.h"
 
 ////////////////////////////////////////////////////////////////////////////////
-// x_ftp_channel_t
+// x_ftp_decoder_t
 
 /**
- * @class x_ftp_channel_t
- * @brief 业务层连接对象的基类（定义 IO 消息分包规则）。
+ * @class x_ftp_decoder_t
+ * @brief xftp 的 IO 消息分帧解码器（以 前导码 定位消息头部，由消息头部的 数据体长度 确定帧的长度）。
+ * @note  已解析出消息头部的半包，会记录其完整的帧长度，后续数据未达到该长度前，不再重复扫描与解析。
  */
-class x_ftp_channel_t : public x_tcp_io_channel_t
+class x_ftp_decoder_t : public x_tcp_io_decoder_t
 {
-    // common invoking
+    // constructor/destructor
+public:
+    x_ftp_decoder_t(void);
+    virtual ~x_ftp_decoder_t(void);
+
+    // overrides
 public:
     /**********************************************************/
     /**
-     * @brief IO 消息的分割处理接口（分包操作接口）。
-     * 
-     * @param [in,out] xio_message : 入参，待分割的 IO 消息对象；
-     *                               回参，分割后剩余的部分（半包，也有可能为空）。
-     * @param [out   ] xlst_iomsg  : 存储分割出来的多个完整 IO 消息对象。
-     * 
-     * @return x_uint32_t
-     *         - 返回分割到的 IO 消息数量。
+     * @brief 从未成帧的接收数据中，查找首个完整的帧。
+     */
+    virtual x_int32_t decode(const x_uchar_t * xct_dptr,
+                             x_uint32_t xut_dlen,
+                             x_uint32_t & xut_fpos,
+                             x_uint32_t & xut_flen) override;
+
+    /**********************************************************/
+    /**
+     * @brief 重置解码状态。
      */
-    static x_uint32_t xmsg_split(x_tcp_io_message_t & xio_message,
-                                 std::list< x_tcp_io_message_t > & xlst_iomsg);
+    virtual x_void_t reset(void) override;
 
+    // data members
+protected:
+    x_uint32_t   m_xut_flen;   ///< 首部半包的完整帧长度（为 0 时，表示未知）
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// x_ftp_channel_t
+
+/**
+ * @class x_ftp_channel_t
+ * @brief 业务层连接对象的基类（定义 IO 消息分包规则）。
+ */
+class x_ftp_channel_t : public x_tcp_io_channel_t
+{
     // constructor/destructor
 protected:
     explicit x_ftp_channel_t(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd);
@@ -61,15 +82,9 @@ protected:
 protected:
     /**********************************************************/
     /**
-     * @brief 投递请求操作的 IO 消息。
-     * 
-     * @param [in,out] xio_message : 投递的 IO 消息。
-     * 
-     * @return x_int32_t
-     *         - 返回值 >= 0，表示操作产生的事件数量。
-     *         - 返回值 <  0，表示产生错误，后续则可关闭该业务层工作对象。
+     * @brief 判断请求操作的 IO 消息是否为紧急消息（依据 IO 消息的命令 ID，参看 is_urgent_cmid()）。
      */
-    virtual x_int32_t post_req_xmsg(x_tcp_io_message_t & xio_message);
+    virtual x_bool_t is_urgent_xmsg(const x_tcp_io_message_t & xio_message) const override;
 
     // extensible interfaces
 public:
@@ -79,6 +94,15 @@ public:
      */
     virtual x_uint16_t ctype(void) const = 0;
 
+    /**********************************************************/
+    /**
+     * @brief 判断 IO 消息的命令 ID 是否属于紧急消息（默认仅 登录命令，其命令 ID 与 连接类型 相同）。
+     */
+    virtual x_bool_t is_urgent_cmid(x_uint16_t xut_cmid) const
+    {
+        return (xut_cmid == ctype());
+    }
+
     // public interfaces
 public:
     /**********************************************************/
@@ -93,6 +117,23 @@ public:
      */
     x_int32_t post_res_xmsg(const x_io_msgctxt_t & xio_msgctxt);
 
+    /**********************************************************/
+    /**
+     * @brief 投递应答操作的 IO 消息（数据体为独立的 IO 消息对象，以数据体分段的方式链接，不拷贝数据）。
+     * 
+     * @param [in ] xut_seqn  : IO 应答消息的标识号。
+     * @param [in ] xut_cmid  : IO 应答消息的命令ID。
+     * @param [in ] xmsg_body : 数据体的 IO 消息对象（数据长度不可超过 0x0000FFFF）。
+     * 
+     * @return x_int32_t
+     *         - 成功，返回 0；
+     *         - 失败，返回 错误码。
+     */
+    x_int32_t post_res_xmsg(x_uint16_t xut_seqn, x_uint16_t xut_cmid, const x_tcp_io_message_t & xmsg_body);
+
+    // data members
+private:
+    x_ftp_decoder_t   m_xftp_decoder;   ///< IO 请求消息的分帧解码器
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -119,18 +160,72 @@ public:
         ECV_CONNECTION_TYPE  = _Xt,  ///< 业务层工作对象的连接类型
     } emConnectionType;
 
+    /**
+     * @enum  emConstValue
+     * @brief 相关的枚举常量值。
+     */
+    typedef enum emConstValue
+    {
+        ECV_CBLOCK_EXTRA     = 64,   ///< 对象池内存块中，为 std::allocate_shared() 的引用计数控制块预留的大小
+    } emConstValue;
+
     using x_type_t  = _Ty;
     using x_super_t = x_ftp_connection_t< _Ty, _Xt >;
 
+private:
+    using x_io_csptr_t = std::shared_ptr< x_tcp_io_channel_t >;
+
+    /**
+     * @class x_cballoc_t< _Uy >
+     * @brief 业务层工作对象（连同其引用计数控制块）的对象池分配器。
+     * @note  作为 x_super_t 的嵌套类，可访问 _Ty 私有的 构造/析构 函数。
+     */
+    template< typename _Uy >
+    class x_cballoc_t : public x_objectpool_allocator_t< _Uy, x_objectpool_block_t< _Ty, ECV_CBLOCK_EXTRA > >
+    {
+    public:
+        template< typename _Vy >
+        struct rebind
+        {
+            using other = x_cballoc_t< _Vy >;
+        };
+
+        x_cballoc_t(void)
+        {
+
+        }
+
+        template< typename _Vy >
+        x_cballoc_t(const x_cballoc_t< _Vy > & xobject)
+        {
+
+        }
+
+        template< typename _Vy, typename... _Args >
+        void construct(_Vy * xobj_ptr, _Args && ... xargs)
+        {
+            ::new ((void *)xobj_ptr) _Vy(std::forward< _Args >(xargs)...);
+        }
+
+        template< typename _Vy >
+        void destroy(_Vy * xobj_ptr)
+        {
+            xobj_ptr->~_Vy();
+        }
+    };
+
     // common invoking
 public:
     /**********************************************************/
     /**
-     * @brief x_ftp_echo_t 对象创建接口。
+     * @brief 业务层工作对象的创建接口。
+     * @note  xht_csptr 有效时，以 std::allocate_shared() 在对象池的内存块中，
+     *        将 工作对象 与其 引用计数控制块 一同分配（参看 reserve_objpool()）。
      * 
      * @param [in ] xht_manager : 业务层工作对象所隶属的 IO 管理模块句柄。
      * @param [in ] xfdt_sockfd : 业务层工作对象的 套接字描述符。
      * @param [in ] xht_msgctxt : 指向创建业务层工作对象的 IO 请求消息（首个 IO 消息）。
+     * @param [out] xht_csptr   : 指向接收 x_tcp_io_channel_t 对象的 std::shared_ptr 对象（可为 X_NULL）。
      * @param [out] xht_channel : 操作成功所返回的 x_tcp_io_channel_t 对象句柄。
      * 
      * @return x_int32_t
@@ -140,15 +235,46 @@ public:
     static x_int32_t create(x_handle_t xht_manager,
                             x_sockfd_t xfdt_sockfd,
                             x_handle_t xht_msgctxt,
+                            x_handle_t xht_csptr,
                             x_handle_t & xht_channel)
     {
-        x_type_t * xthis_ptr = new x_type_t(xht_manager, xfdt_sockfd);
-        xht_channel = (x_handle_t)(xthis_ptr);
+        if (X_NULL == xht_csptr)
+        {
+            xht_channel = (x_handle_t)static_cast< x_tcp_io_channel_t * >(
+                                new x_type_t(xht_manager, xfdt_sockfd));
+        }
+        else
+        {
+            x_io_csptr_t & xio_csptr = *(x_io_csptr_t *)xht_csptr;
+            xio_csptr = std::allocate_shared< x_type_t >(x_cballoc_t< x_type_t >(), xht_manager, xfdt_sockfd);
+            xht_channel = (x_handle_t)xio_csptr.get();
+        }
+
         XASSERT(X_NULL != xht_channel);
 
         return 0;
     }
 
+    /**********************************************************/
+    /**
+     * @brief 预分配业务层工作对象（连同其引用计数控制块）的对象池内存块。
+     * 
+     * @param [in ] xut_count : 预分配数量。
+     */
+    static x_void_t reserve_objpool(x_uint32_t xut_count)
+    {
+        x_cballoc_t< x_type_t >::blockpool().reserve(xut_count);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 释放对象池中缓存的内存块（不可与 create() 并发执行）。
+     */
+    static x_void_t release_objpool(void)
+    {
+        x_cballoc_t< x_type_t >::blockpool().free_extra();
+    }
+
     // constructor/destructor
 protected:
     explicit x_ftp_connection_t(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd)
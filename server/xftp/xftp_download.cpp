@@ -35,9 +35,10 @@
 
 x_ftp_download_t::x_ftp_download_t(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd)
     : x_super_t(xht_manager, xfdt_sockfd)
-    , m_xstr_fname("")
-    , m_xstr_fpath("")
+    , m_xstr_fname(arena_alloc())
+    , m_xstr_fpath(arena_alloc())
     , m_xit_fsize(0)
+    , m_xct_fsbuf(X_NULL)
     , m_xit_offset_beg(0)
     , m_xit_offset_cur(0)
     , m_xit_chunk_size(0)
@@ -136,9 +137,34 @@ x_int32_t x_ftp_download_t::io_event_destroyed(void)
         m_xio_fstream.close();
     }
 
+    // 内存区域随后在 cleanup() 中释放，先归还字符串的内存，读缓存则不再被（已关闭的）文件流对象访问
+    x_arena_string_t(arena_alloc()).swap(m_xstr_fname);
+    x_arena_string_t(arena_alloc()).swap(m_xstr_fpath);
+    m_xct_fsbuf = X_NULL;
+
     return 0;
 }
 
+/**********************************************************/
+/**
+ * @brief 判断 IO 消息的命令 ID 是否属于紧急消息（登录、心跳、暂停下载）。
+ */
+x_bool_t x_ftp_download_t::is_urgent_cmid(x_uint16_t xut_cmid) const
+{
+    switch (xut_cmid)
+    {
+    case CMID_DLOAD_LOGIN :
+    case CMID_DLOAD_HBEAT :
+    case CMID_DLOAD_PAUSE :
+        return X_TRUE;
+
+    default:
+        break;
+    }
+
+    return X_FALSE;
+}
+
 //====================================================================
 
 // 
@@ -196,10 +222,11 @@ x_int32_t x_ftp_download_t::post_res_chunk(x_uint16_t xut_seqn, x_int64_t xit_of
 
         //======================================
         // 设置数据体信息[ 块偏移 8bytes + 块大小 4bytes + 块数据 xut_rdsize ]
+        // （数据体独立存放，投递时以数据体分段的方式链接于数据头部之后）
 
-        x_tcp_io_message_t xio_message(IO_HDSIZE + sizeof(x_int64_t) + sizeof(x_uint32_t) + xut_rdsize);
+        x_tcp_io_message_t xmsg_body(sizeof(x_int64_t) + sizeof(x_uint32_t) + xut_rdsize);
 
-        x_uchar_t * xct_dptr = xio_message.data() + IO_HDSIZE;
+        x_uchar_t * xct_dptr = xmsg_body.data();
 
         // 文件块偏移位置
         *(x_int64_t *)(xct_dptr) = (x_int64_t)vx_htonll((x_ullong_t)xit_offset);
@@ -216,16 +243,9 @@ x_int32_t x_ftp_download_t::post_res_chunk(x_uint16_t xut_seqn, x_int64_t xit_of
         //======================================
         // 设置应答消息的头部信息后，加入到消息应答队列
 
-        x_io_msgctxt_t xio_msgctxt;
-        xio_msgctxt.io_seqn = xut_seqn;
-        xio_msgctxt.io_cmid = CMID_DLOAD_CHUNK;
-        xio_msgctxt.io_size = sizeof(x_int64_t) + sizeof(x_uint32_t) + xut_rdsize;
-        xio_msgctxt.io_dptr = X_NULL; // 设置为 X_NULL 的时候，则不进行数据拷贝操作
+        xmsg_body.reset(sizeof(x_int64_t) + sizeof(x_uint32_t) + xut_rdsize, 0);
 
-        XVERIFY(IOCTX_ERR_OK == io_set_context(xio_message.data(), xio_message.capacity(), &xio_msgctxt));
-        xio_message.reset(IO_HDSIZE + xio_msgctxt.io_size, 0);
-
-        push_res_xmsg(std::move(xio_message));
+        XVERIFY(0 == post_res_xmsg(xut_seqn, CMID_DLOAD_CHUNK, xmsg_body));
 
         //======================================
         xit_error = 0;
@@ -277,9 +297,10 @@ x_int32_t x_ftp_download_t::iocmd_login(x_uint16_t xut_seqn, x_uchar_t * xct_dpt
         //======================================
         // 读取文件基本信息
 
-        m_xstr_fname = std::move(std::string((x_char_t *)xct_dptr, xut_size));
+        m_xstr_fname.assign((x_char_t *)xct_dptr, xut_size);
 
-        xit_error = x_ftp_server_t::instance().file_info(m_xstr_fname.c_str(), m_xstr_fpath, m_xit_fsize);
+        x_char_t xszt_fpath[TEXT_LEN_1K] = { '\0' };
+        xit_error = x_ftp_server_t::instance().file_info(m_xstr_fname.c_str(), xszt_fpath, TEXT_LEN_1K, m_xit_fsize);
         if (0 != xit_error)
         {
             LOGE("[fd:%d]x_ftp_server_t::file_info(m_xstr_fname.c_str()[%s], ...) return error : %d",
@@ -287,8 +308,22 @@ x_int32_t x_ftp_download_t::iocmd_login(x_uint16_t xut_seqn, x_uchar_t * xct_dpt
             break;
         }
 
+        m_xstr_fpath.assign(xszt_fpath);
+
         //======================================
-        // （只读方式）打开文件流操作句柄
+        // （只读方式）打开文件流操作句柄，其读缓存从内存区域分配（须在打开文件前设置）
+
+        if (m_xio_fstream.is_open())
+        {
+            m_xio_fstream.close();
+        }
+
+        if (X_NULL == m_xct_fsbuf)
+        {
+            m_xct_fsbuf = (x_char_t *)io_arena().alloc(ECV_FSTREAM_BUFSZ);
+            if (X_NULL != m_xct_fsbuf)
+                m_xio_fstream.rdbuf()->pubsetbuf(m_xct_fsbuf, ECV_FSTREAM_BUFSZ);
+        }
 
         m_xio_fstream.open(m_xstr_fpath.c_str(), std::ios::in | std::ios::binary);
         if (!m_xio_fstream.is_open())
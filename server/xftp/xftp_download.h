@@ -47,6 +47,7 @@ public:
     {
         ECV_MAX_CHUNK_SIZE = 60 * 1024,  ///< IO 操作的文件块最大长度
         ECV_SUG_CHUNK_SIZE = 32 * 1024,  ///< 建议的 IO 操作文件块长度
+        ECV_FSTREAM_BUFSZ  = 4 * 1024,   ///< 文件流对象的读缓存大小（从 IO 通道对象的内存区域分配）
     } emConstValue;
 
     /**
@@ -104,6 +105,12 @@ protected:
      */
     virtual x_int32_t io_event_destroyed(void);
 
+    /**********************************************************/
+    /**
+     * @brief 判断 IO 消息的命令 ID 是否属于紧急消息（登录、心跳、暂停下载）。
+     */
+    virtual x_bool_t is_urgent_cmid(x_uint16_t xut_cmid) const override;
+
     // internal invoking
 protected:
     /**********************************************************/
@@ -162,11 +169,12 @@ protected:
 
     // data members
 private:
-    std::string   m_xstr_fname;     ///< 请求下载的文件名
-    std::string   m_xstr_fpath;     ///< 请求下载的文件全路径名
+    x_arena_string_t m_xstr_fname;  ///< 请求下载的文件名（从 IO 通道对象的内存区域分配）
+    x_arena_string_t m_xstr_fpath;  ///< 请求下载的文件全路径名（从 IO 通道对象的内存区域分配）
     x_int64_t     m_xit_fsize;      ///< 文件总大小
 
     std::ifstream m_xio_fstream;    ///< 文件数据读取操作的文件流对象
+    x_char_t    * m_xct_fsbuf;      ///< 文件流对象的读缓存（从 IO 通道对象的内存区域分配）
     x_int64_t     m_xit_offset_beg; ///< 记录当前请求文件块的起始偏移位置
     x_int64_t     m_xit_offset_cur; ///< 记录当前请求文件块的读取偏移位置
     x_int64_t     m_xit_chunk_size; ///< 记录当前请求文件块的大小
@@ -34,6 +34,7 @@
 
 x_ftp_echo_t::x_ftp_echo_t(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd)
     : x_super_t(xht_manager, xfdt_sockfd)
+    , m_xstr_name(arena_alloc())
 {
 
 }
@@ -89,9 +90,21 @@ x_int32_t x_ftp_echo_t::io_event_responsed(x_tcp_io_message_t & xio_message)
  */
 x_int32_t x_ftp_echo_t::io_event_destroyed(void)
 {
+    // 内存区域随后在 cleanup() 中释放，先归还字符串的内存
+    x_arena_string_t(arena_alloc()).swap(m_xstr_name);
+
     return 0;
 }
 
+/**********************************************************/
+/**
+ * @brief 判断 IO 消息的命令 ID 是否属于紧急消息（登录、心跳）。
+ */
+x_bool_t x_ftp_echo_t::is_urgent_cmid(x_uint16_t xut_cmid) const
+{
+    return ((CMID_ECHO_LOGIN == xut_cmid) || (CMID_ECHO_HBEAT == xut_cmid));
+}
+
 //====================================================================
 
 // 
@@ -105,9 +118,9 @@ x_int32_t x_ftp_echo_t::io_event_destroyed(void)
 x_int32_t x_ftp_echo_t::iocmd_login(x_uint16_t xut_seqn, x_uchar_t * xct_dptr, x_uint32_t xut_size)
 {
     if (xut_size > 0)
-        m_xstr_name = std::move(std::string((x_char_t *)xct_dptr, xut_size));
+        m_xstr_name.assign((x_char_t *)xct_dptr, xut_size);
     else
-        m_xstr_name = "{unknow}";
+        m_xstr_name.assign("{unknow}");
 
     x_io_msgctxt_t xio_msgctxt;
     xio_msgctxt.io_seqn = xut_seqn;
@@ -75,6 +75,12 @@ protected:
      */
     virtual x_int32_t io_event_destroyed(void);
 
+    /**********************************************************/
+    /**
+     * @brief 判断 IO 消息的命令 ID 是否属于紧急消息（登录、心跳）。
+     */
+    virtual x_bool_t is_urgent_cmid(x_uint16_t xut_cmid) const override;
+
     // internal invoking
 protected:
     /**********************************************************/
@@ -97,7 +103,7 @@ protected:
 
     // data members
 private:
-    std::string   m_xstr_name;  ///< 建立连接的标识名称
+    x_arena_string_t m_xstr_name;  ///< 建立连接的标识名称（从 IO 通道对象的内存区域分配）
 };
 
 ////////////////////////////////////////////////////////////////////////////////
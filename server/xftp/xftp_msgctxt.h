@@ -221,6 +221,21 @@ x_int32_t io_context_rinfo(const x_uchar_t * xct_io_dptr, x_uint32_t xut_io_dlen
  */
 x_int32_t io_context_winfo(x_uchar_t * xct_io_dptr, x_uint32_t xut_io_dlen, const x_io_msgctxt_t * xio_ctx_ptr);
 
+/**********************************************************/
+/**
+ * @brief 对网络 IO 消息的头部缓存，写入 IO 消息上下文描述信息（数据体独立存放，仅参与校验和运算，不进行数据拷贝）。
+ * @note  用于 数据头部 与 数据体 分段存放的 IO 消息（参看 x_tcp_io_message_t::set_body()）。
+ * 
+ * @param [out] xct_io_dptr : 网络 IO 消息的头部缓存。
+ * @param [in ] xut_io_dlen : 网络 IO 消息的头部缓存长度（不小于 IO_HDSIZE）。
+ * @param [in ] xio_ctx_ptr : 写入的 IO 消息上下文描述信息（io_dptr 指向独立存放的数据体）。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 IOCTX_ERR_OK；
+ *         - 失败，返回 错误码。
+ */
+x_int32_t io_set_header(x_uchar_t * xct_io_dptr, x_uint32_t xut_io_dlen, const x_io_msgctxt_t * xio_ctx_ptr);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #ifdef __cplusplus
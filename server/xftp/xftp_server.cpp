@@ -134,9 +134,15 @@ x_int32_t x_ftp_server_t::init_extra_callback(x_handle_t xht_context)
     _S_xwct_config.xut_epoll_maxsockfds = xconfig.read_int("server", "epoll_maxsockfds", 4096 );
     _S_xwct_config.xut_epoll_waitevents = xconfig.read_int("server", "epoll_waitevents", 256  );
     _S_xwct_config.xut_ioman_threads    = xconfig.read_int("server", "ioman_threads"   , 4    );
+    _S_xwct_config.xut_ioman_affinity   = xconfig.read_int("server", "ioman_affinity"  , 0    );
+    _S_xwct_config.xut_ioman_rebalance  = xconfig.read_int("server", "ioman_rebalance" , 0    );
+    _S_xwct_config.xut_ioman_thds_min   = xconfig.read_int("server", "ioman_threads_min", 1   );
+    _S_xwct_config.xut_ioman_thds_max   = xconfig.read_int("server", "ioman_threads_max", 0   );
+    _S_xwct_config.xut_ioman_tmdelay    = xconfig.read_int("server", "ioman_delay_us"  , 0    );
     _S_xwct_config.xut_tmout_kpalive    = xconfig.read_int("server", "tmout_kpalive"   , 8 * 60 * 1000);
     _S_xwct_config.xut_tmout_baleful    = xconfig.read_int("server", "tmout_baleful"   , 4 * 60 * 1000);
     _S_xwct_config.xut_tmout_mverify    = xconfig.read_int("server", "tmout_mverify"   , 4 * 60 * 1000);
+    _S_xwct_config.xut_objpool_warmup   = xconfig.read_int("server", "objpool_warmup"  , 10   );
 
     //======================================
     // 文件存储的目录
@@ -254,6 +260,13 @@ x_int32_t x_ftp_server_t::startup(void)
             break;
         }
 
+        //======================================
+        // 预分配业务层工作对象（连同其引用计数）的对象池
+
+        x_ftp_echo_t::reserve_objpool(objpool_count());
+        x_ftp_wclient_t::reserve_objpool(objpool_count());
+        x_ftp_download_t::reserve_objpool(objpool_count());
+
         //======================================
         xit_error = 0;
     } while (0);
@@ -274,6 +287,10 @@ x_void_t x_ftp_server_t::shutdown(void)
 {
     x_tcp_io_server_t::shutdown();
     m_xmap_fcreate.clear();
+
+    x_ftp_echo_t::release_objpool();
+    x_ftp_wclient_t::release_objpool();
+    x_ftp_download_t::release_objpool();
 }
 
 /**********************************************************/
@@ -505,25 +522,29 @@ x_int32_t file_path(x_cstring_t xszt_fname, std::string & xstr_fpath)
  *         - 失败，返回 错误码。
  */
 x_int32_t x_ftp_server_t::file_info(x_cstring_t xszt_fname,
-                                    std::string & xstr_fpath,
+                                    x_char_t * xszt_fpath,
+                                    x_uint32_t xut_length,
                                     x_int64_t & xit_fsize)
 {
     struct stat xstat_buf;
 
-    if ((X_NULL == xszt_fname) || ('\0' == *xszt_fname))
+    if ((X_NULL == xszt_fname) || ('\0' == *xszt_fname) || (X_NULL == xszt_fpath))
     {
         return -1;
     }
 
-    // 文件路径名
-    std::string xstr_fname;
-    xstr_fname  = _S_xszt_files_dir;
-    xstr_fname += xszt_fname;
+    // 文件路径名（直接在调用方的缓存中拼接）
+    x_int32_t xit_plen = snprintf(xszt_fpath, xut_length, "%s%s", _S_xszt_files_dir, xszt_fname);
+    if ((xit_plen < 0) || ((x_uint32_t)xit_plen >= xut_length))
+    {
+        LOGE("file path is too long : %s%s", _S_xszt_files_dir, xszt_fname);
+        return -1;
+    }
 
-    if (0 != stat(xstr_fname.c_str(), &xstat_buf))
+    if (0 != stat(xszt_fpath, &xstat_buf))
     {
-        LOGE("stat(xstr_fname.c_str()[%s], ...) errno : %d",
-             xstr_fname.c_str(), errno);
+        LOGE("stat(xszt_fpath[%s], ...) errno : %d",
+             xszt_fpath, errno);
         return -1;
     }
 
@@ -532,15 +553,14 @@ x_int32_t x_ftp_server_t::file_info(x_cstring_t xszt_fname,
         return -1;
     }
 
-    if (0 != access(xstr_fname.c_str(), R_OK | W_OK))
+    if (0 != access(xszt_fpath, R_OK | W_OK))
     {
-        LOGE("access(xstr_fname.c_str()[%s], ...) errno : %d",
-             xstr_fname.c_str(), errno);
+        LOGE("access(xszt_fpath[%s], ...) errno : %d",
+             xszt_fpath, errno);
         return -1;
     }
 
-    xstr_fpath = xstr_fname;
-    xit_fsize  = (x_int64_t)xstat_buf.st_size;
+    xit_fsize = (x_int64_t)xstat_buf.st_size;
 
     return 0;
 }
@@ -645,6 +665,7 @@ x_int32_t x_ftp_server_t::xio_event_create(x_sockfd_t xfdt_sockfd, x_handle_t xh
         xit_error = itfind->second(xcreate_args.xht_manager,
                                    xcreate_args.xfdt_sockfd,
                                    (x_handle_t)&xio_msgctxt,
+                                   xcreate_args.xht_csptr,
                                    xcreate_args.xht_channel);
         if (0 != xit_error)
         {
@@ -42,6 +42,7 @@ public:
      * @param [in ] xht_manager : 业务层工作对象所隶属的 IO 管理模块句柄。
      * @param [in ] xfdt_sockfd : 业务层工作对象的 套接字描述符。
      * @param [in ] xht_msgctxt : 指向创建业务层工作对象的 IO 请求消息（首个 IO 消息）。
+     * @param [out] xht_csptr   : 指向接收 x_tcp_io_channel_t 对象的 std::shared_ptr 对象（可为 X_NULL）。
      * @param [out] xht_vhandle : 操作成功所返回的 x_tcp_io_channel_t 对象句柄。
      * 
      * @return x_int32_t
@@ -51,6 +52,7 @@ public:
     typedef x_int32_t (* x_func_create_t)(x_handle_t xht_manager,
                                           x_sockfd_t xfdt_sockfd,
                                           x_handle_t xht_msgctxt,
+                                          x_handle_t xht_csptr,
                                           x_handle_t & xht_vhandle);
 
     /** [ 类型，创建接口函数 ] */
@@ -187,14 +189,15 @@ public:
      * @brief 获取文件全路径名与文件大小。
      * 
      * @param [in ] xszt_fname : 文件名。
-     * @param [out] xstr_fpath : 操作成功返回的文件全路径名。
+     * @param [out] xszt_fpath : 操作成功返回的文件全路径名（由调用方提供缓存，不申请堆内存）。
+     * @param [in ] xut_length : xszt_fpath 缓存的长度（全路径名超出该长度时，操作失败）。
      * @param [out] xit_fsize  : 操作成功返回的文件大小。
      * 
      * @return x_int32_t
      *         - 成功，返回 0；
      *         - 失败，返回 错误码。
      */
-    x_int32_t file_info(x_cstring_t xszt_fname, std::string & xstr_fpath, x_int64_t & xit_fsize);
+    x_int32_t file_info(x_cstring_t xszt_fname, x_char_t * xszt_fpath, x_uint32_t xut_length, x_int64_t & xit_fsize);
 
     // internal invoking
 private:
@@ -97,6 +97,15 @@ x_int32_t x_ftp_wclient_t::io_event_destroyed(void)
     return 0;
 }
 
+/**********************************************************/
+/**
+ * @brief 判断 IO 消息的命令 ID 是否属于紧急消息（登录、心跳）。
+ */
+x_bool_t x_ftp_wclient_t::is_urgent_cmid(x_uint16_t xut_cmid) const
+{
+    return ((CMID_WCLI_LOGIN == xut_cmid) || (CMID_WCLI_HBEAT == xut_cmid));
+}
+
 //====================================================================
 
 // 
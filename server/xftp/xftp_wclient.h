@@ -85,6 +85,12 @@ protected:
      */
     virtual x_int32_t io_event_destroyed(void);
 
+    /**********************************************************/
+    /**
+     * @brief 判断 IO 消息的命令 ID 是否属于紧急消息（登录、心跳）。
+     */
+    virtual x_bool_t is_urgent_cmid(x_uint16_t xut_cmid) const override;
+
     // internal invoking
 protected:
     /**********************************************************/
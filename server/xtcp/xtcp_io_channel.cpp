@@ -24,6 +24,15 @@
 #include "xtcp_io_channel.h"
 #include "xtcp_io_manager.h"
 
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <errno.h>
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+#include <linux/errqueue.h>
+#define XTCP_IO_ZCOPY_SUPPORTED 1
+#endif // defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY)
+
 ////////////////////////////////////////////////////////////////////////////////
 // x_tcp_io_channel_t
 
@@ -37,6 +46,20 @@ x_tcp_io_channel_t::x_tcp_io_channel_t(x_handle_t xht_manager, x_sockfd_t xfdt_s
     : m_xht_manager(xht_manager)
     , m_xfdt_sockfd(xfdt_sockfd)
     , m_xut_status(EIO_STATUS_READABLE | EIO_STATUS_WRITABLE)
+    , m_xio_decoder(X_NULL)
+    , m_xst_wpos(0)
+    , m_xst_req_bytes(0)
+    , m_xst_res_bytes(0)
+    , m_xbt_pollout(X_FALSE)
+    , m_xult_rbytes(0)
+    , m_xult_wbytes(0)
+    , m_xult_rframes(0)
+    , m_xult_wframes(0)
+    , m_xult_busy_ns(0)
+    , m_xlit_active(0)
+    , m_xut_zcmode(EZCOPY_UNKNOWN)
+    , m_xut_zckey(0)
+    , m_xio_arena(x_tcp_io_message_t::xmsg_mempool())
 {
 
 }
@@ -55,26 +78,77 @@ x_tcp_io_channel_t::~x_tcp_io_channel_t(void)
 /**********************************************************/
 /**
  * @brief 投递请求操作的 IO 消息。
- * @note  该接口服务于 x_tcp_io_task_t 对象，可重载该接口，实现消息分包等功能。
+ * @note  该接口服务于 x_tcp_io_task_t 对象；若已设置分帧解码器（参看 set_io_decoder()），
+ *        则由解码器进行消息分包，每个完整的帧均以视图消息的方式直接加入请求队列，
+ *        否则，整个 IO 消息作为一个请求消息投递。也可重载该接口，实现其他的投递方式。
  * 
- * @param [in,out] xio_message : 投递的 IO 消息。
+ * @param [in,out] xio_message : 投递的 IO 消息（回参为剩余的未成帧数据）。
  * 
  * @return x_int32_t
  *         - 返回值 >=  0，表示操作产生的事件数量，
- *           若重载该接口，进行消息分包操作，则产生的事件数量可能会大于 1。
+ *           进行消息分包操作时，则产生的事件数量可能会大于 1。
  *         - 返回值 == -1，表示产生错误，后续则可关闭该业务层工作对象。
  */
 x_int32_t x_tcp_io_channel_t::post_req_xmsg(x_tcp_io_message_t & xio_message)
 {
-    x_mqautolock_t xautolock(m_xmqueue_req);
-    m_xmqueue_req.push(std::move(xio_message));
-    return 1;
+    x_int32_t  xit_count = 0;
+    x_int32_t  xit_dcode = 0;
+    x_uint32_t xut_fpos  = 0;
+    x_uint32_t xut_flen  = 0;
+
+    // 以视图消息的方式投递（共享接收数据块，不拷贝数据），
+    // 读操作的 IO 消息对象则保留接收数据块，继续用于后续的读操作
+
+    if (X_NULL == m_xio_decoder)
+    {
+        if (xio_message.rlen() <= 0)
+            return 0;
+
+        push_req_xmsg(xio_message.slice(0, xio_message.rlen()));
+        xio_message.discard(xio_message.rlen());
+
+        return 1;
+    }
+
+    //======================================
+    // 分包操作：逐帧加入到请求队列，已成帧的数据随即丢弃，
+    // 剩余的半包数据保留在 xio_message 中，由解码器记录其扫描进度
+
+    while (xio_message.rlen() > 0)
+    {
+        xit_dcode = m_xio_decoder->decode(xio_message.data(), xio_message.rlen(), xut_fpos, xut_flen);
+        if (x_tcp_io_decoder_t::EDEC_RESULT_FRAME == xit_dcode)
+        {
+            XASSERT((xut_flen > 0) && ((xut_fpos + xut_flen) <= xio_message.rlen()));
+
+            push_req_xmsg(xio_message.slice(xut_fpos, xut_flen));
+            xio_message.discard(xut_fpos + xut_flen);
+            xit_count += 1;
+        }
+        else if (x_tcp_io_decoder_t::EDEC_RESULT_NEED == xit_dcode)
+        {
+            XASSERT(xut_fpos <= xio_message.rlen());
+
+            if (xut_fpos > 0)
+                xio_message.discard(xut_fpos);
+            break;
+        }
+        else
+        {
+            LOGE("[fd:%d]m_xio_decoder->decode(..., xio_message.rlen()[%d], ...) return error : %d",
+                 m_xfdt_sockfd, xio_message.rlen(), xit_dcode);
+            return -1;
+        }
+    }
+
+    return xit_count;
 }
 
 /**********************************************************/
 /**
  * @brief 拉取应答操作的 IO 消息。
  * @note  该接口服务于 x_tcp_io_task_t 对象，取到的 IO 消息，用于写操作，即应答操作。
+ *        应答队列为 单消费者 队列，该接口只能在写操作的 IO 任务对象中调用。
  * 
  * @param [out] xio_message : 操作成功返回的 IO 消息。
  * 
@@ -85,11 +159,9 @@ x_int32_t x_tcp_io_channel_t::post_req_xmsg(x_tcp_io_message_t & xio_message)
  */
 x_int32_t x_tcp_io_channel_t::pull_res_xmsg(x_tcp_io_message_t & xio_message)
 {
-    x_mqautolock_t xautolock(m_xmqueue_res);
-    if (!m_xmqueue_res.empty())
+    if (m_xmqueue_res.try_pop(xio_message))
     {
-        xio_message = std::move(m_xmqueue_res.front());
-        m_xmqueue_res.pop();
+        m_xst_res_bytes.fetch_sub(xio_message.tlen(), std::memory_order_relaxed);
         return 1;
     }
 
@@ -125,6 +197,53 @@ x_uint32_t x_tcp_io_channel_t::get_io_task_max_wlen(void) const
     return ECV_IO_TASK_MAX_WLEN;
 }
 
+/**********************************************************/
+/**
+ * @brief 消息泵单次批量投递（参看 io_event_requested_batch()）的 IO 请求消息最大数量。
+ */
+x_uint32_t x_tcp_io_channel_t::get_io_req_batch_size(void) const
+{
+    return ECV_IO_REQ_BATCH_SIZE;
+}
+
+/**********************************************************/
+/**
+ * @brief 请求队列（含紧急消息队列）的数据字节数 低水位线 与 高水位线。
+ */
+x_void_t x_tcp_io_channel_t::get_req_watermark(x_size_t & xst_lwm, x_size_t & xst_hwm) const
+{
+    xst_lwm = ECV_REQ_QUEUE_LWM;
+    xst_hwm = ECV_REQ_QUEUE_HWM;
+}
+
+/**********************************************************/
+/**
+ * @brief 应答队列的数据字节数 低水位线 与 高水位线。
+ */
+x_void_t x_tcp_io_channel_t::get_res_watermark(x_size_t & xst_lwm, x_size_t & xst_hwm) const
+{
+    xst_lwm = ECV_RES_QUEUE_LWM;
+    xst_hwm = ECV_RES_QUEUE_HWM;
+}
+
+/**********************************************************/
+/**
+ * @brief IO 应答消息以 MSG_ZEROCOPY 写入的最小长度（返回 0 时，不启用 MSG_ZEROCOPY）。
+ */
+x_uint32_t x_tcp_io_channel_t::get_io_zcopy_min_size(void) const
+{
+    return ECV_IO_ZCOPY_MIN_SIZE;
+}
+
+/**********************************************************/
+/**
+ * @brief 判断请求操作的 IO 消息是否为紧急消息（如 心跳、登录、暂停 等控制类消息）。
+ */
+x_bool_t x_tcp_io_channel_t::is_urgent_xmsg(const x_tcp_io_message_t & xio_message) const
+{
+    return X_FALSE;
+}
+
 /**********************************************************/
 /**
  * @brief 处理 “接收 IO 请求消息” 的事件。
@@ -139,6 +258,35 @@ x_int32_t x_tcp_io_channel_t::io_event_requested(x_tcp_io_message_t & xio_messag
     return 0;
 }
 
+/**********************************************************/
+/**
+ * @brief 批量处理 “接收 IO 请求消息” 的事件（消息泵一次提取到的所有 IO 请求消息，紧急消息在前）。
+ * @note  默认实现为依序调用 io_event_requested()；可重载该接口，分摊批量消息的处理开销。
+ * 
+ * @param [in,out] xmsg_vptr : IO 请求消息数组（接口返回后即被释放，可 std::move() 转移其中的消息）。
+ * @param [in    ] xut_count : IO 请求消息数量。
+ * 
+ * @return x_int32_t
+ *         - 返回 0，表示 IO 操作可持续有效；
+ *         - 返回 其他值（错误码），表示 IO 操作失效，之后将会转入等待销毁的状态。
+ */
+x_int32_t x_tcp_io_channel_t::io_event_requested_batch(x_tcp_io_message_t * xmsg_vptr, x_uint32_t xut_count)
+{
+    x_int32_t xit_error = 0;
+
+    for (x_uint32_t xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        xit_error = io_event_requested(xmsg_vptr[xut_iter]);
+        if (0 != xit_error)
+        {
+            LOGE("io_event_requested(xmsg_vptr[%d]) return error : %d", xut_iter, xit_error);
+            break;
+        }
+    }
+
+    return xit_error;
+}
+
 /**********************************************************/
 /**
  * @brief 处理 “完成 IO 应答消息” 的事件。
@@ -172,6 +320,21 @@ x_int32_t x_tcp_io_channel_t::io_event_xmsgerror(x_tcp_io_message_t & xio_messag
     return 0;
 }
 
+/**********************************************************/
+/**
+ * @brief 处理 “背压状态变更” 的事件。
+ * 
+ * @param [in ] xbt_pressed : X_TRUE，进入背压状态；X_FALSE，解除背压状态。
+ * 
+ * @return x_int32_t
+ *         - 返回 0，表示 IO 操作可持续有效；
+ *         - 返回 其他值（错误码），表示 IO 操作失效。
+ */
+x_int32_t x_tcp_io_channel_t::io_event_backpressure(x_bool_t xbt_pressed)
+{
+    return 0;
+}
+
 /**********************************************************/
 /**
  * @brief 处理 “IO 通道对象被销毁” 的事件。
@@ -188,6 +351,32 @@ x_int32_t x_tcp_io_channel_t::io_event_destroyed(void)
 // x_tcp_io_channel_t : public interfaces
 // 
 
+/**********************************************************/
+/**
+ * @brief 读取运行统计信息的快照（各统计项均为 relaxed 原子读取，不加锁，可在任意线程调用）。
+ * 
+ * @param [out] xio_cstat : 操作返回的运行统计信息。
+ */
+x_void_t x_tcp_io_channel_t::get_cstat(x_tcp_io_cstat_t & xio_cstat) const
+{
+    x_int64_t xlit_active = m_xlit_active.load(std::memory_order_relaxed);
+    x_int64_t xlit_now    = std::chrono::duration_cast< std::chrono::nanoseconds >(
+                                std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    xio_cstat.xfdt_sockfd = m_xfdt_sockfd;
+
+    xio_cstat.xult_value[EIO_CSTAT_RBYTES    ] = m_xult_rbytes .load(std::memory_order_relaxed);
+    xio_cstat.xult_value[EIO_CSTAT_WBYTES    ] = m_xult_wbytes .load(std::memory_order_relaxed);
+    xio_cstat.xult_value[EIO_CSTAT_RFRAMES   ] = m_xult_rframes.load(std::memory_order_relaxed);
+    xio_cstat.xult_value[EIO_CSTAT_WFRAMES   ] = m_xult_wframes.load(std::memory_order_relaxed);
+    xio_cstat.xult_value[EIO_CSTAT_REQ_QSIZE ] = req_queue_size();
+    xio_cstat.xult_value[EIO_CSTAT_REQ_QBYTES] = req_queue_bytes();
+    xio_cstat.xult_value[EIO_CSTAT_RES_QSIZE ] = res_queue_size();
+    xio_cstat.xult_value[EIO_CSTAT_RES_QBYTES] = res_queue_bytes();
+    xio_cstat.xult_value[EIO_CSTAT_BUSY_US   ] = m_xult_busy_ns.load(std::memory_order_relaxed) / 1000ULL;
+    xio_cstat.xult_value[EIO_CSTAT_IDLE_MS   ] =
+        ((xlit_active > 0) && (xlit_now > xlit_active)) ? (x_uint64_t)(xlit_now - xlit_active) / 1000000ULL : 0;
+}
 
 //====================================================================
 
@@ -195,13 +384,28 @@ x_int32_t x_tcp_io_channel_t::io_event_destroyed(void)
 // x_tcp_io_channel_t : internal invoking
 // 
 
+/**********************************************************/
+/**
+ * @brief 将 IO 消息加入到请求队列（由 is_urgent_xmsg() 判断其所要加入的是 紧急队列 还是 常规队列）。
+ */
+x_void_t x_tcp_io_channel_t::push_req_xmsg(x_iomsg_t && xio_message)
+{
+    x_msg_queue_t & xmqueue = is_urgent_xmsg(xio_message) ? m_xmqueue_urq : m_xmqueue_req;
+
+    m_xst_req_bytes.fetch_add(xio_message.rlen(), std::memory_order_relaxed);
+    m_xult_rframes.fetch_add(1, std::memory_order_relaxed);
+
+    x_mqautolock_t xautolock(xmqueue);
+    xmqueue.push(std::forward< x_iomsg_t >(xio_message));
+}
+
 /**********************************************************/
 /**
  * @brief 将 IO 消息加入到应答队列。
  */
 x_void_t x_tcp_io_channel_t::push_res_xmsg(x_iomsg_t && xio_message)
 {
-    x_mqautolock_t xautolock(m_xmqueue_res);
+    m_xst_res_bytes.fetch_add(xio_message.tlen(), std::memory_order_relaxed);
     m_xmqueue_res.push(std::forward< x_iomsg_t >(xio_message));
 }
 
@@ -211,7 +415,7 @@ x_void_t x_tcp_io_channel_t::push_res_xmsg(x_iomsg_t && xio_message)
  */
 x_void_t x_tcp_io_channel_t::push_res_xmsg(const x_iomsg_t & xio_message)
 {
-    x_mqautolock_t xautolock(m_xmqueue_res);
+    m_xst_res_bytes.fetch_add(xio_message.tlen(), std::memory_order_relaxed);
     m_xmqueue_res.push(xio_message);
 }
 
@@ -226,7 +430,11 @@ x_void_t x_tcp_io_channel_t::cleanup(void)
     m_xut_status  = 0;
 
     m_xmsg_reading = x_iomsg_t();
-    m_xmsg_writing = x_iomsg_t();
+    if (X_NULL != m_xio_decoder)
+        m_xio_decoder->reset();
+    m_xvec_pumping.clear();
+    m_xvec_writing.clear();
+    m_xst_wpos = 0;
 
     {
         x_mqautolock_t xautolock(m_xmqueue_req);
@@ -235,10 +443,33 @@ x_void_t x_tcp_io_channel_t::cleanup(void)
     }
 
     {
-        x_mqautolock_t xautolock(m_xmqueue_res);
-        while (!m_xmqueue_res.empty())
-            m_xmqueue_res.pop();
+        x_mqautolock_t xautolock(m_xmqueue_urq);
+        while (!m_xmqueue_urq.empty())
+            m_xmqueue_urq.pop();
     }
+
+    m_xmqueue_res.clear();
+
+    m_xst_req_bytes.store(0, std::memory_order_relaxed);
+    m_xst_res_bytes.store(0, std::memory_order_relaxed);
+
+    m_xult_rbytes .store(0, std::memory_order_relaxed);
+    m_xult_wbytes .store(0, std::memory_order_relaxed);
+    m_xult_rframes.store(0, std::memory_order_relaxed);
+    m_xult_wframes.store(0, std::memory_order_relaxed);
+    m_xult_busy_ns.store(0, std::memory_order_relaxed);
+    m_xlit_active .store(0, std::memory_order_relaxed);
+    m_xbt_pollout = X_FALSE;
+
+    {
+        x_autospin_t< > xautospin(m_xspin_zcopy);
+        m_xdeq_zcopy.clear();
+    }
+
+    m_xut_zcmode.store(EZCOPY_UNKNOWN, std::memory_order_relaxed);
+    m_xut_zckey = 0;
+
+    m_xio_arena.release();
 }
 
 //====================================================================
@@ -258,6 +489,9 @@ x_int32_t x_tcp_io_channel_t::req_xmsg_first_dump(x_iomsg_t & xio_message)
     XASSERT(m_xmsg_reading.is_empty());
     m_xmsg_reading = std::move(xio_message);
 
+    m_xult_rbytes.fetch_add(m_xmsg_reading.rlen(), std::memory_order_relaxed);
+    mark_active();
+
     return post_req_xmsg(m_xmsg_reading);
 }
 
@@ -286,6 +520,12 @@ x_int32_t x_tcp_io_channel_t::req_xmsg_reading(x_int32_t & xit_rmsgs)
         // 读取 IO 请求消息
 
         xut_count = m_xmsg_reading.nio_read(m_xfdt_sockfd, get_io_task_max_rlen(), xit_error);
+        if (xut_count > 0)
+        {
+            m_xult_rbytes.fetch_add(xut_count, std::memory_order_relaxed);
+            mark_active();
+        }
+
         if (0 != xit_error)
         {
             if (EAGAIN == xit_error)
@@ -341,38 +581,62 @@ x_int32_t x_tcp_io_channel_t::req_xmsg_pump(x_int32_t & xit_rmsgs)
 {
     x_int32_t xit_error = 0;
     x_int32_t xit_count = 0;
+    x_size_t  xst_batch = 0;
+    x_size_t  xst_bytes = 0;
 
     /* 超时的时间点 */
     std::chrono::system_clock::time_point xtm_end =
         std::chrono::system_clock::now() + std::chrono::microseconds(get_io_task_time_slice());
 
-    x_tcp_io_message_t xio_message;
-
-    for (x_int32_t xit_iter = 0; xit_iter < xit_rmsgs; ++xit_iter)
+    while (xit_count < xit_rmsgs)
     {
         //======================================
-        // 提取 IO 请求消息
+        // 批量提取 IO 请求消息（优先提取紧急消息，每个队列仅加锁一次）
 
+        xst_batch = (x_size_t)limit_upper(get_io_req_batch_size(), (x_uint32_t)(xit_rmsgs - xit_count));
+        xst_batch = limit_lower(xst_batch, 1);
+        xst_bytes = 0;
+
+        if (!m_xmqueue_urq.empty())
+        {
+            x_mqautolock_t xautolock(m_xmqueue_urq);
+            while (!m_xmqueue_urq.empty() && (m_xvec_pumping.size() < xst_batch))
+            {
+                xst_bytes += m_xmqueue_urq.front().rlen();
+                m_xvec_pumping.push_back(std::move(m_xmqueue_urq.front()));
+                m_xmqueue_urq.pop();
+            }
+        }
+
+        if (!m_xmqueue_req.empty() && (m_xvec_pumping.size() < xst_batch))
         {
             x_mqautolock_t xautolock(m_xmqueue_req);
-            if (m_xmqueue_req.empty())
+            while (!m_xmqueue_req.empty() && (m_xvec_pumping.size() < xst_batch))
             {
-                xit_error = 0;
-                break;
+                xst_bytes += m_xmqueue_req.front().rlen();
+                m_xvec_pumping.push_back(std::move(m_xmqueue_req.front()));
+                m_xmqueue_req.pop();
             }
-            xio_message = std::move(m_xmqueue_req.front());
-            m_xmqueue_req.pop();
         }
 
+        if (m_xvec_pumping.empty())
+        {
+            xit_error = 0;
+            break;
+        }
+
+        m_xst_req_bytes.fetch_sub(xst_bytes, std::memory_order_relaxed);
+
         //======================================
-        // 投递 IO 请求消息
+        // 投递 IO 请求消息（投递完成后即释放，消息数据块得以及时回收）
 
-        xit_count += 1;
+        xit_count += (x_int32_t)m_xvec_pumping.size();
 
-        xit_error = io_event_requested(xio_message);
+        xit_error = io_event_requested_batch(m_xvec_pumping.data(), (x_uint32_t)m_xvec_pumping.size());
+        m_xvec_pumping.clear();
         if (0 != xit_error)
         {
-            LOGE("io_event_requested(xio_message) return error : %d", xit_error);
+            LOGE("io_event_requested_batch(..., xut_count) return error : %d", xit_error);
             break;
         }
 
@@ -396,6 +660,8 @@ x_int32_t x_tcp_io_channel_t::req_xmsg_pump(x_int32_t & xit_rmsgs)
 /**********************************************************/
 /**
  * @brief 执行 IO 应答消息的写入流程。
+ * @note  从应答队列中一次提取多个 IO 应答消息，以 sendmsg() 聚合写入（参看 x_tcp_io_message_t::nio_writev()），
+ *        每个完成写入的 IO 应答消息，仍各自触发一次 io_event_responsed() 通知。
  * 
  * @param [in, out] xit_wmsgs : 入参，写处理 IO 应答消息操作的最大数量；回参，实际写处理的数量。
  * 
@@ -408,6 +674,8 @@ x_int32_t x_tcp_io_channel_t::res_xmsg_writing(x_int32_t & xit_wmsgs)
     x_int32_t  xit_error = 0;
     x_int32_t  xit_count = 0;
     x_uint32_t xut_bytes = 0;
+    x_uint32_t xut_wsize = 0;
+    x_size_t   xst_limit = 0;
 
     /* 可写数据的最大长度 */
     x_uint32_t xut_max_wlen = get_io_task_max_wlen();
@@ -418,27 +686,62 @@ x_int32_t x_tcp_io_channel_t::res_xmsg_writing(x_int32_t & xit_wmsgs)
 
     set_writable(X_TRUE);
 
-    for (x_int32_t xit_iter = 0; xit_iter < xit_wmsgs; ++xit_iter)
+    while (xit_count < xit_wmsgs)
     {
         //======================================
-        // 提取 IO 应答消息
+        // 提取 IO 应答消息（补足待写入的消息数组，受 消息数量 与 可写数据最大长度 的限制）
 
-        if (!m_xmsg_writing.is_writable())
+        if (m_xst_wpos >= m_xvec_writing.size())
         {
-            x_mqautolock_t xautolock(m_xmqueue_res);
-            if (m_xmqueue_res.empty())
+            m_xvec_writing.clear();
+            m_xst_wpos = 0;
+        }
+
+        xst_limit = (x_size_t)(xit_wmsgs - xit_count);
+        if (xst_limit > x_iomsg_t::ECV_WRITEV_MAX)
+            xst_limit = x_iomsg_t::ECV_WRITEV_MAX;
+
+        xut_wsize = 0;
+        for (x_size_t xst_iter = m_xst_wpos; xst_iter < m_xvec_writing.size(); ++xst_iter)
+        {
+            xut_wsize += m_xvec_writing[xst_iter].tlen() - m_xvec_writing[xst_iter].wlen();
+        }
+
+        if (((m_xvec_writing.size() - m_xst_wpos) < xst_limit) && (xut_wsize < xut_max_wlen))
+        {
+            // 应答队列为无锁的 MPSC 队列，一次批量取出（队列计数只更新一次）
+            x_size_t xst_bytes = 0;
+
+            m_xmqueue_res.drain([&](x_iomsg_t & xio_message) -> bool
             {
-                xit_error = 0;
-                break;
-            }
-            m_xmsg_writing = std::move(m_xmqueue_res.front());
-            m_xmqueue_res.pop();
+                if (((m_xvec_writing.size() - m_xst_wpos) >= xst_limit) || (xut_wsize >= xut_max_wlen))
+                    return false;
+
+                m_xvec_writing.push_back(std::move(xio_message));
+                xst_bytes += m_xvec_writing.back().tlen();
+                xut_wsize += m_xvec_writing.back().tlen() - m_xvec_writing.back().wlen();
+                return true;
+            });
+
+            m_xst_res_bytes.fetch_sub(xst_bytes, std::memory_order_relaxed);
+        }
+
+        if (m_xst_wpos >= m_xvec_writing.size())
+        {
+            xit_error = 0;
+            break;
         }
 
         //======================================
-        // 执行 IO 应答消息的写入操作
+        // 执行 IO 应答消息的（聚合）写入操作
+
+        xut_bytes = res_xmsg_sendv(xut_max_wlen, xit_error);
+        if (xut_bytes > 0)
+        {
+            m_xult_wbytes.fetch_add(xut_bytes, std::memory_order_relaxed);
+            mark_active();
+        }
 
-        xut_bytes = m_xmsg_writing.nio_write(m_xfdt_sockfd, xut_max_wlen, xit_error);
         if (0 != xit_error)
         {
             if (EAGAIN == xit_error)
@@ -448,10 +751,10 @@ x_int32_t x_tcp_io_channel_t::res_xmsg_writing(x_int32_t & xit_wmsgs)
             }
             else
             {
-                LOGE("xut_bytes[%d] = m_xmsg_writing.nio_write(m_xfdt_sockfd[%d], ...) return error : %d",
+                LOGE("xut_bytes[%d] = res_xmsg_sendv(...), m_xfdt_sockfd[%d], return error : %d",
                      xut_bytes, m_xfdt_sockfd, xit_error);
 
-                io_event_xmsgerror(m_xmsg_writing, EIO_XMSG_ETYPE_WRITING, xit_error);
+                io_event_xmsgerror(m_xvec_writing[m_xst_wpos], EIO_XMSG_ETYPE_WRITING, xit_error);
             }
 
             break;
@@ -459,23 +762,37 @@ x_int32_t x_tcp_io_channel_t::res_xmsg_writing(x_int32_t & xit_wmsgs)
 
         xut_max_wlen -= xut_bytes;
 
-        // 若 IO 应答消息，仍然处于可写入的状态，
-        // 则终止完成通知，转到下次的写事件再执行写数据操作
-        if (m_xmsg_writing.is_writable())
+        //======================================
+        // 依序执行 “完成 IO 应答消息” 的通知
+
+        while ((m_xst_wpos < m_xvec_writing.size()) && !m_xvec_writing[m_xst_wpos].is_writable())
         {
-            xit_error = 0;
-            break;
-        }
+            xit_count += 1;
+            m_xult_wframes.fetch_add(1, std::memory_order_relaxed);
 
-        //======================================
-        // 执行 “完成 IO 应答消息” 的通知
+            xit_error = io_event_responsed(m_xvec_writing[m_xst_wpos]);
 
-        xit_count += 1;
+            // 已完成通知的 IO 应答消息，即刻释放其数据缓存
+            m_xvec_writing[m_xst_wpos++] = x_iomsg_t();
+
+            if (0 != xit_error)
+            {
+                LOGE("io_event_responsed(m_xvec_writing[%d]) return error : %d",
+                     (x_int32_t)(m_xst_wpos - 1), xit_error);
+                break;
+            }
+        }
 
-        xit_error = io_event_responsed(m_xmsg_writing);
         if (0 != xit_error)
         {
-            LOGE("io_event_responsed(m_xmsg_writing) return error : %d", xit_error);
+            break;
+        }
+
+        // 若仍有 IO 应答消息处于可写入的状态（套接字发送缓存已满，或者达到可写数据的最大长度），
+        // 则终止完成通知，转到下次的写事件再执行写数据操作
+        if (m_xst_wpos < m_xvec_writing.size())
+        {
+            xit_error = 0;
             break;
         }
 
@@ -496,3 +813,341 @@ x_int32_t x_tcp_io_channel_t::res_xmsg_writing(x_int32_t & xit_wmsgs)
 
     return xit_error;
 }
+
+/**********************************************************/
+/**
+ * @brief 依据消息队列的数据字节数与水位线，更新背压状态（同时更新套接字所监听的 读就绪 事件）。
+ * @note  请求队列 或 应答队列 任一超出高水位线，即进入背压状态；两者均回落至低水位线以下，才解除背压状态。
+ * 
+ * @return x_int32_t
+ *         - 返回 0，表示操作过程中未产生错误；
+ *         - 返回 其他值，表示操作过程中产生的错误码。
+ */
+x_int32_t x_tcp_io_channel_t::update_backpressure(void)
+{
+    x_int32_t xit_error = 0;
+
+    x_size_t xst_req_lwm = 0;
+    x_size_t xst_req_hwm = 0;
+    x_size_t xst_res_lwm = 0;
+    x_size_t xst_res_hwm = 0;
+
+    get_req_watermark(xst_req_lwm, xst_req_hwm);
+    get_res_watermark(xst_res_lwm, xst_res_hwm);
+
+    x_size_t xst_req_bytes = req_queue_bytes();
+    x_size_t xst_res_bytes = res_queue_bytes();
+
+    do
+    {
+        //======================================
+        // 判断背压状态是否需要变更
+
+        {
+            x_autospin_t< > xautospin(m_xspin_pollmask);
+
+            if (!is_bpressed())
+            {
+                if ((xst_req_bytes <= xst_req_hwm) && (xst_res_bytes <= xst_res_hwm))
+                    break;
+            }
+            else
+            {
+                if ((xst_req_bytes > xst_req_lwm) || (xst_res_bytes > xst_res_lwm))
+                    break;
+            }
+
+            set_bpressed(!is_bpressed());
+
+            xit_error = ((x_tcp_io_manager_t *)m_xht_manager)->register_pollmask(
+                                m_xfdt_sockfd, !is_bpressed(), m_xbt_pollout);
+            if (0 != xit_error)
+            {
+                LOGE("[fd:%d] register_pollmask(..., xbt_pollin[%d], xbt_pollout[%d]) return error : %d",
+                     m_xfdt_sockfd, !is_bpressed(), m_xbt_pollout, xit_error);
+                break;
+            }
+        }
+
+        LOGI("[fd:%d] backpressure %s, req_bytes : %d, res_bytes : %d",
+             m_xfdt_sockfd, is_bpressed() ? "on" : "off",
+             (x_int32_t)xst_req_bytes, (x_int32_t)xst_res_bytes);
+
+        //======================================
+        // 通知背压状态变更的事件
+
+        xit_error = io_event_backpressure(is_bpressed());
+        if (0 != xit_error)
+        {
+            LOGE("[fd:%d] io_event_backpressure(%d) return error : %d",
+                 m_xfdt_sockfd, is_bpressed(), xit_error);
+            break;
+        }
+
+        //======================================
+    } while (0);
+
+    return xit_error;
+}
+
+/**********************************************************/
+/**
+ * @brief 按照当前的背压状态，更新套接字所监听的 读就绪、写就绪 事件。
+ * 
+ * @param [in ] xbt_pollout : 是否监听 写就绪 事件。
+ * 
+ * @return x_int32_t
+ *         - 成功，返回 0；
+ *         - 失败，返回 错误码。
+ */
+x_int32_t x_tcp_io_channel_t::update_pollmask(x_bool_t xbt_pollout)
+{
+    x_autospin_t< > xautospin(m_xspin_pollmask);
+
+    m_xbt_pollout = xbt_pollout;
+    return ((x_tcp_io_manager_t *)m_xht_manager)->register_pollmask(
+                    m_xfdt_sockfd, !is_bpressed(), m_xbt_pollout);
+}
+
+/**********************************************************/
+/**
+ * @brief 聚合写入 m_xvec_writing 中未完成写入的 IO 应答消息（按需以 MSG_ZEROCOPY 写入）。
+ * 
+ * @param [in ] xut_max_len : 限制操作的数据最大长度（字节数）。
+ * @param [out] xit_error   : 操作返回的错误码。
+ * 
+ * @return x_uint32_t
+ *         - 返回已写入的字节数。
+ */
+x_uint32_t x_tcp_io_channel_t::res_xmsg_sendv(x_uint32_t xut_max_len, x_int32_t & xit_error)
+{
+    x_iomsg_t * xmsg_array = &m_xvec_writing[m_xst_wpos];
+    x_uint32_t  xut_count  = (x_uint32_t)(m_xvec_writing.size() - m_xst_wpos);
+    x_uint32_t  xut_bytes  = 0;
+
+#ifdef XTCP_IO_ZCOPY_SUPPORTED
+    if (zcopy_prepare(xmsg_array, xut_count))
+    {
+        x_uint32_t xut_wlen = xmsg_array[0].wlen();
+
+        xut_bytes = x_iomsg_t::nio_writev(m_xfdt_sockfd, xmsg_array, xut_count, xut_max_len, xit_error, MSG_ZEROCOPY);
+        if (xut_bytes > 0)
+        {
+            zcopy_pending(xmsg_array, xut_count, xut_wlen, xut_bytes);
+        }
+
+        // 锁定的内存页超出限额（ENOBUFS）时，本次改以常规的拷贝方式写入
+        if (ENOBUFS != xit_error)
+        {
+            return xut_bytes;
+        }
+    }
+#endif // XTCP_IO_ZCOPY_SUPPORTED
+
+    xut_bytes = x_iomsg_t::nio_writev(m_xfdt_sockfd, xmsg_array, xut_count, xut_max_len, xit_error);
+
+    return xut_bytes;
+}
+
+/**********************************************************/
+/**
+ * @brief 判断本次聚合写入是否以 MSG_ZEROCOPY 进行（若是，则同时将内嵌缓存的数据转存至数据块）。
+ * 
+ * @param [in ] xmsg_array : 待写入的 IO 应答消息数组。
+ * @param [in ] xut_count  : 待写入的 IO 应答消息数量。
+ */
+x_bool_t x_tcp_io_channel_t::zcopy_prepare(x_iomsg_t * xmsg_array, x_uint32_t xut_count)
+{
+#ifdef XTCP_IO_ZCOPY_SUPPORTED
+    x_uint32_t xut_iter     = 0;
+    x_uint32_t xut_min_size = get_io_zcopy_min_size();
+
+    if ((0 == xut_min_size) || (EZCOPY_DISABLED == m_xut_zcmode.load(std::memory_order_relaxed)))
+    {
+        return X_FALSE;
+    }
+
+    //======================================
+    // 存在数据长度不小于阈值的 IO 应答消息，才以 MSG_ZEROCOPY 写入
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        if ((xmsg_array[xut_iter].tlen() - xmsg_array[xut_iter].wlen()) >= xut_min_size)
+        {
+            break;
+        }
+    }
+
+    if (xut_iter >= xut_count)
+    {
+        return X_FALSE;
+    }
+
+    //======================================
+    // 首次以 MSG_ZEROCOPY 写入时，为套接字开启 SO_ZEROCOPY 选项
+
+    if (EZCOPY_UNKNOWN == m_xut_zcmode.load(std::memory_order_relaxed))
+    {
+        x_int32_t xit_optval = 1;
+        if (0 != setsockopt(m_xfdt_sockfd, SOL_SOCKET, SO_ZEROCOPY, &xit_optval, sizeof(xit_optval)))
+        {
+            LOGW("[fd:%d] setsockopt(..., SO_ZEROCOPY, ...) last error : %d, fallback to copying mode.",
+                 m_xfdt_sockfd, errno);
+            m_xut_zcmode.store(EZCOPY_DISABLED, std::memory_order_relaxed);
+            return X_FALSE;
+        }
+
+        m_xut_zcmode.store(EZCOPY_ENABLED, std::memory_order_relaxed);
+    }
+
+    //======================================
+    // 内嵌缓存随 IO 消息对象移动/重置，其数据须转存至数据块，才能在内核完成通知前保持有效
+
+    for (xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        if (!xmsg_array[xut_iter].pin_dblock())
+        {
+            return X_FALSE;
+        }
+    }
+
+    return X_TRUE;
+#else // !XTCP_IO_ZCOPY_SUPPORTED
+    return X_FALSE;
+#endif // XTCP_IO_ZCOPY_SUPPORTED
+}
+
+/**********************************************************/
+/**
+ * @brief 以 MSG_ZEROCOPY 写入后，保存已写入数据的 IO 应答消息（共享数据块），等待内核的完成通知。
+ * @note  内核对每次成功（写入字节数大于 0）的 MSG_ZEROCOPY 写入调用，依次分配一个完成通知序号。
+ * 
+ * @param [in ] xmsg_array : 已写入的 IO 应答消息数组。
+ * @param [in ] xut_count  : IO 应答消息数量。
+ * @param [in ] xut_wlen   : 写入前，首个 IO 应答消息已写入的数据长度。
+ * @param [in ] xut_bytes  : 本次写入的字节数。
+ */
+x_void_t x_tcp_io_channel_t::zcopy_pending(x_iomsg_t * xmsg_array,
+                                           x_uint32_t xut_count,
+                                           x_uint32_t xut_wlen,
+                                           x_uint32_t xut_bytes)
+{
+    x_uint32_t xut_iter  = 0;
+    x_uint32_t xut_wsize = 0;
+
+    {
+        x_autospin_t< > xautospin(m_xspin_zcopy);
+
+        for (xut_iter = 0; (xut_iter < xut_count) && (xut_bytes > 0); ++xut_iter)
+        {
+            // 除首个 IO 应答消息外，其余的在本次写入前均未写入数据
+            xut_wsize = xmsg_array[xut_iter].tlen() - ((0 == xut_iter) ? xut_wlen : 0);
+            if (0 == xut_wsize)
+            {
+                continue;
+            }
+
+            m_xdeq_zcopy.push_back(x_zcopy_t{ m_xut_zckey, xmsg_array[xut_iter] });
+
+            xut_bytes -= (xut_wsize < xut_bytes) ? xut_wsize : xut_bytes;
+        }
+    }
+
+    m_xut_zckey += 1;
+}
+
+/**********************************************************/
+/**
+ * @brief 处理套接字的错误事件：读取错误队列中 MSG_ZEROCOPY 的完成通知，回收对应的 IO 应答消息。
+ * 
+ * @return x_int32_t
+ *         - 返回 0，表示仅为完成通知，套接字仍然有效；
+ *         - 返回 其他值，表示套接字产生的错误码。
+ */
+x_int32_t x_tcp_io_channel_t::zcopy_reaping(void)
+{
+    x_int32_t xit_error = 0;
+    socklen_t xlen_optl = sizeof(x_int32_t);
+
+    //======================================
+    // 套接字产生了错误，则直接返回错误码
+
+    if (0 != getsockopt(m_xfdt_sockfd, SOL_SOCKET, SO_ERROR, &xit_error, &xlen_optl))
+    {
+        return errno;
+    }
+
+    if (0 != xit_error)
+    {
+        return xit_error;
+    }
+
+#ifdef XTCP_IO_ZCOPY_SUPPORTED
+
+    //======================================
+    // 读取错误队列中的完成通知（每个通知表示 [ee_info, ee_data] 范围内的写入调用已完成）
+
+    x_uchar_t     xct_control[128];
+    struct msghdr xmsg_hdr;
+    ssize_t       xst_rlen = 0;
+
+    while (X_TRUE)
+    {
+        memset(&xmsg_hdr, 0, sizeof(struct msghdr));
+        xmsg_hdr.msg_control    = xct_control;
+        xmsg_hdr.msg_controllen = sizeof(xct_control);
+
+        xst_rlen = recvmsg(m_xfdt_sockfd, &xmsg_hdr, MSG_ERRQUEUE);
+        if (-1 == xst_rlen)
+        {
+            if (EINTR == errno)
+                continue;
+            if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+                break;
+            return errno;
+        }
+
+        for (struct cmsghdr * xcmsg_ptr = CMSG_FIRSTHDR(&xmsg_hdr);
+             X_NULL != xcmsg_ptr;
+             xcmsg_ptr = CMSG_NXTHDR(&xmsg_hdr, xcmsg_ptr))
+        {
+            if (!(((SOL_IP   == xcmsg_ptr->cmsg_level) && (IP_RECVERR   == xcmsg_ptr->cmsg_type)) ||
+                  ((SOL_IPV6 == xcmsg_ptr->cmsg_level) && (IPV6_RECVERR == xcmsg_ptr->cmsg_type))))
+            {
+                continue;
+            }
+
+            const struct sock_extended_err * xserr_ptr = (const struct sock_extended_err *)CMSG_DATA(xcmsg_ptr);
+            if ((SO_EE_ORIGIN_ZEROCOPY != xserr_ptr->ee_origin) || (0 != xserr_ptr->ee_errno))
+            {
+                continue;
+            }
+
+            // 内核实际仍以拷贝方式发送了数据（如 回环网卡），则之后不再以 MSG_ZEROCOPY 写入
+            if ((0 != (xserr_ptr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED)) &&
+                (EZCOPY_ENABLED == m_xut_zcmode.exchange(EZCOPY_DISABLED, std::memory_order_relaxed)))
+            {
+                LOGI("[fd:%d] MSG_ZEROCOPY was deferred to copying by the kernel, disable it.", m_xfdt_sockfd);
+            }
+
+            // 回收序号在 [ee_info, ee_data] 范围内的 IO 应答消息（按序号回绕的方式比较）
+            x_uint32_t xut_lower = xserr_ptr->ee_info;
+            x_uint32_t xut_upper = xserr_ptr->ee_data;
+
+            x_autospin_t< > xautospin(m_xspin_zcopy);
+            for (std::deque< x_zcopy_t >::iterator xiter = m_xdeq_zcopy.begin(); xiter != m_xdeq_zcopy.end(); )
+            {
+                if (((x_int32_t)(xiter->xut_zckey - xut_lower) >= 0) &&
+                    ((x_int32_t)(xut_upper - xiter->xut_zckey) >= 0))
+                    xiter = m_xdeq_zcopy.erase(xiter);
+                else
+                    ++xiter;
+            }
+        }
+    }
+
+#endif // XTCP_IO_ZCOPY_SUPPORTED
+
+    return 0;
+}
+
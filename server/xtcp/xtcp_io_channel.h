@@ -25,7 +25,22 @@
 
 #include "xspinlock.h"
 #include "xspsc_queue.h"
+#include "xmpsc_queue.h"
+#include "xbumparena.h"
 #include "xtcp_io_message.h"
+#include "xtcp_io_decoder.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef XTCP_IO_ZCOPY_MIN_SIZE
+#define XTCP_IO_ZCOPY_MIN_SIZE  0     ///< IO 应答消息以 MSG_ZEROCOPY 写入的最小长度（默认为 0，即 不启用）
+#endif // XTCP_IO_ZCOPY_MIN_SIZE
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -33,6 +48,37 @@ class x_tcp_io_task_t;
 class x_tcp_io_creator_t;
 class x_tcp_io_holder_t;
 
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @enum  emIoChannelCounter
+ * @brief IO 通道对象的运行统计项（x_tcp_io_cstat_t::xult_value[] 的索引）。
+ */
+typedef enum emIoChannelCounter
+{
+    EIO_CSTAT_RBYTES     = 0,   ///< 累计读取的字节数
+    EIO_CSTAT_WBYTES     = 1,   ///< 累计写入的字节数
+    EIO_CSTAT_RFRAMES    = 2,   ///< 累计加入请求队列的 IO 请求消息数量
+    EIO_CSTAT_WFRAMES    = 3,   ///< 累计完成写入的 IO 应答消息数量
+    EIO_CSTAT_REQ_QSIZE  = 4,   ///< 请求队列（含紧急消息队列）当前的消息数量
+    EIO_CSTAT_REQ_QBYTES = 5,   ///< 请求队列（含紧急消息队列）当前的数据字节数
+    EIO_CSTAT_RES_QSIZE  = 6,   ///< 应答队列当前的消息数量
+    EIO_CSTAT_RES_QBYTES = 7,   ///< 应答队列当前的数据字节数
+    EIO_CSTAT_BUSY_US    = 8,   ///< 累计被（线程池的）工作线程占用的时长（单位 微秒）
+    EIO_CSTAT_IDLE_MS    = 9,   ///< 距最后一次 读/写 数据的时长（单位 毫秒）
+    EIO_CSTAT_COUNT      = 10,  ///< 统计项的数量
+} emIoChannelCounter;
+
+/**
+ * @struct x_tcp_io_cstat_t
+ * @brief  IO 通道对象的运行统计信息快照（参看 x_tcp_io_channel_t::get_cstat()）。
+ */
+typedef struct x_tcp_io_cstat_t
+{
+    x_sockfd_t   xfdt_sockfd;                    ///< 套接字描述符
+    x_uint64_t   xult_value[EIO_CSTAT_COUNT];    ///< 各个统计项的值（参看 emIoChannelCounter）
+} x_tcp_io_cstat_t;
+
 ////////////////////////////////////////////////////////////////////////////////
 // x_tcp_io_channel_t
 
@@ -57,6 +103,12 @@ public:
         ECV_IO_TASK_TIME_SLICE = 10 * 1000,  ///< IO 任务对象执行所参考的运行时间片，单位为 微秒（默认值）
         ECV_IO_TASK_MAX_RLEN   = 64 * 1024,  ///< IO 消息执行 读 操作时，限制最大的数据长度
         ECV_IO_TASK_MAX_WLEN   = 64 * 1024,  ///< IO 消息执行 写 操作时，限制最大的数据长度
+        ECV_IO_REQ_BATCH_SIZE  = 16,         ///< 消息泵单次批量投递的 IO 请求消息最大数量（默认值）
+        ECV_REQ_QUEUE_HWM      = 4 * 1024 * 1024,  ///< 请求队列的数据字节数 高水位线（默认值）
+        ECV_REQ_QUEUE_LWM      = 1 * 1024 * 1024,  ///< 请求队列的数据字节数 低水位线（默认值）
+        ECV_RES_QUEUE_HWM      = 8 * 1024 * 1024,  ///< 应答队列的数据字节数 高水位线（默认值）
+        ECV_RES_QUEUE_LWM      = 2 * 1024 * 1024,  ///< 应答队列的数据字节数 低水位线（默认值）
+        ECV_IO_ZCOPY_MIN_SIZE  = XTCP_IO_ZCOPY_MIN_SIZE,  ///< IO 应答消息以 MSG_ZEROCOPY 写入的最小长度（默认值）
     } emConstValue;
 
 protected:
@@ -69,6 +121,7 @@ protected:
         EIO_STATUS_READABLE  = 0x00000001,  ///< 可读
         EIO_STATUS_WRITABLE  = 0x00000002,  ///< 可写
         EIO_STATUS_OCCUPIED  = 0x00000004,  ///< 被（线程池的）工作线程持有（占用）
+        EIO_STATUS_BPRESSED  = 0x00000008,  ///< 背压（消息队列超出高水位线，暂停读取数据）
         EIO_STATUS_WDESTROY  = 0x80000000,  ///< 等待销毁
     } emIoHandleStatus;
 
@@ -95,6 +148,39 @@ protected:
 
     using x_mqautolock_t = x_autospin_t< x_msg_queue_t >;
 
+    /**
+     * @brief 应答操作的 IO 消息队列（业务层任意线程投递，仅由写操作的 IO 任务对象取出）。
+     */
+    using x_res_queue_t = x_mpsc_queue_t< x_iomsg_t >;
+
+    /**
+     * @enum  emZeroCopyMode
+     * @brief 套接字的 MSG_ZEROCOPY 写入模式。
+     */
+    typedef enum emZeroCopyMode
+    {
+        EZCOPY_UNKNOWN  = 0,  ///< 未确定（首次以 MSG_ZEROCOPY 写入时，为套接字开启 SO_ZEROCOPY 选项）
+        EZCOPY_ENABLED  = 1,  ///< 已启用
+        EZCOPY_DISABLED = 2,  ///< 已禁用（系统不支持，或者内核实际仍以拷贝方式发送数据）
+    } emZeroCopyMode;
+
+    /**
+     * @struct x_zcopy_t
+     * @brief  以 MSG_ZEROCOPY 写入，等待内核完成通知的 IO 消息（持有数据块的引用，延迟其回收）。
+     */
+    typedef struct x_zcopy_t
+    {
+        x_uint32_t xut_zckey;    ///< 所属 sendmsg() 调用的完成通知序号
+        x_iomsg_t  xio_message;  ///< 共享数据块的 IO 消息拷贝
+    } x_zcopy_t;
+
+    /**
+     * @brief 从 IO 通道对象的内存区域（参看 io_arena()）分配内存的 分配器 与 字符串 类型。
+     */
+    template< typename _Ty >
+    using x_arena_alloc_t  = x_bump_allocator_t< _Ty >;
+    using x_arena_string_t = std::basic_string< x_char_t, std::char_traits< x_char_t >, x_arena_alloc_t< x_char_t > >;
+
     // constructor/destructor
 public:
     explicit x_tcp_io_channel_t(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd);
@@ -105,13 +191,15 @@ protected:
     /**********************************************************/
     /**
      * @brief 投递请求操作的 IO 消息。
-     * @note  该接口服务于 x_tcp_io_task_t 对象，可重载该接口，实现消息分包等功能。
+     * @note  该接口服务于 x_tcp_io_task_t 对象；若已设置分帧解码器（参看 set_io_decoder()），
+     *        则由解码器进行消息分包，每个完整的帧均以视图消息的方式直接加入请求队列，
+     *        否则，整个 IO 消息作为一个请求消息投递。也可重载该接口，实现其他的投递方式。
      * 
-     * @param [in,out] xio_message : 投递的 IO 消息。
+     * @param [in,out] xio_message : 投递的 IO 消息（回参为剩余的未成帧数据）。
      * 
      * @return x_int32_t
      *         - 返回值 >=  0，表示操作产生的事件数量，
-     *           若重载该接口，进行消息分包操作，则产生的事件数量可能会大于 1。
+     *           进行消息分包操作时，则产生的事件数量可能会大于 1。
      *         - 返回值 == -1，表示产生错误，后续则可关闭该业务层工作对象。
      */
     virtual x_int32_t post_req_xmsg(x_tcp_io_message_t & xio_message);
@@ -120,6 +208,7 @@ protected:
     /**
      * @brief 拉取应答操作的 IO 消息。
      * @note  该接口服务于 x_tcp_io_task_t 对象，取到的 IO 消息，用于写操作，即应答操作。
+     *        应答队列为 单消费者 队列，该接口只能在写操作的 IO 任务对象中调用。
      * 
      * @param [out] xio_message : 操作成功返回的 IO 消息。
      * 
@@ -150,6 +239,54 @@ protected:
      */
     virtual x_uint32_t get_io_task_max_wlen(void) const;
 
+    /**********************************************************/
+    /**
+     * @brief 消息泵单次批量投递（参看 io_event_requested_batch()）的 IO 请求消息最大数量。
+     * @note  消息泵每提取一批消息，各个请求队列仅加锁一次，且每批消息投递完成后才判断是否超出时间片。
+     */
+    virtual x_uint32_t get_io_req_batch_size(void) const;
+
+    /**********************************************************/
+    /**
+     * @brief 判断请求操作的 IO 消息是否为紧急消息（如 心跳、登录、暂停 等控制类消息）。
+     * @note
+     * <pre>
+     *   紧急消息存放于独立的请求队列中，消息泵优先投递这些消息；
+     *   并且，紧急消息未投递完成时，x_tcp_io_task_t 以紧急优先级提交至线程池，
+     *   使其不必排在大批量数据传输的任务之后。
+     * </pre>
+     */
+    virtual x_bool_t is_urgent_xmsg(const x_tcp_io_message_t & xio_message) const;
+
+    /**********************************************************/
+    /**
+     * @brief 请求队列（含紧急消息队列）的数据字节数 低水位线 与 高水位线。
+     * @note  请求队列 或 应答队列 的数据字节数超出其高水位线时，IO 通道对象进入背压状态（暂停读取数据），
+     *        两者均回落至各自的低水位线以下后，才恢复读取。
+     * 
+     * @param [out] xst_lwm : 低水位线（字节数）。
+     * @param [out] xst_hwm : 高水位线（字节数）。
+     */
+    virtual x_void_t get_req_watermark(x_size_t & xst_lwm, x_size_t & xst_hwm) const;
+
+    /**********************************************************/
+    /**
+     * @brief 应答队列的数据字节数 低水位线 与 高水位线（参看 get_req_watermark() ）。
+     * 
+     * @param [out] xst_lwm : 低水位线（字节数）。
+     * @param [out] xst_hwm : 高水位线（字节数）。
+     */
+    virtual x_void_t get_res_watermark(x_size_t & xst_lwm, x_size_t & xst_hwm) const;
+
+    /**********************************************************/
+    /**
+     * @brief IO 应答消息以 MSG_ZEROCOPY 写入的最小长度（返回 0 时，不启用 MSG_ZEROCOPY）。
+     * @note  单次聚合写入的 IO 应答消息中，有数据长度不小于该值的，则该次写入以 MSG_ZEROCOPY 进行，
+     *        其数据块延迟至内核通知完成后（套接字错误队列）才回收；否则，仍以常规的拷贝方式写入。
+     *        小数据量时，锁定内存页与完成通知的开销大于数据拷贝，建议取值不小于 16KB。
+     */
+    virtual x_uint32_t get_io_zcopy_min_size(void) const;
+
     // extensible interfaces : for the subclass of business layer
 protected:
     /**********************************************************/
@@ -163,6 +300,21 @@ protected:
      */
     virtual x_int32_t io_event_requested(x_tcp_io_message_t & xio_message);
 
+    /**********************************************************/
+    /**
+     * @brief 批量处理 “接收 IO 请求消息” 的事件（消息泵一次提取到的所有 IO 请求消息，紧急消息在前）。
+     * @note  默认实现为依序调用 io_event_requested()；可重载该接口，分摊批量消息的处理开销
+     *        （如 多个数据块请求合并为一次文件读取，多个应答合并为一次投递 等）。
+     * 
+     * @param [in,out] xmsg_vptr : IO 请求消息数组（接口返回后即被释放，可 std::move() 转移其中的消息）。
+     * @param [in    ] xut_count : IO 请求消息数量。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示 IO 操作可持续有效；
+     *         - 返回 其他值（错误码），表示 IO 操作失效，之后将会转入等待销毁的状态。
+     */
+    virtual x_int32_t io_event_requested_batch(x_tcp_io_message_t * xmsg_vptr, x_uint32_t xut_count);
+
     /**********************************************************/
     /**
      * @brief 处理 “完成 IO 应答消息” 的事件。
@@ -190,6 +342,19 @@ protected:
                                          x_int32_t xit_etype,
                                          x_int32_t xit_errno);
 
+    /**********************************************************/
+    /**
+     * @brief 处理 “背压状态变更” 的事件。
+     * @note  可重载该接口，如 进入背压状态时，暂停生产应答数据（文件下载等）。
+     * 
+     * @param [in ] xbt_pressed : X_TRUE，进入背压状态（已暂停读取数据）；X_FALSE，解除背压状态（已恢复读取）。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示 IO 操作可持续有效；
+     *         - 返回 其他值（错误码），表示 IO 操作失效，之后将会转入等待销毁的状态。
+     */
+    virtual x_int32_t io_event_backpressure(x_bool_t xbt_pressed);
+
     /**********************************************************/
     /**
      * @brief 处理 “IO 通道对象被销毁” 的事件。
@@ -238,6 +403,15 @@ public:
         return (0 != (m_xut_status & EIO_STATUS_OCCUPIED));
     }
 
+    /**********************************************************/
+    /**
+     * @brief 是否处于背压状态（暂停读取数据）。
+     */
+    inline x_bool_t is_bpressed(void) const
+    {
+        return (0 != (m_xut_status & EIO_STATUS_BPRESSED));
+    }
+
     /**********************************************************/
     /**
      * @brief 是否等待销毁。
@@ -251,7 +425,13 @@ public:
     /**
      * @brief 请求操作的 IO 消息队列中的消息对象数量。
      */
-    inline x_size_t req_queue_size(void) const { return m_xmqueue_req.size(); }
+    inline x_size_t req_queue_size(void) const { return (m_xmqueue_req.size() + m_xmqueue_urq.size()); }
+
+    /**********************************************************/
+    /**
+     * @brief 请求操作的 IO 消息队列中的紧急消息对象数量。
+     */
+    inline x_size_t urq_queue_size(void) const { return m_xmqueue_urq.size(); }
 
     /**********************************************************/
     /**
@@ -259,8 +439,61 @@ public:
      */
     inline x_size_t res_queue_size(void) const { return m_xmqueue_res.size(); }
 
+    /**********************************************************/
+    /**
+     * @brief 请求操作的 IO 消息队列（含紧急消息队列）中的数据字节数。
+     */
+    inline x_size_t req_queue_bytes(void) const { return m_xst_req_bytes.load(std::memory_order_relaxed); }
+
+    /**********************************************************/
+    /**
+     * @brief 应答操作的 IO 消息队列中的数据字节数。
+     */
+    inline x_size_t res_queue_bytes(void) const { return m_xst_res_bytes.load(std::memory_order_relaxed); }
+
+    /**********************************************************/
+    /**
+     * @brief 读取运行统计信息的快照（各统计项均为 relaxed 原子读取，不加锁，可在任意线程调用）。
+     * 
+     * @param [out] xio_cstat : 操作返回的运行统计信息。
+     */
+    x_void_t get_cstat(x_tcp_io_cstat_t & xio_cstat) const;
+
     // internal invoking
 protected:
+    /**********************************************************/
+    /**
+     * @brief 设置请求消息的分帧解码器（一般在子类的构造函数中设置）。
+     * @note  解码器对象由调用方持有（通常为子类的数据成员），其生命周期须覆盖当前 IO 通道对象。
+     * 
+     * @param [in ] xio_decoder : 分帧解码器（为 X_NULL 时，则不进行消息分包）。
+     */
+    inline x_void_t set_io_decoder(x_tcp_io_decoder_t * xio_decoder)
+    {
+        m_xio_decoder = xio_decoder;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回 IO 通道对象的内存区域（连接期间的小对象从中顺序分配，cleanup() 时一次性归还至 IO 消息的内存池）。
+     * @note  子类须在 io_event_destroyed() 中释放在其上分配的内存（cleanup() 随后执行）；
+     *        与其他 IO 通道对象数据一样，只在持有该对象的工作线程中访问。
+     */
+    inline x_bump_arena_t & io_arena(void) { return m_xio_arena; }
+
+    /**********************************************************/
+    /**
+     * @brief 返回 从 IO 通道对象的内存区域分配内存的 分配器。
+     */
+    template< typename _Ty = x_char_t >
+    inline x_arena_alloc_t< _Ty > arena_alloc(void) { return x_arena_alloc_t< _Ty >(&m_xio_arena); }
+
+    /**********************************************************/
+    /**
+     * @brief 将 IO 消息加入到请求队列（由 is_urgent_xmsg() 判断其所要加入的是 紧急队列 还是 常规队列）。
+     */
+    x_void_t push_req_xmsg(x_iomsg_t && xio_message);
+
     /**********************************************************/
     /**
      * @brief 将 IO 消息加入到应答队列。
@@ -311,6 +544,16 @@ private:
                        (m_xut_status &= ~EIO_STATUS_OCCUPIED);
     }
 
+    /**********************************************************/
+    /**
+     * @brief 设置背压状态。
+     */
+    inline x_void_t set_bpressed(x_bool_t xbt_bpressed)
+    {
+        xbt_bpressed ? (m_xut_status |=  EIO_STATUS_BPRESSED) :
+                       (m_xut_status &= ~EIO_STATUS_BPRESSED);
+    }
+
     /**********************************************************/
     /**
      * @brief 设置等待销毁状态。
@@ -327,7 +570,7 @@ private:
      */
     inline x_bool_t req_xmsg_is_empty(void) const
     {
-        return (m_xmsg_reading.is_empty() && m_xmqueue_req.empty());
+        return (m_xmsg_reading.is_empty() && m_xmqueue_req.empty() && m_xmqueue_urq.empty());
     }
 
     /**********************************************************/
@@ -336,7 +579,7 @@ private:
      */
     inline x_bool_t res_xmsg_is_empty(void) const
     {
-        return (!m_xmsg_writing.is_writable() && m_xmqueue_res.empty());
+        return ((m_xst_wpos >= m_xvec_writing.size()) && m_xmqueue_res.empty());
     }
 
     /**********************************************************/
@@ -374,6 +617,8 @@ private:
     /**********************************************************/
     /**
      * @brief 执行 IO 应答消息的写入流程。
+     * @note  从应答队列中一次提取多个 IO 应答消息，以 sendmsg() 聚合写入（参看 x_tcp_io_message_t::nio_writev()），
+     *        每个完成写入的 IO 应答消息，仍各自触发一次 io_event_responsed() 通知。
      * 
      * @param [in, out] xit_wmsgs : 入参，写处理 IO 应答消息操作的最大数量；回参，实际写处理的数量。
      * 
@@ -383,6 +628,95 @@ private:
      */
     x_int32_t res_xmsg_writing(x_int32_t & xit_wmsgs);
 
+    /**********************************************************/
+    /**
+     * @brief 累计被工作线程占用的时长（由 x_tcp_io_task_t 在每次任务执行后调用）。
+     */
+    inline x_void_t add_busy_time(x_int64_t xlit_nanos)
+    {
+        if (xlit_nanos > 0)
+            m_xult_busy_ns.fetch_add((x_uint64_t)xlit_nanos, std::memory_order_relaxed);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 记录 读/写 数据的活动时间点（统计项 EIO_CSTAT_IDLE_MS 的依据）。
+     */
+    inline x_void_t mark_active(void)
+    {
+        m_xlit_active.store(
+            std::chrono::duration_cast< std::chrono::nanoseconds >(
+                std::chrono::steady_clock::now().time_since_epoch()).count(),
+            std::memory_order_relaxed);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 依据消息队列的数据字节数与水位线，更新背压状态（同时更新套接字所监听的 读就绪 事件）。
+     * @note  由 x_tcp_io_task_t 在 读、写、消息投递 等任务执行后调用。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示操作过程中未产生错误；
+     *         - 返回 其他值，表示操作过程中产生的错误码。
+     */
+    x_int32_t update_backpressure(void);
+
+    /**********************************************************/
+    /**
+     * @brief 按照当前的背压状态，更新套接字所监听的 读就绪、写就绪 事件。
+     * @note  背压状态下不监听 读就绪 事件；解除背压后重新监听时，若套接字仍有待读数据，epoll 会再次通知。
+     * 
+     * @param [in ] xbt_pollout : 是否监听 写就绪 事件。
+     * 
+     * @return x_int32_t
+     *         - 成功，返回 0；
+     *         - 失败，返回 错误码。
+     */
+    x_int32_t update_pollmask(x_bool_t xbt_pollout);
+
+    /**********************************************************/
+    /**
+     * @brief 聚合写入 m_xvec_writing 中未完成写入的 IO 应答消息（按需以 MSG_ZEROCOPY 写入）。
+     * 
+     * @param [in ] xut_max_len : 限制操作的数据最大长度（字节数）。
+     * @param [out] xit_error   : 操作返回的错误码。
+     * 
+     * @return x_uint32_t
+     *         - 返回已写入的字节数。
+     */
+    x_uint32_t res_xmsg_sendv(x_uint32_t xut_max_len, x_int32_t & xit_error);
+
+    /**********************************************************/
+    /**
+     * @brief 判断本次聚合写入是否以 MSG_ZEROCOPY 进行（若是，则同时将内嵌缓存的数据转存至数据块）。
+     * 
+     * @param [in ] xmsg_array : 待写入的 IO 应答消息数组。
+     * @param [in ] xut_count  : 待写入的 IO 应答消息数量。
+     */
+    x_bool_t zcopy_prepare(x_iomsg_t * xmsg_array, x_uint32_t xut_count);
+
+    /**********************************************************/
+    /**
+     * @brief 以 MSG_ZEROCOPY 写入后，保存已写入数据的 IO 应答消息（共享数据块），等待内核的完成通知。
+     * 
+     * @param [in ] xmsg_array : 已写入的 IO 应答消息数组。
+     * @param [in ] xut_count  : IO 应答消息数量。
+     * @param [in ] xut_wlen   : 写入前，首个 IO 应答消息已写入的数据长度。
+     * @param [in ] xut_bytes  : 本次写入的字节数。
+     */
+    x_void_t zcopy_pending(x_iomsg_t * xmsg_array, x_uint32_t xut_count, x_uint32_t xut_wlen, x_uint32_t xut_bytes);
+
+    /**********************************************************/
+    /**
+     * @brief 处理套接字的错误事件：读取错误队列中 MSG_ZEROCOPY 的完成通知，回收对应的 IO 应答消息。
+     * @note  由 x_tcp_io_holder_t 在（epoll 事件线程中）收到 EPOLLERR 事件时调用。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示仅为完成通知，套接字仍然有效；
+     *         - 返回 其他值，表示套接字产生的错误码。
+     */
+    x_int32_t zcopy_reaping(void);
+
     // data members
 private:
     x_handle_t      m_xht_manager;   ///< 所隶属的 x_tcp_io_manager_t 对象句柄
@@ -390,11 +724,34 @@ private:
     x_uint32_t      m_xut_status;    ///< 状态标识
 
     x_iomsg_t       m_xmsg_reading;  ///< 为 x_tcp_io_task_t 提供读操作的 IO 消息缓存对象
-    x_iomsg_t       m_xmsg_writing;  ///< 为 x_tcp_io_task_t 提供写操作的 IO 消息缓存对象
+    x_tcp_io_decoder_t * m_xio_decoder;  ///< 请求消息的分帧解码器（不持有其所有权）
+    std::vector< x_iomsg_t > m_xvec_pumping;  ///< 为 x_tcp_io_task_t 提供（批量）投递请求消息的缓存对象
+    std::vector< x_iomsg_t > m_xvec_writing;  ///< 为 x_tcp_io_task_t 提供（聚合）写操作的 IO 消息缓存对象
+    x_size_t        m_xst_wpos;      ///< m_xvec_writing 中首个未完成写入的 IO 消息位置
+
+    std::atomic< x_size_t > m_xst_req_bytes;  ///< 请求队列（含紧急消息队列）中的数据字节数
+    std::atomic< x_size_t > m_xst_res_bytes;  ///< 应答队列中的数据字节数
+    x_spinlock_t    m_xspin_pollmask; ///< 同步 背压状态 与 套接字监听事件 的更新操作
+    x_bool_t        m_xbt_pollout;    ///< 套接字当前是否监听 写就绪 事件
+
+    std::atomic< x_uint64_t > m_xult_rbytes;   ///< 统计项：累计读取的字节数
+    std::atomic< x_uint64_t > m_xult_wbytes;   ///< 统计项：累计写入的字节数
+    std::atomic< x_uint64_t > m_xult_rframes;  ///< 统计项：累计加入请求队列的 IO 请求消息数量
+    std::atomic< x_uint64_t > m_xult_wframes;  ///< 统计项：累计完成写入的 IO 应答消息数量
+    std::atomic< x_uint64_t > m_xult_busy_ns;  ///< 统计项：累计被工作线程占用的时长（单位 纳秒）
+    std::atomic< x_int64_t  > m_xlit_active;   ///< 统计项：最后一次 读/写 数据的时间点（steady_clock 的纳秒计数）
+
+    std::atomic< x_uint32_t > m_xut_zcmode;  ///< 套接字的 MSG_ZEROCOPY 写入模式（参看 emZeroCopyMode）
+    x_uint32_t      m_xut_zckey;      ///< 下一次 MSG_ZEROCOPY 写入的完成通知序号（与内核的计数保持一致）
+    x_spinlock_t    m_xspin_zcopy;    ///< 同步 m_xdeq_zcopy 的访问操作
+    std::deque< x_zcopy_t > m_xdeq_zcopy;  ///< 等待内核完成通知的 IO 应答消息
+
+    x_bump_arena_t  m_xio_arena;      ///< 连接期间的小对象所使用的内存区域（cleanup() 时一次性释放）
 
 protected:
     x_msg_queue_t   m_xmqueue_req;   ///< 请求操作的 IO 消息队列
-    x_msg_queue_t   m_xmqueue_res;   ///< 应答操作的 IO 消息队列
+    x_msg_queue_t   m_xmqueue_urq;   ///< 请求操作的 IO 消息队列（紧急消息）
+    x_res_queue_t   m_xmqueue_res;   ///< 应答操作的 IO 消息队列
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,207 @@
+/**
+ * @file    xtcp_io_decoder.cpp
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xtcp_io_decoder.cpp
+ * 创建日期：2019年03月25日
+ * 文件标识：
+ * 文件摘要：IO 请求消息的（增量式）分帧解码器：抽象接口类，以及 长度前缀、分隔符 两种通用的实现。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2019年03月25日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#include "xcomm.h"
+#include "xtcp_io_decoder.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// x_tcp_io_lpdecoder_t
+
+//====================================================================
+
+// 
+// x_tcp_io_lpdecoder_t : constructor/destructor
+// 
+
+x_tcp_io_lpdecoder_t::x_tcp_io_lpdecoder_t(x_uint32_t xut_loffset,
+                                           x_uint32_t xut_lsize,
+                                           x_int32_t xit_ladjust,
+                                           x_uint32_t xut_max_len)
+    : m_xut_loffset(xut_loffset)
+    , m_xut_lsize(xut_lsize)
+    , m_xit_ladjust(xit_ladjust)
+    , m_xut_max_len(xut_max_len)
+{
+    XASSERT((1 == xut_lsize) || (2 == xut_lsize) || (4 == xut_lsize));
+}
+
+x_tcp_io_lpdecoder_t::~x_tcp_io_lpdecoder_t(void)
+{
+
+}
+
+//====================================================================
+
+// 
+// x_tcp_io_lpdecoder_t : overrides
+// 
+
+/**********************************************************/
+/**
+ * @brief 从未成帧的接收数据中，查找首个完整的帧。
+ * 
+ * @param [in ] xct_dptr : 未成帧的接收数据。
+ * @param [in ] xut_dlen : 未成帧的接收数据长度。
+ * @param [out] xut_fpos : 帧的起始位置（总是为 0）。
+ * @param [out] xut_flen : 帧的长度。
+ * 
+ * @return x_int32_t
+ *         - 返回 解码结果（参看 emDecodeResult 枚举值）。
+ */
+x_int32_t x_tcp_io_lpdecoder_t::decode(const x_uchar_t * xct_dptr,
+                                       x_uint32_t xut_dlen,
+                                       x_uint32_t & xut_fpos,
+                                       x_uint32_t & xut_flen)
+{
+    x_uint32_t xut_lvalue = 0;
+    x_int64_t  xlit_flen  = 0;
+
+    xut_fpos = 0;
+    xut_flen = 0;
+
+    if (xut_dlen < (m_xut_loffset + m_xut_lsize))
+    {
+        return EDEC_RESULT_NEED;
+    }
+
+    // 读取（网络字节序的）长度字段
+    for (x_uint32_t xut_iter = 0; xut_iter < m_xut_lsize; ++xut_iter)
+    {
+        xut_lvalue = (xut_lvalue << 8) | xct_dptr[m_xut_loffset + xut_iter];
+    }
+
+    xlit_flen = (x_int64_t)xut_lvalue + m_xit_ladjust;
+    if ((xlit_flen < (x_int64_t)(m_xut_loffset + m_xut_lsize)) || (xlit_flen > (x_int64_t)m_xut_max_len))
+    {
+        return EDEC_RESULT_ERROR;
+    }
+
+    if ((x_int64_t)xut_dlen < xlit_flen)
+    {
+        return EDEC_RESULT_NEED;
+    }
+
+    xut_flen = (x_uint32_t)xlit_flen;
+
+    return EDEC_RESULT_FRAME;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// x_tcp_io_dmdecoder_t
+
+//====================================================================
+
+// 
+// x_tcp_io_dmdecoder_t : constructor/destructor
+// 
+
+x_tcp_io_dmdecoder_t::x_tcp_io_dmdecoder_t(const x_uchar_t * xct_delim, x_uint32_t xut_dsize, x_uint32_t xut_max_len)
+    : m_xut_dsize(xut_dsize)
+    , m_xut_max_len(xut_max_len)
+    , m_xut_spos(0)
+{
+    XASSERT(X_NULL != xct_delim);
+    XASSERT((xut_dsize > 0) && (xut_dsize <= ECV_DELIM_MAXLEN));
+
+    if (m_xut_dsize > ECV_DELIM_MAXLEN)
+        m_xut_dsize = ECV_DELIM_MAXLEN;
+    memcpy(m_xct_delim, xct_delim, m_xut_dsize);
+}
+
+x_tcp_io_dmdecoder_t::~x_tcp_io_dmdecoder_t(void)
+{
+
+}
+
+//====================================================================
+
+// 
+// x_tcp_io_dmdecoder_t : overrides
+// 
+
+/**********************************************************/
+/**
+ * @brief 从未成帧的接收数据中，查找首个完整的帧。
+ * 
+ * @param [in ] xct_dptr : 未成帧的接收数据。
+ * @param [in ] xut_dlen : 未成帧的接收数据长度。
+ * @param [out] xut_fpos : 帧的起始位置（总是为 0）。
+ * @param [out] xut_flen : 帧的长度（包含分隔符）。
+ * 
+ * @return x_int32_t
+ *         - 返回 解码结果（参看 emDecodeResult 枚举值）。
+ */
+x_int32_t x_tcp_io_dmdecoder_t::decode(const x_uchar_t * xct_dptr,
+                                       x_uint32_t xut_dlen,
+                                       x_uint32_t & xut_fpos,
+                                       x_uint32_t & xut_flen)
+{
+    const x_uchar_t * xct_iter = X_NULL;
+    const x_uchar_t * xct_bptr = xct_dptr + m_xut_spos;
+    const x_uchar_t * xct_eptr = xct_dptr + xut_dlen;
+
+    xut_fpos = 0;
+    xut_flen = 0;
+
+    //======================================
+    // 从上次扫描结束的位置开始，查找分隔符
+
+    while ((xct_eptr - xct_bptr) >= (x_int32_t)m_xut_dsize)
+    {
+        xct_iter = (const x_uchar_t *)memchr(xct_bptr, m_xct_delim[0], (xct_eptr - xct_bptr) - m_xut_dsize + 1);
+        if (X_NULL == xct_iter)
+        {
+            break;
+        }
+
+        if (0 == memcmp(xct_iter, m_xct_delim, m_xut_dsize))
+        {
+            xut_flen   = (x_uint32_t)(xct_iter - xct_dptr) + m_xut_dsize;
+            m_xut_spos = 0;
+
+            return (xut_flen <= m_xut_max_len) ? EDEC_RESULT_FRAME : EDEC_RESULT_ERROR;
+        }
+
+        xct_bptr = xct_iter + 1;
+    }
+
+    //======================================
+    // 未找到分隔符，记录下次开始扫描的位置（保留可能构成分隔符前缀的末尾数据）
+
+    if (xut_dlen >= m_xut_max_len)
+    {
+        return EDEC_RESULT_ERROR;
+    }
+
+    m_xut_spos = (xut_dlen >= m_xut_dsize) ? (xut_dlen - m_xut_dsize + 1) : 0;
+
+    return EDEC_RESULT_NEED;
+}
+
+/**********************************************************/
+/**
+ * @brief 重置解码状态。
+ */
+x_void_t x_tcp_io_dmdecoder_t::reset(void)
+{
+    m_xut_spos = 0;
+}
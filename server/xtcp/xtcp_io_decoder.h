@@ -0,0 +1,199 @@
+/**
+ * @file    xtcp_io_decoder.h
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xtcp_io_decoder.h
+ * 创建日期：2019年03月25日
+ * 文件标识：
+ * 文件摘要：IO 请求消息的（增量式）分帧解码器：抽象接口类，以及 长度前缀、分隔符 两种通用的实现。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2019年03月25日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#ifndef __XTCP_IO_DECODER_H__
+#define __XTCP_IO_DECODER_H__
+
+#include "xtypes.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// x_tcp_io_decoder_t
+
+/**
+ * @class x_tcp_io_decoder_t
+ * @brief IO 请求消息的分帧解码器（抽象接口类）。
+ * 
+ * @note
+ * <pre>
+ *   1. x_tcp_io_channel_t 每次读取数据后，以所有未成帧的接收数据（xct_dptr, xut_dlen）循环调用 decode()，
+ *      找到完整的帧，即以视图消息（共享接收数据块）的方式直接加入请求队列，不经过中间容器；
+ *   2. decode() 返回 EDEC_RESULT_FRAME 时，[xut_fpos, xut_fpos + xut_flen) 为完整的帧，
+ *      调用方随后丢弃前 (xut_fpos + xut_flen) 个字节（xut_fpos 之前的为无效数据）；
+ *   3. decode() 返回 EDEC_RESULT_NEED 时，调用方丢弃前 xut_fpos 个字节（已确认的无效数据），
+ *      解码器可记录已扫描的位置（相对于丢弃后的起始位置），避免下次调用时重复扫描半包数据；
+ *   4. 解码器对象保存的是单个 IO 通道对象的解码状态，不可被多个 IO 通道对象共用。
+ * </pre>
+ */
+class x_tcp_io_decoder_t
+{
+    // common data types
+public:
+    /**
+     * @enum  emDecodeResult
+     * @brief decode() 操作的返回值。
+     */
+    typedef enum emDecodeResult
+    {
+        EDEC_RESULT_ERROR = -1,  ///< 非法数据（IO 通道对象随后将被关闭）
+        EDEC_RESULT_NEED  =  0,  ///< 数据不足以构成完整的帧，等待后续的数据
+        EDEC_RESULT_FRAME =  1,  ///< 找到完整的帧
+    } emDecodeResult;
+
+    // constructor/destructor
+public:
+    x_tcp_io_decoder_t(void) {  }
+    virtual ~x_tcp_io_decoder_t(void) {  }
+
+    // extensible interfaces
+public:
+    /**********************************************************/
+    /**
+     * @brief 从未成帧的接收数据中，查找首个完整的帧。
+     * 
+     * @param [in ] xct_dptr : 未成帧的接收数据。
+     * @param [in ] xut_dlen : 未成帧的接收数据长度。
+     * @param [out] xut_fpos : 帧的起始位置（返回 EDEC_RESULT_NEED 时，为可丢弃的无效数据长度）。
+     * @param [out] xut_flen : 帧的长度（仅在返回 EDEC_RESULT_FRAME 时有效）。
+     * 
+     * @return x_int32_t
+     *         - 返回 解码结果（参看 emDecodeResult 枚举值）。
+     */
+    virtual x_int32_t decode(const x_uchar_t * xct_dptr,
+                             x_uint32_t xut_dlen,
+                             x_uint32_t & xut_fpos,
+                             x_uint32_t & xut_flen) = 0;
+
+    /**********************************************************/
+    /**
+     * @brief 重置解码状态（IO 通道对象清理数据时调用）。
+     */
+    virtual x_void_t reset(void) {  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// x_tcp_io_lpdecoder_t
+
+/**
+ * @class x_tcp_io_lpdecoder_t
+ * @brief 长度前缀（length-prefixed）的分帧解码器：帧的固定位置上存放（网络字节序的）长度字段。
+ * @note  帧长度 = 长度字段值 + xit_ladjust，只需检查长度字段，无需扫描数据。
+ */
+class x_tcp_io_lpdecoder_t : public x_tcp_io_decoder_t
+{
+    // constructor/destructor
+public:
+    /**********************************************************/
+    /**
+     * @brief 构造函数。
+     * 
+     * @param [in ] xut_loffset : 长度字段在帧中的偏移位置。
+     * @param [in ] xut_lsize   : 长度字段的字节数（1、2、4）。
+     * @param [in ] xit_ladjust : 帧长度相对于长度字段值的调整量（如 长度字段值仅为数据体长度时，则为头部长度）。
+     * @param [in ] xut_max_len : 帧的最大长度（超出则视为非法数据）。
+     */
+    x_tcp_io_lpdecoder_t(x_uint32_t xut_loffset,
+                         x_uint32_t xut_lsize,
+                         x_int32_t xit_ladjust,
+                         x_uint32_t xut_max_len);
+    virtual ~x_tcp_io_lpdecoder_t(void);
+
+    // overrides
+public:
+    /**********************************************************/
+    /**
+     * @brief 从未成帧的接收数据中，查找首个完整的帧。
+     */
+    virtual x_int32_t decode(const x_uchar_t * xct_dptr,
+                             x_uint32_t xut_dlen,
+                             x_uint32_t & xut_fpos,
+                             x_uint32_t & xut_flen) override;
+
+    // data members
+protected:
+    x_uint32_t   m_xut_loffset;   ///< 长度字段在帧中的偏移位置
+    x_uint32_t   m_xut_lsize;     ///< 长度字段的字节数
+    x_int32_t    m_xit_ladjust;   ///< 帧长度相对于长度字段值的调整量
+    x_uint32_t   m_xut_max_len;   ///< 帧的最大长度
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// x_tcp_io_dmdecoder_t
+
+/**
+ * @class x_tcp_io_dmdecoder_t
+ * @brief 分隔符（delimiter）的分帧解码器：以指定的分隔符结尾的数据为一帧（帧中包含分隔符）。
+ * @note  记录已扫描的位置，半包数据不会被重复扫描。
+ */
+class x_tcp_io_dmdecoder_t : public x_tcp_io_decoder_t
+{
+    // common data types
+public:
+    /**
+     * @enum  emConstValue
+     * @brief 相关的枚举常量值。
+     */
+    typedef enum emConstValue
+    {
+        ECV_DELIM_MAXLEN = 16,   ///< 分隔符的最大长度
+    } emConstValue;
+
+    // constructor/destructor
+public:
+    /**********************************************************/
+    /**
+     * @brief 构造函数。
+     * 
+     * @param [in ] xct_delim   : 分隔符。
+     * @param [in ] xut_dsize   : 分隔符的长度（1 ~ ECV_DELIM_MAXLEN）。
+     * @param [in ] xut_max_len : 帧的最大长度（超出仍未找到分隔符，则视为非法数据）。
+     */
+    x_tcp_io_dmdecoder_t(const x_uchar_t * xct_delim, x_uint32_t xut_dsize, x_uint32_t xut_max_len);
+    virtual ~x_tcp_io_dmdecoder_t(void);
+
+    // overrides
+public:
+    /**********************************************************/
+    /**
+     * @brief 从未成帧的接收数据中，查找首个完整的帧。
+     */
+    virtual x_int32_t decode(const x_uchar_t * xct_dptr,
+                             x_uint32_t xut_dlen,
+                             x_uint32_t & xut_fpos,
+                             x_uint32_t & xut_flen) override;
+
+    /**********************************************************/
+    /**
+     * @brief 重置解码状态。
+     */
+    virtual x_void_t reset(void) override;
+
+    // data members
+protected:
+    x_uchar_t    m_xct_delim[ECV_DELIM_MAXLEN];  ///< 分隔符
+    x_uint32_t   m_xut_dsize;     ///< 分隔符的长度
+    x_uint32_t   m_xut_max_len;   ///< 帧的最大长度
+    x_uint32_t   m_xut_spos;      ///< 下次开始扫描的位置
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XTCP_IO_DECODER_H__
@@ -28,6 +28,7 @@
 #include "xcomm.h"
 #include "xtcp_io_holder.h"
 #include "xtcp_io_manager.h"
+#include "xtcp_io_tstat.h"
 
 #include "xthreadpool.h"
 #include "xobjectpool.h"
@@ -132,6 +133,18 @@ protected:
      */
     virtual void set_running_flag(bool xrunning_flag) override;
 
+    /**********************************************************/
+    /**
+     * @brief 返回任务对象的亲和键值（以 IO 通道对象的套接字描述符作为键值）。
+     */
+    virtual size_t affinity_key(void) const override;
+
+    /**********************************************************/
+    /**
+     * @brief 返回任务对象的优先级（IO 读事件，以及存在紧急消息的 IO 消息投递事件，为紧急优先级）。
+     */
+    virtual size_t priority(void) const override;
+
     /**********************************************************/
     /**
      * @brief 获取任务对象的删除器。
@@ -175,10 +188,6 @@ private:
     x_io_cwptr_t  m_xio_cwptr;  ///< 目标操作的 x_tcp_io_channel_t 对象
     x_io_csptr_t  m_xio_csptr;  ///< 目标操作的 x_tcp_io_channel_t 对象（m_xut_event == EIO_TASK_DESTROY 时有效）
     x_uint32_t    m_xut_event;  ///< 任务对象所要处理事件（参看 emIoTaskEventType 枚举值）
-
-#ifdef _DEBUG
-    x_int64_t     m_xit_timev;  ///< 任务提交时的时间戳
-#endif // _DEBUG
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -186,6 +195,13 @@ private:
 using x_io_task_t  = x_tcp_io_task_t;
 using x_io_mangr_t = x_tcp_io_manager_t *;
 
+using x_io_creator_pool_t = x_objectpool_t< x_tcp_io_creator_t >;
+using x_io_holder_pool_t  = x_objectpool_t< x_tcp_io_holder_t  >;
+
+// IO 句柄对象的对象池（以 operator new/delete 的方式使用）
+static x_io_creator_pool_t _S_creator_objpool;
+static x_io_holder_pool_t  _S_holder_objpool;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 /**********************************************************/
@@ -245,10 +261,6 @@ x_tcp_io_task_t::x_tcp_io_task_t(const x_io_cwptr_t & xio_cwptr, x_uint32_t xut_
         XASSERT(nullptr != m_xio_csptr);
         m_xio_csptr->set_wdestroy(X_TRUE);
     }
-
-#ifdef _DEBUG
-    m_xit_timev = std::chrono::system_clock::now().time_since_epoch().count();
-#endif // _DEBUG
 }
 
 x_tcp_io_task_t::~x_tcp_io_task_t(void)
@@ -270,14 +282,14 @@ x_tcp_io_task_t::~x_tcp_io_task_t(void)
  */
 void x_tcp_io_task_t::run(x_running_checker_t * xchecker_ptr)
 {
-#ifdef _DEBUG
-    std::chrono::microseconds xtime_delay =
-        std::chrono::duration_cast< std::chrono::microseconds >(
-            std::chrono::system_clock::now() -
-            std::chrono::system_clock::time_point(std::chrono::system_clock::duration(m_xit_timev)));
+    using x_clock_t = x_threadpool_t::x_clock_t;
+    using x_nanos_t = std::chrono::nanoseconds;
 
-    STD_TRACE("[%s] task delay time: %lld us", task_event_text(m_xut_event), (x_int64_t)xtime_delay.count());
+    // 任务提交的时间戳由线程池（submit_task()）写入，与此处同为 steady_clock
+    const x_clock_t::time_point xtime_start = x_clock_t::now();
+    const x_clock_t::time_point xtime_submit{ x_clock_t::duration(submit_tick()) };
 
+#ifdef _DEBUG
     x_io_csptr_t xio_csptr = m_xio_cwptr.lock();
     if (nullptr != xio_csptr)
     {
@@ -300,6 +312,23 @@ void x_tcp_io_task_t::run(x_running_checker_t * xchecker_ptr)
     default:
         break;
     }
+
+    const x_int64_t xlit_svtime =
+        std::chrono::duration_cast< x_nanos_t >(x_clock_t::now() - xtime_start).count();
+
+    x_tcp_io_tstat_t::record(
+        m_xut_event,
+        std::chrono::duration_cast< x_nanos_t >(xtime_start - xtime_submit).count(),
+        xlit_svtime);
+
+    // 累计 IO 通道对象被工作线程占用的时长（已销毁的，则忽略）
+    {
+        x_io_csptr_t xio_csptr = m_xio_cwptr.lock();
+        if (nullptr != xio_csptr)
+        {
+            xio_csptr->add_busy_time(xlit_svtime);
+        }
+    }
 }
 
 /**********************************************************/
@@ -330,6 +359,53 @@ void x_tcp_io_task_t::set_running_flag(bool xrunning_flag)
     }
 }
 
+/**********************************************************/
+/**
+ * @brief 返回任务对象的亲和键值（以 IO 通道对象的套接字描述符作为键值）。
+ * @note  同一 IO 通道对象的任务，在亲和调度模式下总在同一工作线程上执行，
+ *        使其 IO 消息缓存与状态数据保持在该 CPU 核心的高速缓存中。
+ */
+size_t x_tcp_io_task_t::affinity_key(void) const
+{
+    if (nullptr != m_xio_csptr)
+    {
+        return (size_t)m_xio_csptr->get_sockfd();
+    }
+
+    x_io_csptr_t xio_csptr = m_xio_cwptr.lock();
+    if (nullptr != xio_csptr)
+    {
+        return (size_t)xio_csptr->get_sockfd();
+    }
+
+    return x_threadpool_t::xaffinity_none();
+}
+
+/**********************************************************/
+/**
+ * @brief 返回任务对象的优先级（IO 读事件，以及存在紧急消息的 IO 消息投递事件，为紧急优先级）。
+ * @note  IO 读事件本身的执行时间较短，且心跳、暂停等控制类消息须经由它才能进入请求队列，
+ *        故将其归入紧急通道；而大批量数据的传输则在 IO 写事件 中进行，归入常规通道。
+ */
+size_t x_tcp_io_task_t::priority(void) const
+{
+    if (EIO_TASK_READING == m_xut_event)
+    {
+        return x_threadpool_t::ETASK_PRIORITY_URGENT;
+    }
+
+    if (EIO_TASK_MSGPUMP == m_xut_event)
+    {
+        x_io_csptr_t xio_csptr = m_xio_cwptr.lock();
+        if ((nullptr != xio_csptr) && (xio_csptr->urq_queue_size() > 0))
+        {
+            return x_threadpool_t::ETASK_PRIORITY_URGENT;
+        }
+    }
+
+    return x_threadpool_t::ETASK_PRIORITY_NORMAL;
+}
+
 /**********************************************************/
 /**
  * @brief 获取任务对象的删除器。
@@ -449,13 +525,24 @@ x_int32_t x_tcp_io_task_t::handle_reading(void)
         XASSERT(nullptr != xio_mangr);
 
         //======================================
-        // 执行 IO 请求消息的读操作
+        // 执行 IO 请求消息的读操作（背压状态下暂停读取，待解除背压后由 读就绪 事件重新触发）
+
+        if (!xio_csptr->is_bpressed())
+        {
+            xit_error = xio_csptr->req_xmsg_reading(xit_nmsgs);
+            if (0 != xit_error)
+            {
+                LOGE("[fd:%d] xio_csptr->req_xmsg_reading(xit_nmsgs[%d]) return error : %d",
+                     xio_csptr->get_sockfd(), xit_nmsgs, xit_error);
+                break;
+            }
+        }
 
-        xit_error = xio_csptr->req_xmsg_reading(xit_nmsgs);
+        xit_error = xio_csptr->update_backpressure();
         if (0 != xit_error)
         {
-            LOGE("[fd:%d] xio_csptr->req_xmsg_reading(xit_nmsgs[%d]) return error : %d",
-                 xio_csptr->get_sockfd(), xit_nmsgs, xit_error);
+            LOGE("[fd:%d] xio_csptr->update_backpressure() return error : %d",
+                 xio_csptr->get_sockfd(), xit_error);
             break;
         }
 
@@ -532,7 +619,7 @@ x_int32_t x_tcp_io_task_t::handle_writing(void)
         //======================================
         // 执行 IO 应答消息的写操作流程
 
-        xit_wmsgs = (x_int32_t)xio_csptr->req_queue_size() + 1;
+        xit_wmsgs = (x_int32_t)xio_csptr->res_queue_size() + 1;
         xit_nmsgs = xit_wmsgs;
 
         xit_error = xio_csptr->res_xmsg_writing(xit_nmsgs);
@@ -543,6 +630,14 @@ x_int32_t x_tcp_io_task_t::handle_writing(void)
             break;
         }
 
+        xit_error = xio_csptr->update_backpressure();
+        if (0 != xit_error)
+        {
+            LOGE("[fd:%d] xio_csptr->update_backpressure() return error : %d",
+                 xio_csptr->get_sockfd(), xit_error);
+            break;
+        }
+
         //======================================
         // 触发下次的写操作事件
 
@@ -567,10 +662,10 @@ x_int32_t x_tcp_io_task_t::handle_writing(void)
             else
             {
                 // IO 通道对象处于不可写状态，则注册 写就绪 事件，触发下次的 EIO_TASK_WRITING 任务
-                xit_error = xio_mangr->register_pollout(xio_csptr->get_sockfd());
+                xit_error = xio_csptr->update_pollmask(X_TRUE);
                 if (0 != xit_error)
                 {
-                    LOGE("xio_mangr->register_pollout(xio_csptr->get_sockfd()[%d]) return error : %d",
+                    LOGE("[fd:%d] xio_csptr->update_pollmask(X_TRUE) return error : %d",
                          xio_csptr->get_sockfd(), xit_error);
                     break;
                 }
@@ -637,6 +732,14 @@ x_int32_t x_tcp_io_task_t::handle_msgpump(void)
             break;
         }
 
+        xit_error = xio_csptr->update_backpressure();
+        if (0 != xit_error)
+        {
+            LOGE("[fd:%d] xio_csptr->update_backpressure() return error : %d",
+                 xio_csptr->get_sockfd(), xit_error);
+            break;
+        }
+
         //======================================
         // 判断是否有其他任务需要继续执行
 
@@ -686,6 +789,41 @@ x_int32_t x_tcp_io_task_t::handle_msgpump(void)
 
 //====================================================================
 
+// 
+// x_tcp_io_creator_t : common invoking
+// 
+
+/**********************************************************/
+/**
+ * @brief 从对象池申请对象的内存（派生类对象则直接分配）。
+ */
+x_void_t * x_tcp_io_creator_t::operator new(size_t xst_size)
+{
+    if (sizeof(x_tcp_io_creator_t) != xst_size)
+    {
+        return ::operator new(xst_size);
+    }
+
+    return _S_creator_objpool.alloc_mem();
+}
+
+/**********************************************************/
+/**
+ * @brief 将对象的内存回收至对象池。
+ */
+x_void_t x_tcp_io_creator_t::operator delete(x_void_t * xobj_ptr, size_t xst_size)
+{
+    if (sizeof(x_tcp_io_creator_t) != xst_size)
+    {
+        ::operator delete(xobj_ptr);
+        return;
+    }
+
+    _S_creator_objpool.recyc_mem((x_tcp_io_creator_t *)xobj_ptr);
+}
+
+//====================================================================
+
 // 
 // x_tcp_io_creator_t : constructor/destructor
 // 
@@ -830,6 +968,7 @@ x_int32_t x_tcp_io_creator_t::try_create_io_channel(x_handle_t xht_manager, x_so
         xio_create_args.xfdt_sockfd = xfdt_sockfd;
         xio_create_args.xht_message = (x_handle_t)&m_xmsg_swap;
         xio_create_args.xht_channel = X_NULL;
+        xio_create_args.xht_csptr   = (x_handle_t)&m_xio_csptr;
 
         xit_error = xio_mangr->create_io_channel(xio_create_args);
         if (0 != xit_error)
@@ -852,8 +991,12 @@ x_int32_t x_tcp_io_creator_t::try_create_io_channel(x_handle_t xht_manager, x_so
             break;
         }
 
-        m_xio_csptr = x_io_csptr_t((x_tcp_io_channel_t *)xio_create_args.xht_channel);
-        XASSERT(nullptr != m_xio_csptr);
+        // 回调操作未直接设置 m_xio_csptr 时（对象与引用计数分开分配），以 xht_channel 构建
+        if (nullptr == m_xio_csptr)
+        {
+            m_xio_csptr = x_io_csptr_t((x_tcp_io_channel_t *)xio_create_args.xht_channel);
+        }
+        XASSERT(m_xio_csptr.get() == (x_tcp_io_channel_t *)xio_create_args.xht_channel);
 
         // 完成创建业务层的 IO 工作对象后，m_xmsg_swap 中缓存剩余的数据，
         // 应全部转移至 x_tcp_io_channel_t 对象中
@@ -882,11 +1025,54 @@ x_int32_t x_tcp_io_creator_t::try_create_io_channel(x_handle_t xht_manager, x_so
 
 /**********************************************************/
 /**
- * @brief 释放任务对象池中缓存的任务对象。
+ * @brief 预分配 IO 句柄对象（x_tcp_io_creator_t、x_tcp_io_holder_t）的对象池。
+ * 
+ * @param [in ] xut_count : 每种 IO 句柄对象的预分配数量。
  */
-x_void_t x_tcp_io_holder_t::release_taskpool(void)
+x_void_t x_tcp_io_holder_t::reserve_objpool(x_uint32_t xut_count)
+{
+    _S_creator_objpool.reserve(xut_count);
+    _S_holder_objpool.reserve(xut_count);
+}
+
+/**********************************************************/
+/**
+ * @brief 释放 任务对象池、IO 句柄对象池 中缓存的对象。
+ */
+x_void_t x_tcp_io_holder_t::release_objpool(void)
 {
     x_io_task_t::taskpool().free_extra();
+    _S_creator_objpool.free_extra();
+    _S_holder_objpool.free_extra();
+}
+
+/**********************************************************/
+/**
+ * @brief 从对象池申请对象的内存（派生类对象则直接分配）。
+ */
+x_void_t * x_tcp_io_holder_t::operator new(size_t xst_size)
+{
+    if (sizeof(x_tcp_io_holder_t) != xst_size)
+    {
+        return ::operator new(xst_size);
+    }
+
+    return _S_holder_objpool.alloc_mem();
+}
+
+/**********************************************************/
+/**
+ * @brief 将对象的内存回收至对象池。
+ */
+x_void_t x_tcp_io_holder_t::operator delete(x_void_t * xobj_ptr, size_t xst_size)
+{
+    if (sizeof(x_tcp_io_holder_t) != xst_size)
+    {
+        ::operator delete(xobj_ptr);
+        return;
+    }
+
+    _S_holder_objpool.recyc_mem((x_tcp_io_holder_t *)xobj_ptr);
 }
 
 //====================================================================
@@ -996,6 +1182,17 @@ x_int32_t x_tcp_io_holder_t::io_writing(x_handle_t xht_manager, x_sockfd_t xfdt_
         XASSERT(nullptr != m_xio_csptr);
         XASSERT(xfdt_sockfd == m_xio_csptr->get_sockfd());
 
+        //======================================
+        // 去除 写就绪 事件（保留背压状态所对应的 读就绪 事件）
+
+        xit_error = m_xio_csptr->update_pollmask(X_FALSE);
+        if (0 != xit_error)
+        {
+            LOGE("[fd:%d] m_xio_csptr->update_pollmask(X_FALSE) return error : %d",
+                 xfdt_sockfd, xit_error);
+            break;
+        }
+
         //======================================
         // 提交 “业务层的 IO 写事件” 的业务处理任务
 
@@ -1009,3 +1206,50 @@ x_int32_t x_tcp_io_holder_t::io_writing(x_handle_t xht_manager, x_sockfd_t xfdt_
 
     return xit_error;
 }
+
+/**********************************************************/
+/**
+ * @brief 处理 套接字错误（EPOLLERR）事件（回收 MSG_ZEROCOPY 已完成写入的 IO 应答消息）。
+ * 
+ * @param [in ] xht_manager : IO 管理对象（x_tcp_io_manager_t）。
+ * @param [in ] xfdt_sockfd : 目标操作的套接字描述符。
+ * 
+ * @return x_int32_t
+ *         - 返回 0，表示套接字仍然有效；
+ *         - 返回 其他值（错误码），表示套接字已失效。
+ */
+x_int32_t x_tcp_io_holder_t::io_errqueue(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd)
+{
+    if ((X_NULL == xht_manager) || (X_INVALID_SOCKFD == xfdt_sockfd))
+    {
+        return -1;
+    }
+
+    XASSERT(nullptr != m_xio_csptr);
+    XASSERT(xfdt_sockfd == m_xio_csptr->get_sockfd());
+
+    return m_xio_csptr->zcopy_reaping();
+}
+
+/**********************************************************/
+/**
+ * @brief 读取所持有 IO 通道对象的运行统计信息快照。
+ * 
+ * @param [out] xio_cstat : 操作返回的运行统计信息。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE。
+ */
+x_bool_t x_tcp_io_holder_t::io_cstat(x_tcp_io_cstat_t & xio_cstat) const
+{
+    if (nullptr == m_xio_csptr)
+    {
+        return X_FALSE;
+    }
+
+    m_xio_csptr->get_cstat(xio_cstat);
+
+    return X_TRUE;
+}
+
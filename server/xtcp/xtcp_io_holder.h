@@ -96,6 +96,38 @@ public:
     {
         return 0;
     }
+
+    /**********************************************************/
+    /**
+     * @brief 处理 套接字错误（EPOLLERR）事件。
+     * @note  默认视为套接字已失效；IO 通道对象可借此读取错误队列中的 MSG_ZEROCOPY 完成通知。
+     * 
+     * @param [in ] xht_manager : IO 管理对象（x_tcp_io_manager_t）。
+     * @param [in ] xfdt_sockfd : 目标操作的套接字描述符。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示套接字仍然有效；
+     *         - 返回 其他值（错误码），表示套接字已失效，将被关闭。
+     */
+    virtual x_int32_t io_errqueue(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd)
+    {
+        return -1;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 读取所关联 IO 通道对象的运行统计信息快照。
+     * 
+     * @param [out] xio_cstat : 操作返回的运行统计信息。
+     * 
+     * @return x_bool_t
+     *         - 成功，返回 X_TRUE；
+     *         - 失败，返回 X_FALSE（尚未关联 IO 通道对象）。
+     */
+    virtual x_bool_t io_cstat(x_tcp_io_cstat_t & xio_cstat) const
+    {
+        return X_FALSE;
+    }
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -122,6 +154,20 @@ private:
     using x_io_cwptr_t = std::weak_ptr<   x_tcp_io_channel_t >;
     using x_io_csptr_t = std::shared_ptr< x_tcp_io_channel_t >;
 
+    // common invoking
+public:
+    /**********************************************************/
+    /**
+     * @brief 从对象池申请对象的内存（参看 x_tcp_io_holder_t::reserve_objpool()）。
+     */
+    static x_void_t * operator new(size_t xst_size);
+
+    /**********************************************************/
+    /**
+     * @brief 将对象的内存回收至对象池。
+     */
+    static x_void_t operator delete(x_void_t * xobj_ptr, size_t xst_size);
+
     // constructor/destructor
 public:
     explicit x_tcp_io_creator_t(void);
@@ -201,9 +247,29 @@ private:
 public:
     /**********************************************************/
     /**
-     * @brief 释放任务对象池中缓存的任务对象。
+     * @brief 预分配 IO 句柄对象（x_tcp_io_creator_t、x_tcp_io_holder_t）的对象池。
+     * 
+     * @param [in ] xut_count : 每种 IO 句柄对象的预分配数量。
+     */
+    static x_void_t reserve_objpool(x_uint32_t xut_count);
+
+    /**********************************************************/
+    /**
+     * @brief 释放 任务对象池、IO 句柄对象池 中缓存的对象。
+     */
+    static x_void_t release_objpool(void);
+
+    /**********************************************************/
+    /**
+     * @brief 从对象池申请对象的内存。
      */
-    static x_void_t release_taskpool(void);
+    static x_void_t * operator new(size_t xst_size);
+
+    /**********************************************************/
+    /**
+     * @brief 将对象的内存回收至对象池。
+     */
+    static x_void_t operator delete(x_void_t * xobj_ptr, size_t xst_size);
 
     // constructor/destructor
 public:
@@ -247,6 +313,31 @@ public:
      */
     virtual x_int32_t io_writing(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd) override;
 
+    /**********************************************************/
+    /**
+     * @brief 处理 套接字错误（EPOLLERR）事件（回收 MSG_ZEROCOPY 已完成写入的 IO 应答消息）。
+     * 
+     * @param [in ] xht_manager : IO 管理对象（x_tcp_io_manager_t）。
+     * @param [in ] xfdt_sockfd : 目标操作的套接字描述符。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示套接字仍然有效；
+     *         - 返回 其他值（错误码），表示套接字已失效。
+     */
+    virtual x_int32_t io_errqueue(x_handle_t xht_manager, x_sockfd_t xfdt_sockfd) override;
+
+    /**********************************************************/
+    /**
+     * @brief 读取所持有 IO 通道对象的运行统计信息快照。
+     * 
+     * @param [out] xio_cstat : 操作返回的运行统计信息。
+     * 
+     * @return x_bool_t
+     *         - 成功，返回 X_TRUE；
+     *         - 失败，返回 X_FALSE。
+     */
+    virtual x_bool_t io_cstat(x_tcp_io_cstat_t & xio_cstat) const override;
+
     // data members
 private:
     x_io_csptr_t m_xio_csptr;   ///< 持有的 IO 通道对象
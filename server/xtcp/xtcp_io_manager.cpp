@@ -26,10 +26,19 @@
 #include "xmaphandle.h"
 #include "xtcp_io_server.h"
 #include "xtcp_io_holder.h"
+#include "xtcp_io_tstat.h"
+
+#include <algorithm>
 
 ////////////////////////////////////////////////////////////////////////////////
 // x_tcp_io_manager_t
 
+/** 当前线程开启的任务提交缓存所属的 x_tcp_io_manager_t 对象 */
+static thread_local x_tcp_io_manager_t * _S_xsubmit_owner = X_NULL;
+
+/** 当前线程开启的任务提交缓存 */
+static thread_local x_tcp_io_manager_t::x_task_buffer_t * _S_xsubmit_buffer = X_NULL;
+
 //====================================================================
 
 // 
@@ -40,6 +49,7 @@ x_tcp_io_manager_t::x_tcp_io_manager_t(x_handle_t xht_tcpserver)
     : m_xht_tcpserver(xht_tcpserver)
     , m_xfunc_iocbk(X_NULL)
     , m_xht_cbk_ctxt(X_NULL)
+    , m_xbt_trimming(X_FALSE)
 {
     XVERIFY(X_NULL != (m_xht_mapsockfd = maptbl_create(ECV_MAPSOCK_CAPACITY)));
 }
@@ -60,13 +70,13 @@ x_tcp_io_manager_t::~x_tcp_io_manager_t(void)
 /**
  * @brief 启动 IO 管理模块。
  * 
- * @param [in ] xut_threads : 业务处理的工作线程的数量（若为 0，将取 hardware_concurrency() 返回值的 2倍 + 1）。
+ * @param [in ] xpoolconf : 业务处理的线程池的工作配置参数。
  * 
  * @return x_int32_t
  *         - 成功，返回 0；
  *         - 失败，返回 错误码。
  */
-x_int32_t x_tcp_io_manager_t::start(x_uint32_t xut_threads)
+x_int32_t x_tcp_io_manager_t::start(const x_poolconf_t & xpoolconf)
 {
     x_int32_t xit_error = -1;
 
@@ -79,16 +89,46 @@ x_int32_t x_tcp_io_manager_t::start(x_uint32_t xut_threads)
             stop();
         }
 
+        //======================================
+        // 设置线程池的调度模式（仅在首次启动前可进行设置）
+
+        if ((m_xthreadpool.is_affinity() != (0 != xpoolconf.xut_affinity)) &&
+            !m_xthreadpool.set_affinity((0 != xpoolconf.xut_affinity), xpoolconf.xut_rebalance))
+        {
+            LOGW("m_xthreadpool.set_affinity(xut_affinity[%d], xut_rebalance[%d]) return false!",
+                 xpoolconf.xut_affinity, xpoolconf.xut_rebalance);
+        }
+
+        //======================================
+        // 设置线程池的弹性伸缩参数
+
+        if (!m_xthreadpool.set_elastic(xpoolconf.xut_thds_min, xpoolconf.xut_thds_max, xpoolconf.xut_tmdelay))
+        {
+            LOGW("m_xthreadpool.set_elastic(xut_thds_min[%d], xut_thds_max[%d], xut_tmdelay[%d]) return false!",
+                 xpoolconf.xut_thds_min, xpoolconf.xut_thds_max, xpoolconf.xut_tmdelay);
+        }
+
         //======================================
         // 启动业务处理的线程池
 
-        if (!m_xthreadpool.startup(xut_threads))
+        if (!m_xthreadpool.startup(xpoolconf.xut_threads))
         {
-            LOGE("m_xthreadpool.startup(xut_threads[%d]) return false!", xut_threads);
+            LOGE("m_xthreadpool.startup(xut_threads[%d]) return false!", xpoolconf.xut_threads);
             xit_error = -1;
             break;
         }
 
+        //======================================
+        // 预分配 IO 句柄对象的对象池
+
+        x_tcp_io_holder_t::reserve_objpool(xpoolconf.xut_objpool);
+
+        //======================================
+        // 启动内存池后台整理线程
+
+        m_xbt_trimming = X_TRUE;
+        m_xthd_trimmer = x_thread_t([this](void) { trimmer_proc(); });
+
         //======================================
 
         xit_error = 0;
@@ -108,24 +148,40 @@ x_int32_t x_tcp_io_manager_t::start(x_uint32_t xut_threads)
  */
 x_void_t x_tcp_io_manager_t::stop(void)
 {
+    if (m_xthd_trimmer.joinable())
+    {
+        {
+            std::lock_guard< x_locker_t > xautolock(m_lock_trimmer);
+            m_xbt_trimming = X_FALSE;
+        }
+
+        m_xcnd_trimmer.notify_all();
+        m_xthd_trimmer.join();
+    }
+
     m_xthreadpool.shutdown();
     m_xthreadpool.cleanup_task();
     cleanup();
 
-    x_tcp_io_holder_t::release_taskpool();
+    x_tcp_io_holder_t::release_objpool();
     x_tcp_io_message_t::xmsg_mempool().release_timeout_memblock(0);
 }
 
 /**********************************************************/
 /**
- * @brief 注册套接字的 写就绪 事件。
+ * @brief 注册套接字所监听的 读就绪、写就绪 事件。
+ * @note  重新注册 读就绪 事件时，若套接字已有可读数据，epoll 会再次通知（边沿触发模式下亦然）。
+ * 
+ * @param [in ] xfdt_sockfd : 指定的套接字。
+ * @param [in ] xbt_pollin  : 是否监听 读就绪 事件。
+ * @param [in ] xbt_pollout : 是否监听 写就绪 事件。
  */
-x_int32_t x_tcp_io_manager_t::register_pollout(x_sockfd_t xfdt_sockfd)
+x_int32_t x_tcp_io_manager_t::register_pollmask(x_sockfd_t xfdt_sockfd, x_bool_t xbt_pollin, x_bool_t xbt_pollout)
 {
     XASSERT(X_NULL != m_xht_tcpserver);
     x_tcp_io_server_t * xserver_ptr = (x_tcp_io_server_t *)m_xht_tcpserver;
 
-    return xserver_ptr->set_pollout(xfdt_sockfd, X_TRUE);
+    return xserver_ptr->set_pollmask(xfdt_sockfd, xbt_pollin, xbt_pollout);
 }
 
 /**********************************************************/
@@ -164,18 +220,278 @@ x_uint32_t x_tcp_io_manager_t::count(void) const
     return (x_uint32_t)maptbl_count(m_xht_mapsockfd);
 }
 
+/**********************************************************/
+/**
+ * @brief 读取指定统计项排名前 N 位的 IO 通道对象的运行统计信息快照。
+ * 
+ * @param [in ] xut_counter : 排序所依据的统计项（参看 emIoChannelCounter 枚举值）。
+ * @param [in ] xut_topn    : 返回的最大数量。
+ * @param [out] xvec_cstat  : 操作返回的运行统计信息（按统计项的值降序排列）。
+ * 
+ * @return x_size_t
+ *         - 返回 xvec_cstat 中的数量。
+ */
+x_size_t x_tcp_io_manager_t::snapshot_top(x_uint32_t xut_counter,
+                                          x_uint32_t xut_topn,
+                                          std::vector< x_tcp_io_cstat_t > & xvec_cstat)
+{
+    /**
+     * @struct x_topn_ctxt_t
+     * @brief  遍历操作的上下文（xvec_cstat 以 最小堆 的方式保留前 N 位）。
+     */
+    struct x_topn_ctxt_t
+    {
+        x_uint32_t                        xut_counter;
+        x_uint32_t                        xut_topn;
+        std::vector< x_tcp_io_cstat_t > * xvec_cstat;
+
+        inline bool operator () (const x_tcp_io_cstat_t & xcst_lhs, const x_tcp_io_cstat_t & xcst_rhs) const
+        {
+            return (xcst_lhs.xult_value[xut_counter] > xcst_rhs.xult_value[xut_counter]);
+        }
+    } xtopn_ctxt = { xut_counter, xut_topn, &xvec_cstat };
+
+    xvec_cstat.clear();
+
+    if ((xut_counter >= EIO_CSTAT_COUNT) || (0 == xut_topn))
+    {
+        return 0;
+    }
+
+    xvec_cstat.reserve(xut_topn);
+
+    maptbl_trav(
+        m_xht_mapsockfd,
+        MAPTBL_INVALID_ITEMKEY,
+        MAPTBL_TIMEOUT_INFINIT,
+        [](x_handle_t xht_maptbl, x_size_t xst_itemkey, x_handle_t * xht_handler, x_handle_t xht_context) -> x_bool_t
+        {
+            x_topn_ctxt_t & xtopn_ctxt = *(x_topn_ctxt_t *)xht_context;
+            std::vector< x_tcp_io_cstat_t > & xvec_cstat = *xtopn_ctxt.xvec_cstat;
+
+            x_tcp_io_cstat_t xio_cstat;
+            if ((X_NULL == *xht_handler) || !((x_tcp_io_handler_t *)(*xht_handler))->io_cstat(xio_cstat))
+            {
+                return X_TRUE;
+            }
+
+            if (xvec_cstat.size() < xtopn_ctxt.xut_topn)
+            {
+                xvec_cstat.push_back(xio_cstat);
+                std::push_heap(xvec_cstat.begin(), xvec_cstat.end(), xtopn_ctxt);
+            }
+            else if (xtopn_ctxt(xio_cstat, xvec_cstat.front()))
+            {
+                std::pop_heap(xvec_cstat.begin(), xvec_cstat.end(), xtopn_ctxt);
+                xvec_cstat.back() = xio_cstat;
+                std::push_heap(xvec_cstat.begin(), xvec_cstat.end(), xtopn_ctxt);
+            }
+
+            return X_TRUE;
+        },
+        (x_handle_t)&xtopn_ctxt);
+
+    std::sort_heap(xvec_cstat.begin(), xvec_cstat.end(), xtopn_ctxt);
+
+    return xvec_cstat.size();
+}
+
+/**********************************************************/
+/**
+ * @brief 将指定统计项排名前 N 位的 IO 通道对象的运行统计信息输出至日志。
+ * 
+ * @param [in ] xut_counter : 排序所依据的统计项（参看 emIoChannelCounter 枚举值）。
+ * @param [in ] xut_topn    : 输出的最大数量。
+ */
+x_void_t x_tcp_io_manager_t::dump_cstat_log(x_uint32_t xut_counter, x_uint32_t xut_topn)
+{
+    std::vector< x_tcp_io_cstat_t > xvec_cstat;
+
+    if (snapshot_top(xut_counter, xut_topn, xvec_cstat) <= 0)
+    {
+        return;
+    }
+
+    for (x_size_t xst_iter = 0; xst_iter < xvec_cstat.size(); ++xst_iter)
+    {
+        const x_tcp_io_cstat_t & xio_cstat = xvec_cstat[xst_iter];
+
+        LOGI("[cstat:%d #%d][fd:%d, %s:%d] rbytes[%llu] wbytes[%llu] rframes[%llu] wframes[%llu] "
+             "req[%llu, %llu bytes] res[%llu, %llu bytes] busy(us)[%llu] idle(ms)[%llu]",
+             xut_counter,
+             (x_int32_t)(xst_iter + 1),
+             xio_cstat.xfdt_sockfd,
+             sockfd_remote_ip(xio_cstat.xfdt_sockfd, LOG_BUF(64), 64),
+             sockfd_remote_port(xio_cstat.xfdt_sockfd),
+             xio_cstat.xult_value[EIO_CSTAT_RBYTES    ],
+             xio_cstat.xult_value[EIO_CSTAT_WBYTES    ],
+             xio_cstat.xult_value[EIO_CSTAT_RFRAMES   ],
+             xio_cstat.xult_value[EIO_CSTAT_WFRAMES   ],
+             xio_cstat.xult_value[EIO_CSTAT_REQ_QSIZE ],
+             xio_cstat.xult_value[EIO_CSTAT_REQ_QBYTES],
+             xio_cstat.xult_value[EIO_CSTAT_RES_QSIZE ],
+             xio_cstat.xult_value[EIO_CSTAT_RES_QBYTES],
+             xio_cstat.xult_value[EIO_CSTAT_BUSY_US   ],
+             xio_cstat.xult_value[EIO_CSTAT_IDLE_MS   ]);
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 将 IO 消息内存池的统计信息输出至日志：总体的内存大小、线程本地缓存命中率，
+ *        以及各个尺寸级别的 slab/内存块 数量、申请速率（相对上次输出）、对齐浪费的比例。
+ */
+x_void_t x_tcp_io_manager_t::dump_mempool_log(void)
+{
+    using x_clock_t = std::chrono::steady_clock;
+
+    x_mempool_t & xmempool = x_tcp_io_message_t::xmsg_mempool();
+
+    x_mempool_t::x_mpstat_t xstat[x_mempool_t::ECV_CLASS_COUNT + 1];
+    x_uint32_t xut_count = xmempool.snapshot(xstat, x_mempool_t::ECV_CLASS_COUNT + 1);
+
+    x_clock_t::time_point xtm_now = x_clock_t::now();
+    x_uint64_t xult_elapsed_ms = 0;
+    if (m_xvec_mpnalloc.size() == xut_count)
+    {
+        xult_elapsed_ms = (x_uint64_t)std::chrono::duration_cast< std::chrono::milliseconds >(
+                                                                  xtm_now - m_xtm_mpstat).count();
+    }
+    else
+    {
+        m_xvec_mpnalloc.assign(xut_count, 0);
+    }
+
+    //======================================
+
+    x_uint64_t xult_hits = xmempool.tcache_hits();
+    x_uint64_t xult_miss = xmempool.tcache_misses();
+
+    LOGI("[mempool] nodes[%u] alloc(KB)[%llu] recyc(KB)[%llu] tcache[hits:%llu, misses:%llu, ratio:%llu.%02llu%%]",
+         xmempool.numa_nodes(),
+         (x_uint64_t)xmempool.alloc_size() / 1024,
+         (x_uint64_t)xmempool.recyc_size() / 1024,
+         xult_hits,
+         xult_miss,
+         (xult_hits + xult_miss) ? (xult_hits * 10000 / (xult_hits + xult_miss)) / 100 : 0,
+         (xult_hits + xult_miss) ? (xult_hits * 10000 / (xult_hits + xult_miss)) % 100 : 0);
+
+    for (x_uint32_t xut_iter = 0; xut_iter < xut_count; ++xut_iter)
+    {
+        const x_mempool_t::x_mpstat_t & xmpstat = xstat[xut_iter];
+        if ((0 == xmpstat.mst_nslab) && (xmpstat.ullt_nalloc == m_xvec_mpnalloc[xut_iter]))
+        {
+            continue;
+        }
+
+        // 对齐浪费的比例（万分比）
+        x_uint64_t xult_waste = (xmpstat.ullt_abytes > 0) ?
+                                (xmpstat.ullt_abytes - xmpstat.ullt_rbytes) * 10000 / xmpstat.ullt_abytes : 0;
+        x_uint64_t xult_rate  = (xult_elapsed_ms > 0) ?
+                                (xmpstat.ullt_nalloc - m_xvec_mpnalloc[xut_iter]) * 1000 / xult_elapsed_ms : 0;
+
+        LOGI("[mempool:%d] csize[%llu] slabs[%llu] live[%llu] free[%llu] peak[%llu] "
+             "allocs[%llu] rate(/s)[%llu] waste[%llu.%02llu%%] remote[%llu]",
+             xut_iter,
+             (x_uint64_t)xmpstat.mst_csize,
+             (x_uint64_t)xmpstat.mst_nslab,
+             (x_uint64_t)xmpstat.mst_nlive,
+             (x_uint64_t)xmpstat.mst_nfree,
+             (x_uint64_t)xmpstat.mst_npeak,
+             xmpstat.ullt_nalloc,
+             xult_rate,
+             xult_waste / 100,
+             xult_waste % 100,
+             xmpstat.ullt_remote);
+
+        m_xvec_mpnalloc[xut_iter] = xmpstat.ullt_nalloc;
+    }
+
+    m_xtm_mpstat = xtm_now;
+}
+
 /**********************************************************/
 /**
  * @brief 提交 IO 处理的任务对象。
  */
 x_void_t x_tcp_io_manager_t::submit_io_task(x_task_ptr_t xtask_ptr)
 {
-    if (m_xthreadpool.is_startup())
+    if (this == _S_xsubmit_owner)
+    {
+        _S_xsubmit_buffer->push_back(xtask_ptr);
+    }
+    else if (m_xthreadpool.is_startup())
     {
         m_xthreadpool.submit_task(xtask_ptr);
     }
 }
 
+/**********************************************************/
+/**
+ * @brief 为当前线程开启任务提交缓存。
+ */
+x_bool_t x_tcp_io_manager_t::open_submit_buffer(x_task_buffer_t & xtask_buffer)
+{
+    if (X_NULL != _S_xsubmit_owner)
+    {
+        return X_FALSE;
+    }
+
+    _S_xsubmit_owner  = this;
+    _S_xsubmit_buffer = &xtask_buffer;
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 将当前线程的任务提交缓存中的任务对象，批量提交至线程池。
+ */
+x_void_t x_tcp_io_manager_t::flush_submit_buffer(void)
+{
+    if ((this != _S_xsubmit_owner) || _S_xsubmit_buffer->empty())
+    {
+        return;
+    }
+
+    if (m_xthreadpool.is_startup())
+    {
+        m_xthreadpool.submit_tasks(_S_xsubmit_buffer->begin(), _S_xsubmit_buffer->end());
+    }
+    else
+    {
+        // 线程池未启动，则直接回收任务对象
+        x_threadpool_t::x_task_deleter_t * xdeleter_ptr = X_NULL;
+
+        for (x_task_ptr_t xtask_ptr : *_S_xsubmit_buffer)
+        {
+            if (nullptr == xtask_ptr)
+                continue;
+
+            xdeleter_ptr = const_cast< x_threadpool_t::x_task_deleter_t * >(xtask_ptr->get_deleter());
+            if (X_NULL != xdeleter_ptr)
+                xdeleter_ptr->delete_task(xtask_ptr);
+        }
+    }
+
+    _S_xsubmit_buffer->clear();
+}
+
+/**********************************************************/
+/**
+ * @brief 提交缓存中剩余的任务对象，并关闭当前线程的任务提交缓存。
+ */
+x_void_t x_tcp_io_manager_t::close_submit_buffer(void)
+{
+    if (this == _S_xsubmit_owner)
+    {
+        flush_submit_buffer();
+
+        _S_xsubmit_owner  = X_NULL;
+        _S_xsubmit_buffer = X_NULL;
+    }
+}
+
 /**********************************************************/
 /**
  * @brief 回调方式创建业务层工作对象。
@@ -472,12 +788,71 @@ x_int32_t x_tcp_io_manager_t::io_event_write(x_sockfd_t xfdt_sockfd)
     return xit_error;
 }
 
+/**********************************************************/
+/**
+ * @brief 处理 套接字错误（EPOLLERR）事件 的操作接口。
+ * 
+ * @param [in ] xfdt_sockfd : 触发该事件的套接字描述符。
+ * 
+ * @return x_int32_t
+ *         - 返回 0，表示套接字仍然有效（如 仅为 MSG_ZEROCOPY 的完成通知）；
+ *         - 返回 其他值（错误码），表示套接字已失效。
+ */
+x_int32_t x_tcp_io_manager_t::io_event_errqueue(x_sockfd_t xfdt_sockfd)
+{
+    x_int32_t  xit_error   = -1;
+    x_handle_t xht_handler = X_NULL;
+
+    //======================================
+
+    do
+    {
+        xit_error = maptbl_lock(m_xht_mapsockfd, (x_size_t)xfdt_sockfd, &xht_handler, MAPTBL_TIMEOUT_INFINIT);
+        if (MAPTBL_ERR_SUCCESS != xit_error)
+        {
+            LOGE("maptbl_lock(m_xht_mapsockfd, (x_size_t)xfdt_sockfd[%d], ...) return error : %d",
+                 xfdt_sockfd, xit_error);
+            break;
+        }
+
+        if (X_NULL != xht_handler)
+        {
+            xit_error = ((x_tcp_io_handler_t *)xht_handler)->io_errqueue((x_handle_t)this, xfdt_sockfd);
+        }
+        else
+        {
+            xit_error = -1;
+        }
+
+        maptbl_unlock(m_xht_mapsockfd, (x_size_t)xfdt_sockfd);
+    } while (0);
+
+    //======================================
+
+    return xit_error;
+}
+
 /**********************************************************/
 /**
  * @brief 处理 定时巡检事件 的操作接口。
  */
 x_int32_t x_tcp_io_manager_t::io_event_verify(void)
 {
+    //======================================
+    // 输出 IO 任务对象的 排队延迟 与 执行时长 统计信息
+
+    x_tcp_io_tstat_t::dump_log();
+
+    //======================================
+    // 输出占用工作线程时长最多的 IO 通道对象的运行统计信息
+
+    dump_cstat_log(EIO_CSTAT_BUSY_US, ECV_CSTAT_LOG_TOPN);
+
+    //======================================
+    // 输出 IO 消息内存池的统计信息
+
+    dump_mempool_log();
+
     //======================================
 
     if (X_NULL != m_xfunc_iocbk)
@@ -529,6 +904,10 @@ x_bool_t x_tcp_io_manager_t::mapsockfd_cleanup(x_handle_t xht_maptbl, x_sockfd_t
  */
 x_void_t x_tcp_io_manager_t::cleanup(void)
 {
+    // 各个 IO 句柄对象析构时提交的 EIO_TASK_DESTROY 任务，统一批量提交
+    x_task_buffer_t xtask_buffer;
+    x_bool_t xbt_buffer = open_submit_buffer(xtask_buffer);
+
     maptbl_trav(
         m_xht_mapsockfd,
         0,
@@ -539,6 +918,34 @@ x_void_t x_tcp_io_manager_t::cleanup(void)
         },
         (x_handle_t)this);
 
+    if (xbt_buffer)
+    {
+        close_submit_buffer();
+    }
+
     maptbl_cleanup(m_xht_mapsockfd);
 }
 
+/**********************************************************/
+/**
+ * @brief 内存池后台整理线程的执行流程：每隔 ECV_TRIM_PERIOD 毫秒，
+ *        在 ECV_TRIM_BUDGET 微秒的时间预算内，释放 IO 消息内存池中空闲超时的 slab。
+ */
+x_void_t x_tcp_io_manager_t::trimmer_proc(void)
+{
+    std::unique_lock< x_locker_t > xunique_locker(m_lock_trimmer);
+
+    while (m_xbt_trimming)
+    {
+        m_xcnd_trimmer.wait_for(xunique_locker, std::chrono::milliseconds(ECV_TRIM_PERIOD));
+        if (!m_xbt_trimming)
+        {
+            break;
+        }
+
+        xunique_locker.unlock();
+        x_tcp_io_message_t::xmsg_mempool().trim(ECV_TRIM_RETAIN, ECV_TIMEOUT_MEMBLOCK / 1000, ECV_TRIM_BUDGET);
+        xunique_locker.lock();
+    }
+}
+
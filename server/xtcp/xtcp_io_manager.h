@@ -28,6 +28,10 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 
+struct x_tcp_io_cstat_t;
+
+////////////////////////////////////////////////////////////////////////////////
+
 /**
  * @enum  emIoEventCallback
  * @brief 套接字的 IO 事件回调通知码。
@@ -56,6 +60,7 @@ typedef struct x_tcp_io_create_args_t
     x_sockfd_t    xfdt_sockfd;  ///< 关联的套接字描述符
     x_handle_t    xht_message;  ///< 指向 x_tcp_io_message_t 对象
     x_handle_t    xht_channel;  ///< 完成回调操作时，设置该值为业务层具体的 x_tcp_io_channel_t 对象指针
+    x_handle_t    xht_csptr;    ///< 指向接收 IO 通道对象的 std::shared_ptr< x_tcp_io_channel_t > 对象（可直接赋值，如 以 std::allocate_shared() 创建；否则，以 xht_channel 构建）
 } x_tcp_io_create_args_t;
 
 /**
@@ -93,11 +98,34 @@ public:
     typedef enum emConstValue
     {
         ECV_MAPSOCK_CAPACITY  = 256 * 1024,        ///< 套接字映射表的目录容量
-        ECV_TIMEOUT_MEMBLOCK  = 3 * 3600 * 1000,   ///< 内存池中的内存块回收的超时时间（单位 毫秒）
+        ECV_TIMEOUT_MEMBLOCK  = 60 * 1000,         ///< 内存池中的内存块回收的超时时间（单位 毫秒）
+        ECV_CSTAT_LOG_TOPN    = 8,                 ///< 定时巡检时，输出至日志的 IO 通道对象数量（按占用时长排序）
+        ECV_TRIM_PERIOD       = 100,               ///< 内存池后台整理的周期（单位 毫秒）
+        ECV_TRIM_BUDGET       = 1000,              ///< 内存池后台整理每个周期的时间预算（单位 微秒）
+        ECV_TRIM_RETAIN       = 64 * 1024 * 1024,  ///< 内存池后台整理后保留的空闲内存大小
     } emConstValue;
 
+    /**
+     * @struct x_poolconf_t
+     * @brief  业务处理的线程池的工作配置参数。
+     */
+    typedef struct x_poolconf_t
+    {
+        x_uint32_t  xut_threads;    ///< 工作线程的（初始）数量（若为 0，将取 hardware_concurrency() 返回值的 2倍 + 1）
+        x_uint32_t  xut_affinity;   ///< 是否启用 亲和调度 模式（同一 IO 通道对象的任务固定在同一工作线程上执行）
+        x_uint32_t  xut_rebalance;  ///< 亲和调度模式下的负载均衡阈值（为 0 时，不进行负载均衡）
+        x_uint32_t  xut_thds_min;   ///< 弹性伸缩：工作线程数量的下限
+        x_uint32_t  xut_thds_max;   ///< 弹性伸缩：工作线程数量的上限（不大于下限时，不启用弹性伸缩）
+        x_uint32_t  xut_tmdelay;    ///< 弹性伸缩：任务排队延迟的目标值（单位 微秒，为 0 时，不启用弹性伸缩）
+        x_uint32_t  xut_objpool;    ///< IO 句柄对象（x_tcp_io_creator_t、x_tcp_io_holder_t）对象池的预分配数量
+    } x_poolconf_t;
+
+    /** 任务提交缓存的类型（参看 open_submit_buffer() 的说明） */
+    using x_task_buffer_t = std::vector< x_task_ptr_t >;
+
 private:
     using x_thread_t = std::thread;
+    using x_locker_t = std::mutex;
 
     // constructor/destructor
 public:
@@ -110,13 +138,13 @@ public:
     /**
      * @brief 启动 IO 管理模块。
      * 
-     * @param [in ] xut_threads : 业务处理的工作线程的数量（若为 0，将取 hardware_concurrency() 返回值的 2倍 + 1）。
+     * @param [in ] xpoolconf : 业务处理的线程池的工作配置参数。
      * 
      * @return x_int32_t
      *         - 成功，返回 0；
      *         - 失败，返回 错误码。
      */
-    x_int32_t start(x_uint32_t xut_threads);
+    x_int32_t start(const x_poolconf_t & xpoolconf);
 
     /**********************************************************/
     /**
@@ -142,9 +170,14 @@ public:
 
     /**********************************************************/
     /**
-     * @brief 注册套接字的 写就绪 事件。
+     * @brief 注册套接字所监听的 读就绪、写就绪 事件。
+     * @note  重新注册 读就绪 事件时，若套接字已有可读数据，epoll 会再次通知（边沿触发模式下亦然）。
+     * 
+     * @param [in ] xfdt_sockfd : 指定的套接字。
+     * @param [in ] xbt_pollin  : 是否监听 读就绪 事件。
+     * @param [in ] xbt_pollout : 是否监听 写就绪 事件。
      */
-    x_int32_t register_pollout(x_sockfd_t xfdt_sockfd);
+    x_int32_t register_pollmask(x_sockfd_t xfdt_sockfd, x_bool_t xbt_pollin, x_bool_t xbt_pollout);
 
     /**********************************************************/
     /**
@@ -164,12 +197,82 @@ public:
      */
     x_uint32_t count(void) const;
 
+    /**********************************************************/
+    /**
+     * @brief 读取指定统计项排名前 N 位的 IO 通道对象的运行统计信息快照。
+     * @note
+     * <pre>
+     *   逐个锁定映射表的索引段进行遍历，每次只占用一个索引段，且仅作统计项的原子读取，
+     *   不会长时间阻塞 IO 事件的投递；快照各项并非同一时刻读取，仅作诊断参考。
+     * </pre>
+     * 
+     * @param [in ] xut_counter : 排序所依据的统计项（参看 emIoChannelCounter 枚举值）。
+     * @param [in ] xut_topn    : 返回的最大数量。
+     * @param [out] xvec_cstat  : 操作返回的运行统计信息（按统计项的值降序排列）。
+     * 
+     * @return x_size_t
+     *         - 返回 xvec_cstat 中的数量。
+     */
+    x_size_t snapshot_top(x_uint32_t xut_counter,
+                          x_uint32_t xut_topn,
+                          std::vector< x_tcp_io_cstat_t > & xvec_cstat);
+
+    /**********************************************************/
+    /**
+     * @brief 将指定统计项排名前 N 位的 IO 通道对象的运行统计信息输出至日志。
+     * 
+     * @param [in ] xut_counter : 排序所依据的统计项（参看 emIoChannelCounter 枚举值）。
+     * @param [in ] xut_topn    : 输出的最大数量。
+     */
+    x_void_t dump_cstat_log(x_uint32_t xut_counter, x_uint32_t xut_topn);
+
+    /**********************************************************/
+    /**
+     * @brief 将 IO 消息内存池的统计信息输出至日志：总体的内存大小、线程本地缓存命中率，
+     *        以及各个尺寸级别的 slab/内存块 数量、申请速率（相对上次输出）、对齐浪费的比例。
+     */
+    x_void_t dump_mempool_log(void);
+
     /**********************************************************/
     /**
      * @brief 提交 IO 处理的任务对象。
+     * @note  若当前线程已开启任务提交缓存，则任务对象暂存于缓存中，
+     *        直至 flush_submit_buffer() 或 close_submit_buffer() 时批量提交。
      */
     x_void_t submit_io_task(x_task_ptr_t xtask_ptr);
 
+    /**********************************************************/
+    /**
+     * @brief 为当前线程开启任务提交缓存。
+     * 
+     * @note
+     * <pre>
+     *   开启后，当前线程内调用 submit_io_task() 提交的任务对象将暂存于 xtask_buffer 中，
+     *   由 flush_submit_buffer() 一次性提交至线程池（如 epoll_wait() 返回的每批事件处理完成后），
+     *   以减少线程池任务队列的加锁与唤醒次数。
+     *   在 close_submit_buffer() 调用前，xtask_buffer 对象须保持有效。
+     * </pre>
+     * 
+     * @param [in ] xtask_buffer : 任务提交缓存对象。
+     * 
+     * @return x_bool_t
+     *         - 成功，返回 X_TRUE；
+     *         - 失败，返回 X_FALSE（当前线程已开启任务提交缓存）。
+     */
+    x_bool_t open_submit_buffer(x_task_buffer_t & xtask_buffer);
+
+    /**********************************************************/
+    /**
+     * @brief 将当前线程的任务提交缓存中的任务对象，批量提交至线程池。
+     */
+    x_void_t flush_submit_buffer(void);
+
+    /**********************************************************/
+    /**
+     * @brief 提交缓存中剩余的任务对象，并关闭当前线程的任务提交缓存。
+     */
+    x_void_t close_submit_buffer(void);
+
     /**********************************************************/
     /**
      * @brief 回调方式创建业务层工作对象。
@@ -226,6 +329,18 @@ public:
      */
     x_int32_t io_event_write(x_sockfd_t xfdt_sockfd);
 
+    /**********************************************************/
+    /**
+     * @brief 处理 套接字错误（EPOLLERR）事件 的操作接口。
+     * 
+     * @param [in ] xfdt_sockfd : 触发该事件的套接字描述符。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示套接字仍然有效（如 仅为 MSG_ZEROCOPY 的完成通知）；
+     *         - 返回 其他值（错误码），表示套接字已失效。
+     */
+    x_int32_t io_event_errqueue(x_sockfd_t xfdt_sockfd);
+
     /**********************************************************/
     /**
      * @brief 处理 定时巡检事件 的操作接口。
@@ -254,6 +369,13 @@ protected:
      */
     x_void_t cleanup(void);
 
+    /**********************************************************/
+    /**
+     * @brief 内存池后台整理线程的执行流程：每隔 ECV_TRIM_PERIOD 毫秒，
+     *        在 ECV_TRIM_BUDGET 微秒的时间预算内，释放 IO 消息内存池中空闲超时的 slab。
+     */
+    x_void_t trimmer_proc(void);
+
     // data members
 private:
     x_handle_t      m_xht_tcpserver;   ///< 所隶属的 x_tcp_io_server_t 对象句柄
@@ -263,6 +385,14 @@ private:
     x_handle_t      m_xht_cbk_ctxt;    ///< 套接字 IO 事件回调通知的上下文句柄
 
     x_threadpool_t  m_xthreadpool;     ///< 负责驱动 业务层工作流程 的线程池
+
+    x_thread_t      m_xthd_trimmer;    ///< 内存池后台整理线程
+    x_bool_t        m_xbt_trimming;    ///< 内存池后台整理线程是否继续运行
+    x_locker_t      m_lock_trimmer;    ///< 内存池后台整理线程的同步操作锁
+    std::condition_variable m_xcnd_trimmer;  ///< 内存池后台整理线程的通知器（条件变量）
+
+    std::vector< x_uint64_t > m_xvec_mpnalloc;   ///< 上次输出内存池统计信息时，各个尺寸级别的累计申请次数
+    std::chrono::steady_clock::time_point m_xtm_mpstat;  ///< 上次输出内存池统计信息的时间点
 };
 
 ////////////////////////////////////////////////////////////////////////////////
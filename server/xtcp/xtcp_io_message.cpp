@@ -25,6 +25,9 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
+#include <limits.h>
+#include <new>
 
 ////////////////////////////////////////////////////////////////////////////////
 // x_tcp_io_message_t
@@ -35,8 +38,12 @@
 // x_tcp_io_message_t : common invoking
 // 
 
-// 所有 IO 消息对象共用的内存池
-x_mempool_t x_tcp_io_message_t::_S_xmpt_comm;
+// 所有 IO 消息对象共用的内存池（消息通常在 读取任务线程 申请，在 业务/写入 线程释放，启用线程本地缓存；
+// 启用 NUMA 模式时，各线程从所在节点的 slab 中申请，跨节点释放的内存块由所属节点惰性回收）
+x_mempool_t x_tcp_io_message_t::_S_xmpt_comm(
+    x_mempool_t::EMP_TCACHE |
+    (XTCP_IO_MSG_ARENA ? x_mempool_t::EMP_ARENA : 0) |
+    (XTCP_IO_MSG_NUMA  ? x_mempool_t::EMP_NUMA  : 0));
 
 //====================================================================
 
@@ -49,6 +56,10 @@ x_tcp_io_message_t::x_tcp_io_message_t(void)
     , m_xut_buf_size(0)
     , m_xut_msg_rlen(0)
     , m_xut_msg_wlen(0)
+    , m_xblk_dbuf(X_NULL)
+    , m_xblk_body(X_NULL)
+    , m_xct_body_dptr(X_NULL)
+    , m_xut_body_size(0)
 {
 
 }
@@ -58,11 +69,21 @@ x_tcp_io_message_t::x_tcp_io_message_t(x_uint32_t xut_buf_size)
     , m_xut_buf_size(0)
     , m_xut_msg_rlen(0)
     , m_xut_msg_wlen(0)
+    , m_xblk_dbuf(X_NULL)
+    , m_xblk_body(X_NULL)
+    , m_xct_body_dptr(X_NULL)
+    , m_xut_body_size(0)
 {
-    if (xut_buf_size > 0)
+    if (xut_buf_size > ECV_INLINE_SIZE)
     {
-        m_xut_buf_size = x_mempool_t::align_size(xut_buf_size);
-        XVERIFY(X_NULL != (m_xct_buf_dptr = xmsg_mempool().alloc(m_xut_buf_size)));
+        XVERIFY(X_NULL != (m_xblk_dbuf = alloc_dblock(xut_buf_size)));
+        m_xct_buf_dptr = m_xblk_dbuf->data();
+        m_xut_buf_size = m_xblk_dbuf->xut_size;
+    }
+    else if (xut_buf_size > 0)
+    {
+        m_xct_buf_dptr = m_xct_inline;
+        m_xut_buf_size = ECV_INLINE_SIZE;
     }
 }
 
@@ -71,11 +92,24 @@ x_tcp_io_message_t::x_tcp_io_message_t(x_uchar_t * xct_buf_dptr, x_uint32_t xut_
     , m_xut_buf_size(0)
     , m_xut_msg_rlen(0)
     , m_xut_msg_wlen(0)
+    , m_xblk_dbuf(X_NULL)
+    , m_xblk_body(X_NULL)
+    , m_xct_body_dptr(X_NULL)
+    , m_xut_body_size(0)
 {
     if ((X_NULL != xct_buf_dptr) && (xut_buf_size > 0))
     {
-        m_xut_buf_size = x_mempool_t::align_size(xut_buf_size);
-        XVERIFY(X_NULL != (m_xct_buf_dptr = xmsg_mempool().alloc(m_xut_buf_size)));
+        if (xut_buf_size > ECV_INLINE_SIZE)
+        {
+            XVERIFY(X_NULL != (m_xblk_dbuf = alloc_dblock(xut_buf_size)));
+            m_xct_buf_dptr = m_xblk_dbuf->data();
+            m_xut_buf_size = m_xblk_dbuf->xut_size;
+        }
+        else
+        {
+            m_xct_buf_dptr = m_xct_inline;
+            m_xut_buf_size = ECV_INLINE_SIZE;
+        }
 
         memcpy(m_xct_buf_dptr, xct_buf_dptr, xut_buf_size);
         m_xut_msg_rlen = xut_buf_size;
@@ -84,24 +118,33 @@ x_tcp_io_message_t::x_tcp_io_message_t(x_uchar_t * xct_buf_dptr, x_uint32_t xut_
 
 x_tcp_io_message_t::~x_tcp_io_message_t(void)
 {
-    if (X_NULL != m_xct_buf_dptr)
-    {
-        XVERIFY(xmsg_mempool().recyc(m_xct_buf_dptr));
-
-        m_xct_buf_dptr = X_NULL;
-        m_xut_buf_size = 0;
-        m_xut_msg_rlen = 0;
-        m_xut_msg_wlen = 0;
-    }
+    release();
 }
 
 x_tcp_io_message_t::x_tcp_io_message_t(x_tcp_io_message_t && xobject)
-    : m_xct_buf_dptr(X_NULL)
-    , m_xut_buf_size(0)
-    , m_xut_msg_rlen(0)
-    , m_xut_msg_wlen(0)
+    : m_xct_buf_dptr(xobject.m_xct_buf_dptr)
+    , m_xut_buf_size(xobject.m_xut_buf_size)
+    , m_xut_msg_rlen(xobject.m_xut_msg_rlen)
+    , m_xut_msg_wlen(xobject.m_xut_msg_wlen)
+    , m_xblk_dbuf(xobject.m_xblk_dbuf)
+    , m_xblk_body(xobject.m_xblk_body)
+    , m_xct_body_dptr(xobject.m_xct_body_dptr)
+    , m_xut_body_size(xobject.m_xut_body_size)
 {
-    *this = std::forward< x_tcp_io_message_t >(xobject);
+    if (xobject.is_inline())
+    {
+        copy_inline(xobject);
+    }
+
+    xobject.m_xct_buf_dptr = X_NULL;
+    xobject.m_xut_buf_size = 0;
+    xobject.m_xut_msg_rlen = 0;
+    xobject.m_xut_msg_wlen = 0;
+    xobject.m_xblk_dbuf    = X_NULL;
+
+    xobject.m_xblk_body      = X_NULL;
+    xobject.m_xct_body_dptr  = X_NULL;
+    xobject.m_xut_body_size  = 0;
 }
 
 x_tcp_io_message_t & x_tcp_io_message_t::operator = (x_tcp_io_message_t && xobject)
@@ -109,20 +152,34 @@ x_tcp_io_message_t & x_tcp_io_message_t::operator = (x_tcp_io_message_t && xobje
     if (this == &xobject)
         return *this;
 
-    if (X_NULL != m_xct_buf_dptr)
+    release();
+
+    if (xobject.is_inline())
     {
-        XVERIFY(xmsg_mempool().recyc(m_xct_buf_dptr));
+        copy_inline(xobject);
+    }
+    else
+    {
+        m_xct_buf_dptr = xobject.m_xct_buf_dptr;
+        m_xut_buf_size = xobject.m_xut_buf_size;
+        m_xut_msg_rlen = xobject.m_xut_msg_rlen;
+        m_xut_msg_wlen = xobject.m_xut_msg_wlen;
+        m_xblk_dbuf    = xobject.m_xblk_dbuf;
     }
 
-    m_xct_buf_dptr = xobject.m_xct_buf_dptr;
-    m_xut_buf_size = xobject.m_xut_buf_size;
-    m_xut_msg_rlen = xobject.m_xut_msg_rlen;
-    m_xut_msg_wlen = xobject.m_xut_msg_wlen;
+    m_xblk_body     = xobject.m_xblk_body;
+    m_xct_body_dptr = xobject.m_xct_body_dptr;
+    m_xut_body_size = xobject.m_xut_body_size;
 
     xobject.m_xct_buf_dptr = X_NULL;
     xobject.m_xut_buf_size = 0;
     xobject.m_xut_msg_rlen = 0;
     xobject.m_xut_msg_wlen = 0;
+    xobject.m_xblk_dbuf    = X_NULL;
+
+    xobject.m_xblk_body      = X_NULL;
+    xobject.m_xct_body_dptr  = X_NULL;
+    xobject.m_xut_body_size  = 0;
 
     return *this;
 }
@@ -132,6 +189,10 @@ x_tcp_io_message_t::x_tcp_io_message_t(const x_tcp_io_message_t & xobject)
     , m_xut_buf_size(0)
     , m_xut_msg_rlen(0)
     , m_xut_msg_wlen(0)
+    , m_xblk_dbuf(X_NULL)
+    , m_xblk_body(X_NULL)
+    , m_xct_body_dptr(X_NULL)
+    , m_xut_body_size(0)
 {
     *this = xobject;
 }
@@ -141,28 +202,34 @@ x_tcp_io_message_t & x_tcp_io_message_t::operator = (const x_tcp_io_message_t &
     if (this == &xobject)
         return *this;
 
-    if (X_NULL != m_xct_buf_dptr)
-    {
-        XVERIFY(xmsg_mempool().recyc(m_xct_buf_dptr));
+    release();
 
-        m_xct_buf_dptr = X_NULL;
-        m_xut_buf_size = 0;
-        m_xut_msg_rlen = 0;
-        m_xut_msg_wlen = 0;
+    // 内嵌缓存中的（小）数据，直接拷贝
+    if (xobject.is_inline())
+    {
+        copy_inline(xobject);
     }
-
-    if ((X_NULL != xobject.m_xct_buf_dptr) && (xobject.m_xut_buf_size > 0))
+    // 拷贝所得的对象共享同一数据块（不拷贝数据），
+    // 其容量截止于消息数据的结尾处，后续的 append() 操作将转为独占的数据块
+    else if (X_NULL != xobject.m_xblk_dbuf)
     {
-        m_xut_buf_size = x_mempool_t::align_size(xobject.m_xut_buf_size);
-        XVERIFY(X_NULL != (m_xct_buf_dptr = xmsg_mempool().alloc(m_xut_buf_size)));
-
-        if (xobject.m_xut_msg_rlen > 0)
-        {
-            memcpy(m_xct_buf_dptr, xobject.m_xct_buf_dptr, xobject.m_xut_msg_rlen);
-        }
+        xobject.m_xblk_dbuf->xut_refs.fetch_add(1, std::memory_order_relaxed);
 
+        m_xct_buf_dptr = xobject.m_xct_buf_dptr;
+        m_xut_buf_size = xobject.m_xut_msg_rlen;
         m_xut_msg_rlen = xobject.m_xut_msg_rlen;
         m_xut_msg_wlen = xobject.m_xut_msg_wlen;
+        m_xblk_dbuf    = xobject.m_xblk_dbuf;
+    }
+
+    // 数据体分段同样共享其数据块
+    if (X_NULL != xobject.m_xblk_body)
+    {
+        xobject.m_xblk_body->xut_refs.fetch_add(1, std::memory_order_relaxed);
+
+        m_xblk_body     = xobject.m_xblk_body;
+        m_xct_body_dptr = xobject.m_xct_body_dptr;
+        m_xut_body_size = xobject.m_xut_body_size;
     }
 
     return *this;
@@ -195,7 +262,7 @@ x_uint32_t x_tcp_io_message_t::nio_read(x_sockfd_t xfdt_sockfd, x_uint32_t xut_m
     {
         if (!is_readable())
         {
-            if (!grow_up((0 != m_xut_buf_size) ? m_xut_buf_size : x_mempool_t::ECV_ALLOC_SMALLER))
+            if (!reserve_rblock())
             {
                 break;
             }
@@ -242,7 +309,7 @@ x_uint32_t x_tcp_io_message_t::nio_read(x_sockfd_t xfdt_sockfd, x_uint32_t xut_m
 x_uint32_t x_tcp_io_message_t::nio_write(x_sockfd_t xfdt_sockfd, x_uint32_t xut_max_len, x_int32_t & xit_error)
 {
     x_uint32_t xut_count = 0;
-    x_int32_t  xit_bytes = 0;
+    x_uint32_t xut_bytes = 0;
 
     xit_error = 0;
     while (xut_count < xut_max_len)
@@ -252,26 +319,145 @@ x_uint32_t x_tcp_io_message_t::nio_write(x_sockfd_t xfdt_sockfd, x_uint32_t xut_
             break;
         }
 
-        xit_bytes = (x_int32_t)::send(xfdt_sockfd,
-                                      m_xct_buf_dptr + m_xut_msg_wlen,
-                                      m_xut_msg_rlen - m_xut_msg_wlen,
-                                      0);
-        if (-1 == xit_bytes)
+        // 数据头部 与 数据体分段 一并写入
+        xut_bytes = nio_writev(xfdt_sockfd, this, 1, xut_max_len - xut_count, xit_error);
+        if (0 != xit_error)
         {
-            if ((EAGAIN == errno) || (EWOULDBLOCK == errno) || (EINTR == errno))
-                xit_error = EAGAIN;
-            else
-                xit_error = errno;
             break;
         }
 
-        xut_count += xit_bytes;
-        m_xut_msg_wlen += xit_bytes;
+        xut_count += xut_bytes;
     }
 
     return xut_count;
 }
 
+/**********************************************************/
+/**
+ * @brief 以一次 sendmsg() 调用，将多个 IO 消息对象的（未写入）数据 聚合写入 非阻塞模式的套接字。
+ * @note  写入完成后，依序更新各个 IO 消息对象的 wlen() 值，
+ *        调用方可据此判断哪些 IO 消息对象已完成写入（!is_writable()）。
+ * 
+ * @param [in ] xfdt_sockfd : 目标操作的非阻塞套接字。
+ * @param [in ] xmsg_array  : IO 消息对象数组。
+ * @param [in ] xut_count   : IO 消息对象数量（每个 IO 消息的 数据头部 与 数据体分段 各占一个 iovec，
+ *                           超出 IOV_MAX 的部分，本次不写入）。
+ * @param [in ] xut_max_len : 限制操作的数据最大长度（字节数）。
+ * @param [out] xit_error   : 操作返回的错误码。
+ * @param [in ] xit_mflags  : sendmsg() 的附加标识（如 MSG_ZEROCOPY）。
+ * 
+ * @return x_uint32_t
+ *         - 返回已写入的字节数。
+ */
+x_uint32_t x_tcp_io_message_t::nio_writev(x_sockfd_t xfdt_sockfd,
+                                          x_tcp_io_message_t * xmsg_array,
+                                          x_uint32_t xut_count,
+                                          x_uint32_t xut_max_len,
+                                          x_int32_t & xit_error,
+                                          x_int32_t xit_mflags)
+{
+#ifdef IOV_MAX
+    const x_uint32_t xut_iov_max = (IOV_MAX < ECV_WRITEV_MAX) ? IOV_MAX : ECV_WRITEV_MAX;
+#else // !IOV_MAX
+    const x_uint32_t xut_iov_max = ECV_WRITEV_MAX;
+#endif // IOV_MAX
+
+    struct iovec xiov_array[xut_iov_max];
+    x_uint32_t   xut_niov  = 0;
+    x_uint32_t   xut_total = 0;
+    x_uint32_t   xut_iter  = 0;
+    x_uint32_t   xut_wlen  = 0;
+    ssize_t      xst_bytes = 0;
+
+    xit_error = 0;
+
+    //======================================
+    // 组装 iovec 数组（受 IOV_MAX 与 xut_max_len 的双重限制）
+
+    for (xut_iter = 0; (xut_iter < xut_count) && (xut_niov < xut_iov_max) && (xut_total < xut_max_len); ++xut_iter)
+    {
+        x_tcp_io_message_t & xio_message = xmsg_array[xut_iter];
+        if (!xio_message.is_writable())
+        {
+            continue;
+        }
+
+        // 数据头部（未写入的部分）
+        if (xio_message.m_xut_msg_wlen < xio_message.m_xut_msg_rlen)
+        {
+            xut_wlen = xio_message.m_xut_msg_rlen - xio_message.m_xut_msg_wlen;
+            if (xut_wlen > (xut_max_len - xut_total))
+                xut_wlen = xut_max_len - xut_total;
+
+            xiov_array[xut_niov].iov_base = xio_message.m_xct_buf_dptr + xio_message.m_xut_msg_wlen;
+            xiov_array[xut_niov].iov_len  = xut_wlen;
+            xut_niov  += 1;
+            xut_total += xut_wlen;
+        }
+
+        // 数据体分段（未写入的部分）
+        if ((xio_message.m_xut_body_size > 0) && (xut_niov < xut_iov_max) && (xut_total < xut_max_len))
+        {
+            x_uint32_t xut_boff = (xio_message.m_xut_msg_wlen > xio_message.m_xut_msg_rlen) ?
+                                  (xio_message.m_xut_msg_wlen - xio_message.m_xut_msg_rlen) : 0;
+
+            xut_wlen = xio_message.m_xut_body_size - xut_boff;
+            if (xut_wlen > (xut_max_len - xut_total))
+                xut_wlen = xut_max_len - xut_total;
+
+            xiov_array[xut_niov].iov_base = xio_message.m_xct_body_dptr + xut_boff;
+            xiov_array[xut_niov].iov_len  = xut_wlen;
+            xut_niov  += 1;
+            xut_total += xut_wlen;
+        }
+    }
+
+    if (0 == xut_niov)
+    {
+        return 0;
+    }
+
+    //======================================
+    // 执行写操作
+
+    struct msghdr xmsg_hdr;
+    memset(&xmsg_hdr, 0, sizeof(struct msghdr));
+    xmsg_hdr.msg_iov    = xiov_array;
+    xmsg_hdr.msg_iovlen = xut_niov;
+
+    do
+    {
+        xst_bytes = ::sendmsg(xfdt_sockfd, &xmsg_hdr, xit_mflags);
+    } while ((-1 == xst_bytes) && (EINTR == errno));
+
+    if (-1 == xst_bytes)
+    {
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+            xit_error = EAGAIN;
+        else
+            xit_error = errno;
+        return 0;
+    }
+
+    //======================================
+    // 依序更新各个 IO 消息对象已写入的数据长度（处理部分写入的情况）
+
+    xut_total = (x_uint32_t)xst_bytes;
+    for (xut_iter = 0; (xut_iter < xut_count) && (xut_total > 0); ++xut_iter)
+    {
+        x_tcp_io_message_t & xio_message = xmsg_array[xut_iter];
+
+        xut_wlen = xio_message.tlen() - xio_message.m_xut_msg_wlen;
+        if (xut_wlen > xut_total)
+            xut_wlen = xut_total;
+
+        xio_message.m_xut_msg_wlen += xut_wlen;
+        xut_total -= xut_wlen;
+    }
+
+    return (x_uint32_t)xst_bytes;
+}
+
 /**********************************************************/
 /**
  * @brief 与另外的 IO 消息对象交换数据。
@@ -286,6 +472,97 @@ x_void_t x_tcp_io_message_t::swap(x_tcp_io_message_t & xobject)
     *this   = std::move(xswap_object);
 }
 
+/**********************************************************/
+/**
+ * @brief 切分出 [xut_offset, xut_offset + xut_length) 区间的数据，作为新的 IO 消息对象。
+ * @note  返回的是共享当前数据块的视图消息（不拷贝数据）；
+ *        若当前对象的数据存放于内嵌缓存中，则返回拷贝数据的 IO 消息对象。
+ * 
+ * @param [in ] xut_offset : 区间的起始偏移位置。
+ * @param [in ] xut_length : 区间的数据长度。
+ * 
+ * @return x_tcp_io_message_t
+ *         - 返回切分出的 IO 消息对象（区间越界时，返回空对象）。
+ */
+x_tcp_io_message_t x_tcp_io_message_t::slice(x_uint32_t xut_offset, x_uint32_t xut_length) const
+{
+    if ((0 == xut_length) || (xut_offset > m_xut_msg_rlen) || (xut_length > (m_xut_msg_rlen - xut_offset)))
+    {
+        return x_tcp_io_message_t();
+    }
+
+    if (is_inline())
+    {
+        return x_tcp_io_message_t(m_xct_buf_dptr + xut_offset, xut_length);
+    }
+
+    m_xblk_dbuf->xut_refs.fetch_add(1, std::memory_order_relaxed);
+
+    x_tcp_io_message_t xio_message;
+    xio_message.m_xct_buf_dptr = m_xct_buf_dptr + xut_offset;
+    xio_message.m_xut_buf_size = xut_length;
+    xio_message.m_xut_msg_rlen = xut_length;
+    xio_message.m_xut_msg_wlen = 0;
+    xio_message.m_xblk_dbuf    = m_xblk_dbuf;
+
+    return xio_message;
+}
+
+/**********************************************************/
+/**
+ * @brief 丢弃消息数据头部 xut_length 个字节（如 分包操作 后，丢弃已被切分出去的数据）。
+ */
+x_void_t x_tcp_io_message_t::discard(x_uint32_t xut_length)
+{
+    if (xut_length > m_xut_msg_rlen)
+    {
+        xut_length = m_xut_msg_rlen;
+    }
+
+    if (0 == xut_length)
+    {
+        return;
+    }
+
+    // 仅前移数据区的起始位置（被丢弃的数据可能仍被视图消息引用），
+    // 头部空闲的空间由 reserve_rblock() 进行整理
+    m_xct_buf_dptr += xut_length;
+    m_xut_buf_size -= xut_length;
+
+    m_xut_msg_rlen -= xut_length;
+    m_xut_msg_wlen  = (m_xut_msg_wlen > xut_length) ? (m_xut_msg_wlen - xut_length) : 0;
+}
+
+/**********************************************************/
+/**
+ * @brief 若数据存放于内嵌缓存中，则转存至数据块。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE（内存分配失败）。
+ */
+x_bool_t x_tcp_io_message_t::pin_dblock(void)
+{
+    if (!is_inline() || (0 == m_xut_msg_rlen))
+    {
+        return X_TRUE;
+    }
+
+    x_dblock_t * xblk_new = alloc_dblock(m_xut_buf_size);
+    if (X_NULL == xblk_new)
+    {
+        return X_FALSE;
+    }
+
+    memcpy(xblk_new->data(), m_xct_buf_dptr, m_xut_msg_rlen);
+
+    m_xct_buf_dptr = xblk_new->data();
+    m_xut_buf_size = xblk_new->xut_size;
+    m_xblk_dbuf    = xblk_new;
+
+    return X_TRUE;
+}
+
 /**********************************************************/
 /**
  * @brief 附加缓存数据到消息数据的结尾处。
@@ -303,9 +580,10 @@ x_uint32_t x_tcp_io_message_t::append(x_uchar_t * xct_buf_dptr, x_uint32_t xut_b
         return 0;
     }
 
-    if ((m_xut_msg_rlen + xut_buf_size) > m_xut_buf_size)
+    // 容量不足，或者数据块被共享（写入操作不可影响其他共享者），则转为独占的新数据块
+    if (((m_xut_msg_rlen + xut_buf_size) > m_xut_buf_size) || is_shared())
     {
-        if (!grow_up((m_xut_msg_rlen + xut_buf_size) - m_xut_buf_size))
+        if (!grow_up(limit_lower(m_xut_msg_rlen + xut_buf_size, m_xut_buf_size) - m_xut_buf_size))
         {
             return 0;
         }
@@ -317,6 +595,54 @@ x_uint32_t x_tcp_io_message_t::append(x_uchar_t * xct_buf_dptr, x_uint32_t xut_b
     return xut_buf_size;
 }
 
+/**********************************************************/
+/**
+ * @brief 设置数据体分段（链接于数据头部之后，共享 xmsg_body 的数据块，不拷贝数据）。
+ * @note
+ * <pre>
+ *   1. 若 xmsg_body 的数据存放于内嵌缓存中（小数据），则直接附加至数据头部的结尾处；
+ *   2. 写操作（nio_write()/nio_writev()）依序写入 数据头部 与 数据体分段，
+ *      wlen() 为两者合计的已写入长度，tlen() 为两者合计的数据长度；
+ *   3. 其他的数据操作（data()/rlen()/append()/slice()/discard() 等），仅作用于数据头部。
+ * </pre>
+ * 
+ * @param [in ] xmsg_body : 数据体的 IO 消息对象（其自身不可再带有数据体分段）。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE。
+ */
+x_bool_t x_tcp_io_message_t::set_body(const x_tcp_io_message_t & xmsg_body)
+{
+    if ((this == &xmsg_body) || (X_NULL != xmsg_body.m_xblk_body))
+    {
+        return X_FALSE;
+    }
+
+    unref_dblock(m_xblk_body);
+    m_xblk_body     = X_NULL;
+    m_xct_body_dptr = X_NULL;
+    m_xut_body_size = 0;
+
+    if (xmsg_body.is_empty())
+    {
+        return X_TRUE;
+    }
+
+    if (X_NULL == xmsg_body.m_xblk_dbuf)
+    {
+        return (xmsg_body.rlen() == append((x_uchar_t *)xmsg_body.data(), xmsg_body.rlen()));
+    }
+
+    xmsg_body.m_xblk_dbuf->xut_refs.fetch_add(1, std::memory_order_relaxed);
+
+    m_xblk_body     = xmsg_body.m_xblk_dbuf;
+    m_xct_body_dptr = xmsg_body.m_xct_buf_dptr;
+    m_xut_body_size = xmsg_body.m_xut_msg_rlen;
+
+    return X_TRUE;
+}
+
 //====================================================================
 
 // 
@@ -325,34 +651,159 @@ x_uint32_t x_tcp_io_message_t::append(x_uchar_t * xct_buf_dptr, x_uint32_t xut_b
 
 /**********************************************************/
 /**
- * @brief 扩大数据缓存。
+ * @brief 申请数据块（数据块头部 与 数据区 为同一块内存，由共用的内存池分配）。
+ * 
+ * @param [in ] xut_size : 数据区的最小容量。
+ * 
+ * @return x_dblock_t *
+ *         - 成功，返回 数据块（引用计数为 1）；
+ *         - 失败，返回 X_NULL。
+ */
+x_tcp_io_message_t::x_dblock_t * x_tcp_io_message_t::alloc_dblock(x_uint32_t xut_size)
+{
+    x_uint32_t  xut_blk_size = x_mempool_t::align_size(sizeof(x_dblock_t) + xut_size);
+    x_uchar_t * xct_blk_dptr = xmsg_mempool().alloc(xut_blk_size);
+    if (X_NULL == xct_blk_dptr)
+    {
+        return X_NULL;
+    }
+
+    x_dblock_t * xblk_dbuf = new (xct_blk_dptr) x_dblock_t;
+    xblk_dbuf->xut_refs.store(1, std::memory_order_relaxed);
+    xblk_dbuf->xut_size = xut_blk_size - sizeof(x_dblock_t);
+
+    return xblk_dbuf;
+}
+
+/**********************************************************/
+/**
+ * @brief 递减数据块的引用计数，最后一个引用释放时回收至内存池。
+ */
+x_void_t x_tcp_io_message_t::unref_dblock(x_dblock_t * xblk_dbuf)
+{
+    if ((X_NULL != xblk_dbuf) && (1 == xblk_dbuf->xut_refs.fetch_sub(1, std::memory_order_acq_rel)))
+    {
+        xblk_dbuf->~x_dblock_t();
+        XVERIFY(xmsg_mempool().recyc((x_uchar_t *)xblk_dbuf));
+    }
+}
+
+/**********************************************************/
+/**
+ * @brief 扩大数据缓存（若数据块被共享，则转为独占的新数据块；扩大后的容量足够小时，转存至内嵌缓存）。
  */
 x_bool_t x_tcp_io_message_t::grow_up(x_uint32_t xut_grow_size)
 {
-    x_uint32_t  xut_new_size = m_xut_buf_size + xut_grow_size;
-    x_uchar_t * xct_new_dptr = X_NULL;
+    if ((0 == xut_grow_size) && !is_shared())
+    {
+        return X_TRUE;
+    }
 
-    if (0 == xut_grow_size)
+    // 扩大后的容量仍在内嵌缓存的容量范围内，则转存至内嵌缓存
+    if ((m_xut_buf_size + xut_grow_size) <= ECV_INLINE_SIZE)
     {
+        if ((X_NULL != m_xct_buf_dptr) && (m_xut_msg_rlen > 0))
+        {
+            memmove(m_xct_inline, m_xct_buf_dptr, m_xut_msg_rlen);
+        }
+
+        unref_dblock(m_xblk_dbuf);
+
+        m_xct_buf_dptr = m_xct_inline;
+        m_xut_buf_size = ECV_INLINE_SIZE;
+        m_xblk_dbuf    = X_NULL;
+
         return X_TRUE;
     }
 
-    xut_new_size = x_mempool_t::align_size(m_xut_buf_size + xut_grow_size);
-    xct_new_dptr = xmsg_mempool().alloc(xut_new_size);
-    if (X_NULL == xct_new_dptr)
+    x_dblock_t * xblk_new = alloc_dblock(m_xut_buf_size + xut_grow_size);
+    if (X_NULL == xblk_new)
     {
         return X_FALSE;
     }
 
-    if (X_NULL != m_xct_buf_dptr)
+    if ((X_NULL != m_xct_buf_dptr) && (m_xut_msg_rlen > 0))
     {
-        if (m_xut_msg_rlen > 0)
-            memcpy(xct_new_dptr, m_xct_buf_dptr, m_xut_msg_rlen);
-        XVERIFY(xmsg_mempool().recyc(m_xct_buf_dptr));
+        memcpy(xblk_new->data(), m_xct_buf_dptr, m_xut_msg_rlen);
     }
 
-    m_xct_buf_dptr = xct_new_dptr;
-    m_xut_buf_size = xut_new_size;
+    unref_dblock(m_xblk_dbuf);
+
+    m_xct_buf_dptr = xblk_new->data();
+    m_xut_buf_size = xblk_new->xut_size;
+    m_xblk_dbuf    = xblk_new;
 
     return X_TRUE;
 }
+
+/**********************************************************/
+/**
+ * @brief 为 nio_read() 准备数据块的可读空间。
+ */
+x_bool_t x_tcp_io_message_t::reserve_rblock(void)
+{
+    //======================================
+    // 数据块未被共享，且头部有空闲空间，则整理数据块（仅移动剩余的半包数据）
+
+    if (!is_shared() && (X_NULL != m_xblk_dbuf) && (m_xct_buf_dptr != m_xblk_dbuf->data()))
+    {
+        if (m_xut_msg_rlen > 0)
+        {
+            memmove(m_xblk_dbuf->data(), m_xct_buf_dptr, m_xut_msg_rlen);
+        }
+
+        m_xct_buf_dptr = m_xblk_dbuf->data();
+        m_xut_buf_size = m_xblk_dbuf->xut_size;
+
+        return X_TRUE;
+    }
+
+    //======================================
+    // 申请新的数据块（剩余数据已占满整个数据块时，容量翻倍）
+
+    x_uint32_t xut_new_size = limit_lower(2 * m_xut_msg_rlen, (x_uint32_t)ECV_RBLOCK_SIZE);
+    xut_new_size = limit_lower(xut_new_size, m_xut_buf_size);
+
+    return grow_up(xut_new_size - m_xut_buf_size);
+}
+
+/**********************************************************/
+/**
+ * @brief 拷贝另一对象内嵌缓存中的数据（及读写长度）至当前对象的内嵌缓存。
+ * @note  调用前，当前对象不可持有数据块。
+ */
+x_void_t x_tcp_io_message_t::copy_inline(const x_tcp_io_message_t & xobject)
+{
+    XASSERT(X_NULL == m_xblk_dbuf);
+
+    if (xobject.m_xut_msg_rlen > 0)
+    {
+        memcpy(m_xct_inline, xobject.m_xct_buf_dptr, xobject.m_xut_msg_rlen);
+    }
+
+    m_xct_buf_dptr = m_xct_inline;
+    m_xut_buf_size = ECV_INLINE_SIZE;
+    m_xut_msg_rlen = xobject.m_xut_msg_rlen;
+    m_xut_msg_wlen = xobject.m_xut_msg_wlen;
+    m_xblk_dbuf    = X_NULL;
+}
+
+/**********************************************************/
+/**
+ * @brief 释放数据缓存（递减数据块的引用计数，最后一个引用释放时回收至内存池）。
+ */
+x_void_t x_tcp_io_message_t::release(void)
+{
+    unref_dblock(m_xblk_dbuf);
+    unref_dblock(m_xblk_body);
+
+    m_xct_buf_dptr = X_NULL;
+    m_xut_buf_size = 0;
+    m_xut_msg_rlen = 0;
+    m_xut_msg_wlen = 0;
+    m_xblk_dbuf    = X_NULL;
+
+    m_xblk_body     = X_NULL;
+    m_xct_body_dptr = X_NULL;
+    m_xut_body_size = 0;
+}
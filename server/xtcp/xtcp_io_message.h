@@ -8,14 +8,44 @@
  * 文件标识：
  * 文件摘要：定义网络 IO 消息的接口类。
  * 
- * 当前版本：1.0.0.0
+ * 当前版本：1.6.0.0
  * 作    者：
- * 完成日期：2019年01月17日
- * 版本摘要：
+ * 完成日期：2019年03月23日
+ * 版本摘要：nio_writev() 增加 sendmsg() 的附加标识参数（用于 MSG_ZEROCOPY 写入）；
+ *          增加 pin_dblock() 接口，将内嵌缓存中的数据转存至数据块，保证数据地址在写入完成前不变。
+ * 
+ * 历史版本：1.5.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月21日
+ * 版本摘要：增加 数据体分段（set_body()）：IO 消息可由 数据头部 与 共享其他数据块的数据体 链接组成，
+ *          写操作时两者分别作为 iovec 写入，协议层封装数据体时无需拷贝数据。
+ * 
+ * 历史版本：1.4.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月20日
+ * 版本摘要：增加内嵌缓存（容量由 XTCP_IO_MSG_INLINE_SIZE 编译期指定），
+ *          数据长度不超过内嵌缓存容量的（小）消息，不再经由内存池分配数据缓存。
+ * 
+ * 历史版本：1.3.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月19日
+ * 版本摘要：所有数据缓存统一为带引用计数的数据块（x_dblock_t），拷贝操作仅共享数据块（不拷贝数据），
+ *          移动操作为 O(1) 的指针转移；写入共享的数据块时（append()/detach()），转为独占的新数据块。
+ * 
+ * 历史版本：1.2.0.0
+ * 原作者  ：
+ * 完成日期：2019年03月18日
+ * 版本摘要：增加 nio_writev() 接口，以一次 sendmsg() 聚合写入多个 IO 消息对象的数据。
  * 
- * 历史版本：
+ * 历史版本：1.1.0.0
  * 原作者  ：
- * 完成日期：
+ * 完成日期：2019年03月16日
+ * 版本摘要：增加 接收数据块（x_rblock_t）：nio_read() 读取的数据存放于带引用计数的接收数据块中，
+ *          分包时以 slice() 切分出共享该数据块的视图消息（零拷贝），数据块随最后一个引用释放。
+ * 
+ * 历史版本：1.0.0.0
+ * 原作者  ：
+ * 完成日期：2019年01月17日
  * 版本摘要：
  * </pre>
  */
@@ -24,6 +54,21 @@
 #define __XTCP_IO_MESSAGE_H__
 
 #include "xmempool.h"
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef XTCP_IO_MSG_INLINE_SIZE
+#define XTCP_IO_MSG_INLINE_SIZE 128   ///< IO 消息对象内嵌缓存的容量（字节数）
+#endif // XTCP_IO_MSG_INLINE_SIZE
+
+#ifndef XTCP_IO_MSG_ARENA
+#define XTCP_IO_MSG_ARENA       0     ///< IO 消息的内存池是否启用内存区域（大页内存）模式（默认为 0，即 不启用）
+#endif // XTCP_IO_MSG_ARENA
+
+#ifndef XTCP_IO_MSG_NUMA
+#define XTCP_IO_MSG_NUMA        0     ///< IO 消息的内存池是否启用 NUMA 模式（各节点独立的 slab，默认为 0，即 不启用）
+#endif // XTCP_IO_MSG_NUMA
 
 ////////////////////////////////////////////////////////////////////////////////
 // x_tcp_io_message_t
@@ -34,6 +79,37 @@
  */
 class x_tcp_io_message_t final
 {
+    // common data types
+public:
+    /**
+     * @enum  emConstValue
+     * @brief 相关的枚举常量值。
+     */
+    typedef enum emConstValue
+    {
+        ECV_RBLOCK_SIZE = 16 * 1024,   ///< 接收数据块的默认大小
+        ECV_INLINE_SIZE = XTCP_IO_MSG_INLINE_SIZE,  ///< 内嵌缓存的容量
+        ECV_WRITEV_MAX  = 1024,        ///< nio_writev() 单次聚合写入的 IO 消息对象最大数量（同时受 IOV_MAX 限制）
+    } emConstValue;
+
+private:
+    /**
+     * @struct x_dblock_t
+     * @brief  数据块（带引用计数，数据区紧随其后；由创建该数据块的消息对象，
+     *         以及 拷贝/slice() 所得的消息对象 共同持有）。
+     */
+    typedef struct x_dblock_t
+    {
+        std::atomic< x_uint32_t > xut_refs;  ///< 引用计数
+        x_uint32_t                xut_size;  ///< 数据区大小
+
+        /**********************************************************/
+        /**
+         * @brief 数据区地址。
+         */
+        inline x_uchar_t * data(void) { return (x_uchar_t *)(this + 1); }
+    } x_dblock_t;
+
     // constructor/destructor
 public:
     explicit x_tcp_io_message_t(void);
@@ -85,6 +161,31 @@ public:
      */
     x_uint32_t nio_write(x_sockfd_t xfdt_sockfd, x_uint32_t xut_max_len, x_int32_t & xit_error);
 
+    /**********************************************************/
+    /**
+     * @brief 以一次 sendmsg() 调用，将多个 IO 消息对象的（未写入）数据 聚合写入 非阻塞模式的套接字。
+     * @note  写入完成后，依序更新各个 IO 消息对象的 wlen() 值，
+     *        调用方可据此判断哪些 IO 消息对象已完成写入（!is_writable()）。
+     * 
+     * @param [in ] xfdt_sockfd : 目标操作的非阻塞套接字。
+     * @param [in ] xmsg_array  : IO 消息对象数组。
+     * @param [in ] xut_count   : IO 消息对象数量（每个 IO 消息的 数据头部 与 数据体分段 各占一个 iovec，
+     *                           超出 IOV_MAX 的部分，本次不写入）。
+     * @param [in ] xut_max_len : 限制操作的数据最大长度（字节数）。
+     * @param [out] xit_error   : 操作返回的错误码。
+     * @param [in ] xit_mflags  : sendmsg() 的附加标识（如 MSG_ZEROCOPY，此时调用方须保证
+     *                           所写入的数据在内核通知完成前不被释放/修改，参看 pin_dblock()）。
+     * 
+     * @return x_uint32_t
+     *         - 返回已写入的字节数。
+     */
+    static x_uint32_t nio_writev(x_sockfd_t xfdt_sockfd,
+                                 x_tcp_io_message_t * xmsg_array,
+                                 x_uint32_t xut_count,
+                                 x_uint32_t xut_max_len,
+                                 x_int32_t & xit_error,
+                                 x_int32_t xit_mflags = 0);
+
     /**********************************************************/
     /**
      * @brief 与另外的 IO 消息对象交换数据。
@@ -103,6 +204,91 @@ public:
      */
     x_uint32_t append(x_uchar_t * xct_buf_dptr, x_uint32_t xut_buf_size);
 
+    /**********************************************************/
+    /**
+     * @brief 设置数据体分段（链接于数据头部之后，共享 xmsg_body 的数据块，不拷贝数据）。
+     * @note
+     * <pre>
+     *   1. 若 xmsg_body 的数据存放于内嵌缓存中（小数据），则直接附加至数据头部的结尾处；
+     *   2. 写操作（nio_write()/nio_writev()）依序写入 数据头部 与 数据体分段，
+     *      wlen() 为两者合计的已写入长度，tlen() 为两者合计的数据长度；
+     *   3. 其他的数据操作（data()/rlen()/append()/slice()/discard() 等），仅作用于数据头部。
+     * </pre>
+     * 
+     * @param [in ] xmsg_body : 数据体的 IO 消息对象（其自身不可再带有数据体分段）。
+     * 
+     * @return x_bool_t
+     *         - 成功，返回 X_TRUE；
+     *         - 失败，返回 X_FALSE。
+     */
+    x_bool_t set_body(const x_tcp_io_message_t & xmsg_body);
+
+    /**********************************************************/
+    /**
+     * @brief 切分出 [xut_offset, xut_offset + xut_length) 区间的数据，作为新的 IO 消息对象。
+     * @note  返回的是共享当前数据块的视图消息（不拷贝数据）。
+     * 
+     * @param [in ] xut_offset : 区间的起始偏移位置。
+     * @param [in ] xut_length : 区间的数据长度。
+     * 
+     * @return x_tcp_io_message_t
+     *         - 返回切分出的 IO 消息对象（区间越界时，返回空对象）。
+     */
+    x_tcp_io_message_t slice(x_uint32_t xut_offset, x_uint32_t xut_length) const;
+
+    /**********************************************************/
+    /**
+     * @brief 丢弃消息数据头部 xut_length 个字节（如 分包操作 后，丢弃已被切分出去的数据）。
+     */
+    x_void_t discard(x_uint32_t xut_length);
+
+    /**********************************************************/
+    /**
+     * @brief 判断数据是否存放于内嵌缓存中。
+     */
+    inline x_bool_t is_inline(void) const
+    {
+        return ((X_NULL == m_xblk_dbuf) && (X_NULL != m_xct_buf_dptr));
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 返回数据块的引用计数（无数据块，或者数据存放于内嵌缓存中时，返回 0）。
+     */
+    inline x_uint32_t use_count(void) const
+    {
+        return (X_NULL != m_xblk_dbuf) ? m_xblk_dbuf->xut_refs.load(std::memory_order_acquire) : 0;
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 判断数据块是否被多个 IO 消息对象共享。
+     * @note  共享的数据只读，若需通过 data() 原地修改数据，应先调用 detach()。
+     */
+    inline x_bool_t is_shared(void) const { return (use_count() > 1); }
+
+    /**********************************************************/
+    /**
+     * @brief 若数据块被共享，则拷贝数据至独占的新数据块（写时拷贝）。
+     * 
+     * @return x_bool_t
+     *         - 成功，返回 X_TRUE；
+     *         - 失败，返回 X_FALSE（内存分配失败）。
+     */
+    inline x_bool_t detach(void) { return is_shared() ? grow_up(0) : X_TRUE; }
+
+    /**********************************************************/
+    /**
+     * @brief 若数据存放于内嵌缓存中，则转存至数据块。
+     * @note  内嵌缓存随 IO 消息对象移动/销毁，而数据块的数据地址在其引用释放前保持不变，
+     *        以 MSG_ZEROCOPY 写入前，可借此令拷贝的 IO 消息对象持有（内核所引用的）数据。
+     * 
+     * @return x_bool_t
+     *         - 成功，返回 X_TRUE；
+     *         - 失败，返回 X_FALSE（内存分配失败）。
+     */
+    x_bool_t pin_dblock(void);
+
     /**********************************************************/
     /**
      * @brief IO 消息对象的数据缓存。
@@ -129,10 +315,22 @@ public:
 
     /**********************************************************/
     /**
-     * @brief IO 消息对象已写入的数据长度（字节数）。
+     * @brief IO 消息对象已写入的数据长度（字节数，含数据体分段）。
      */
     inline x_uint32_t wlen(void) const { return m_xut_msg_wlen; }
 
+    /**********************************************************/
+    /**
+     * @brief 数据体分段的数据长度（字节数）。
+     */
+    inline x_uint32_t body_size(void) const { return m_xut_body_size; }
+
+    /**********************************************************/
+    /**
+     * @brief IO 消息对象待写入的数据总长度（字节数，rlen() + body_size()）。
+     */
+    inline x_uint32_t tlen(void) const { return (m_xut_msg_rlen + m_xut_body_size); }
+
     /**********************************************************/
     /**
      * @brief 是否可继续读取数据。
@@ -143,13 +341,13 @@ public:
     /**
      * @brief 是否可继续写入数据。
      */
-    inline x_bool_t is_writable(void) const { return (m_xut_msg_rlen > m_xut_msg_wlen); }
+    inline x_bool_t is_writable(void) const { return (tlen() > m_xut_msg_wlen); }
 
     /**********************************************************/
     /**
      * @brief 是否为空。
      */
-    inline x_bool_t is_empty(void) const { return (0 == m_xut_msg_rlen); }
+    inline x_bool_t is_empty(void) const { return (0 == tlen()); }
 
     /**********************************************************/
     /**
@@ -171,16 +369,57 @@ public:
 private:
     /**********************************************************/
     /**
-     * @brief 扩大数据缓存。
+     * @brief 申请数据块（引用计数为 1，数据区容量不小于 xut_size）。
+     */
+    static x_dblock_t * alloc_dblock(x_uint32_t xut_size);
+
+    /**********************************************************/
+    /**
+     * @brief 递减数据块的引用计数，最后一个引用释放时回收至内存池。
+     */
+    static x_void_t unref_dblock(x_dblock_t * xblk_dbuf);
+
+    /**********************************************************/
+    /**
+     * @brief 扩大数据缓存（若数据块被共享，则转为独占的新数据块；扩大后的容量足够小时，转存至内嵌缓存）。
      */
     x_bool_t grow_up(x_uint32_t xut_grow_size);
 
+    /**********************************************************/
+    /**
+     * @brief 为 nio_read() 准备数据块的可读空间。
+     * @note
+     * <pre>
+     *   1. 数据块未被共享时，将剩余的（半包）数据移至数据块头部；
+     *   2. 否则，申请新的数据块（剩余数据已占满整个数据块时，容量翻倍），
+     *      仅拷贝剩余的（半包）数据，旧的数据块随其视图消息的释放而回收。
+     * </pre>
+     */
+    x_bool_t reserve_rblock(void);
+
+    /**********************************************************/
+    /**
+     * @brief 拷贝另一对象内嵌缓存中的数据（及读写长度）至当前对象的内嵌缓存。
+     */
+    x_void_t copy_inline(const x_tcp_io_message_t & xobject);
+
+    /**********************************************************/
+    /**
+     * @brief 释放数据缓存（递减数据块的引用计数，最后一个引用释放时回收至内存池）。
+     */
+    x_void_t release(void);
+
     // data members
 private:
     x_uchar_t   * m_xct_buf_dptr;   ///< 数据缓存地址
     x_uint32_t    m_xut_buf_size;   ///< 数据缓存大小
     x_uint32_t    m_xut_msg_rlen;   ///< 消息可读取的数据长度
     x_uint32_t    m_xut_msg_wlen;   ///< 消息已写入的数据长度
+    x_dblock_t  * m_xblk_dbuf;      ///< 数据所在的数据块（m_xct_buf_dptr 指向其数据区内；为 X_NULL 时，数据存放于内嵌缓存）
+    x_dblock_t  * m_xblk_body;      ///< 数据体分段所在的数据块（为 X_NULL 时，无数据体分段）
+    x_uchar_t   * m_xct_body_dptr;  ///< 数据体分段的数据地址
+    x_uint32_t    m_xut_body_size;  ///< 数据体分段的数据长度
+    x_uchar_t     m_xct_inline[ECV_INLINE_SIZE];  ///< 内嵌缓存（存放小消息的数据）
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -312,11 +312,27 @@ x_int32_t x_tcp_io_server_t::startup(const x_workconf_t & xwct_config, x_sockfd_
             break;
         }
 
-        xit_error = m_xio_manager.start(m_xwct_config.xut_ioman_threads);
+        x_tcp_io_manager_t::x_poolconf_t xpoolconf;
+        xpoolconf.xut_threads   = m_xwct_config.xut_ioman_threads;
+        xpoolconf.xut_affinity  = m_xwct_config.xut_ioman_affinity;
+        xpoolconf.xut_rebalance = m_xwct_config.xut_ioman_rebalance;
+        xpoolconf.xut_thds_min  = m_xwct_config.xut_ioman_thds_min;
+        xpoolconf.xut_thds_max  = m_xwct_config.xut_ioman_thds_max;
+        xpoolconf.xut_tmdelay   = m_xwct_config.xut_ioman_tmdelay;
+        xpoolconf.xut_objpool   = objpool_count();
+
+        xit_error = m_xio_manager.start(xpoolconf);
         if (0 != xit_error)
         {
-            LOGE("m_xio_manager.startup(m_xwct_config.xut_ioman_threads[%d]) return error : %d",
-                 m_xwct_config.xut_ioman_threads, xit_error);
+            LOGE("m_xio_manager.startup(ioman_threads[%d], ioman_affinity[%d], ioman_rebalance[%d], "
+                 "ioman_threads_min[%d], ioman_threads_max[%d], ioman_delay_us[%d]) return error : %d",
+                 m_xwct_config.xut_ioman_threads,
+                 m_xwct_config.xut_ioman_affinity,
+                 m_xwct_config.xut_ioman_rebalance,
+                 m_xwct_config.xut_ioman_thds_min,
+                 m_xwct_config.xut_ioman_thds_max,
+                 m_xwct_config.xut_ioman_tmdelay,
+                 xit_error);
             break;
         }
 
@@ -392,11 +408,30 @@ x_void_t x_tcp_io_server_t::store_config(const x_workconf_t & xwct_config)
                     ECV_MIN_EPEVENTS,
                     ECV_MAX_EPEVENTS);
 
-    // 校正 IO 管理模块的工作线程数量
-    m_xwct_config.xut_ioman_threads =
-        limit_bound(m_xwct_config.xut_ioman_threads,
-                    1,
-                    limit_lower(2 * std::thread::hardware_concurrency(), 1));
+    // 校正 连接相关对象池的预分配比例
+    m_xwct_config.xut_objpool_warmup =
+        limit_bound(m_xwct_config.xut_objpool_warmup, 0, ECV_MAX_WARMUP);
+
+    // 校正 IO 管理模块的工作线程数量（上限参照 cgroup 的 CPU 配额）
+    x_uint32_t xut_thds_limit = limit_lower(2 * get_cpu_limit(), 1);
+
+    m_xwct_config.xut_ioman_thds_max =
+        limit_bound(m_xwct_config.xut_ioman_thds_max, 0, xut_thds_limit);
+    m_xwct_config.xut_ioman_thds_min =
+        limit_bound(m_xwct_config.xut_ioman_thds_min, 1, limit_lower(m_xwct_config.xut_ioman_thds_max, 1));
+
+    if (m_xwct_config.xut_ioman_thds_max > m_xwct_config.xut_ioman_thds_min)
+    {
+        m_xwct_config.xut_ioman_threads =
+            limit_bound(m_xwct_config.xut_ioman_threads,
+                        m_xwct_config.xut_ioman_thds_min,
+                        m_xwct_config.xut_ioman_thds_max);
+    }
+    else
+    {
+        m_xwct_config.xut_ioman_threads =
+            limit_bound(m_xwct_config.xut_ioman_threads, 1, xut_thds_limit);
+    }
 }
 
 /**********************************************************/
@@ -534,11 +569,20 @@ x_void_t x_tcp_io_server_t::remove_off(x_sockfd_t xfdt_sockfd)
 
 /**********************************************************/
 /**
- * @brief 设置套接字是否监听 写就绪 事件。
+ * @brief 设置套接字是否监听 读就绪、写就绪 事件。
+ * 
+ * @param [in ] xfdt_sockfd : 指定的套接字。
+ * @param [in ] xbt_pollin  : 是否监听 读就绪 事件（IO 通道对象处于背压状态时，暂停监听）。
+ * @param [in ] xbt_pollout : 是否监听 写就绪 事件。
  */
-x_int32_t x_tcp_io_server_t::set_pollout(x_sockfd_t xfdt_sockfd, x_bool_t xbt_pollout)
+x_int32_t x_tcp_io_server_t::set_pollmask(x_sockfd_t xfdt_sockfd, x_bool_t xbt_pollin, x_bool_t xbt_pollout)
 {
-    x_uint32_t xut_events = EPOLLET | EPOLLIN;
+    x_uint32_t xut_events = EPOLLET;
+    if (xbt_pollin)
+    {
+        xut_events |= EPOLLIN;
+    }
+
     if (xbt_pollout)
     {
         xut_events |= EPOLLOUT;
@@ -640,6 +684,11 @@ x_void_t x_tcp_io_server_t::thread_epollio(void)
     xvec_events.resize(workconf().xut_epoll_waitevents);
     x_int32_t xit_size = (x_int32_t)xvec_events.size();
 
+    // 每批 IO 事件所产生的任务对象，暂存于任务提交缓存中，批量提交至线程池
+    x_tcp_io_manager_t::x_task_buffer_t xtask_buffer;
+    xtask_buffer.reserve(2 * xit_size);
+    m_xio_manager.open_submit_buffer(xtask_buffer);
+
     while (m_xbt_running)
     {
         xit_wait = epoll_wait(m_xfdt_epollfd, xvec_events.data(), xit_size, -1);
@@ -652,7 +701,7 @@ x_void_t x_tcp_io_server_t::thread_epollio(void)
         {
             struct epoll_event & xevent = xvec_events[xit_iter];
 
-            if ((xevent.events & EPOLLERR  ) ||
+            if (
 #ifdef EPOLLRDHUP
                 (xevent.events & EPOLLRDHUP) ||
 #endif // EPOLLRDHUP
@@ -662,6 +711,17 @@ x_void_t x_tcp_io_server_t::thread_epollio(void)
                 continue;
             }
 
+            // EPOLLERR 也可能仅为错误队列中 MSG_ZEROCOPY 的完成通知，由此读取并回收
+            if (xevent.events & EPOLLERR)
+            {
+                xit_error = io_handle_errqueue(xit_nthread, xevent.data.fd);
+                if (0 != xit_error)
+                {
+                    io_handle_close(xit_nthread, xevent.data.fd);
+                    continue;
+                }
+            }
+
             if (xevent.events & EPOLLIN)
             {
                 xit_error = io_handle_read(xit_nthread, xevent.data.fd);
@@ -682,7 +742,11 @@ x_void_t x_tcp_io_server_t::thread_epollio(void)
                 }
             }
         }
+
+        m_xio_manager.flush_submit_buffer();
     }
+
+    m_xio_manager.close_submit_buffer();
 }
 
 /**********************************************************/
@@ -870,14 +934,28 @@ x_int32_t x_tcp_io_server_t::io_handle_write(x_int32_t xit_nthread, x_sockfd_t x
         LOGE("[thread_index: %d]m_xio_manager.io_event_write(xfdt_sockfd[%d]) return error : %d",
              xit_nthread, xfdt_sockfd, xit_error);
     }
-    else
+
+    return xit_error;
+}
+
+/**********************************************************/
+/**
+ * @brief 工作线程中，处理 套接字错误（EPOLLERR）事件 的操作接口。
+ * 
+ * @param [in ] xit_nthread : 工作线程的索引编号。
+ * @param [in ] xfdt_sockfd : 套接字描述符。
+ * 
+ * @return x_int32_t
+ *         - 返回 0，表示套接字仍然有效（如 仅为 MSG_ZEROCOPY 的完成通知）；
+ *         - 返回 其他值（错误码），表示套接字已失效。
+ */
+x_int32_t x_tcp_io_server_t::io_handle_errqueue(x_int32_t xit_nthread, x_sockfd_t xfdt_sockfd)
+{
+    x_int32_t xit_error = m_xio_manager.io_event_errqueue(xfdt_sockfd);
+    if (0 != xit_error)
     {
-        // 去除 写就绪 事件
-        xit_error = set_pollout(xfdt_sockfd, X_FALSE);
-        if (0 != xit_error)
-        {
-            LOGE("set_pollout(xfdt_sockfd[%d], X_FALSE) return error : %d", xfdt_sockfd, xit_error);
-        }
+        LOGW("[thread_index: %d]m_xio_manager.io_event_errqueue(xfdt_sockfd[%d]) return error : %d",
+             xit_nthread, xfdt_sockfd, xit_error);
     }
 
     return xit_error;
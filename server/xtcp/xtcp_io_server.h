@@ -50,9 +50,15 @@ public:
         x_uint32_t  xut_epoll_maxsockfds;     ///< 支持打开套接字描述符的最大数量
         x_uint32_t  xut_epoll_waitevents;     ///< 工作线程内每次执行 epoll_wait() 等待的最大事件数量
         x_uint32_t  xut_ioman_threads;        ///< 处理业务层 IO 消息的工作线程数量
+        x_uint32_t  xut_ioman_affinity;       ///< IO 管理模块的线程池是否启用 亲和调度 模式（同一连接的任务固定在同一工作线程上执行）
+        x_uint32_t  xut_ioman_rebalance;      ///< 亲和调度模式下的负载均衡阈值（任务队列深度超出均值的数量，为 0 时不进行负载均衡）
+        x_uint32_t  xut_ioman_thds_min;       ///< IO 管理模块的线程池弹性伸缩时，工作线程数量的下限
+        x_uint32_t  xut_ioman_thds_max;       ///< IO 管理模块的线程池弹性伸缩时，工作线程数量的上限（不大于下限时，不启用弹性伸缩）
+        x_uint32_t  xut_ioman_tmdelay;        ///< IO 管理模块的线程池弹性伸缩时，任务排队延迟的目标值（单位 微秒，为 0 时不启用弹性伸缩）
         x_uint32_t  xut_tmout_kpalive;        ///< 检测存活的超时时间（单位 毫秒）
         x_uint32_t  xut_tmout_baleful;        ///< 检测恶意连接的超时时间（单位 毫秒）
         x_uint32_t  xut_tmout_mverify;        ///< 定时巡检的超时时间（单位 毫秒）
+        x_uint32_t  xut_objpool_warmup;       ///< 连接相关对象池的预分配比例（相对于 xut_epoll_maxsockfds 的百分比，为 0 时不预分配）
 
         x_workconf_t(void)
         {
@@ -77,6 +83,7 @@ public:
         ECV_MAX_SOCKFDS  = 128 * 1024,  ///< 支持的最大套接字连接数
         ECV_MIN_EPEVENTS = 1,           ///< 执行 epoll_wait() 等待操作的最小事件数量
         ECV_MAX_EPEVENTS = 32,          ///< 执行 epoll_wait() 等待操作的最大事件数量
+        ECV_MAX_WARMUP   = 100,         ///< 连接相关对象池的最大预分配比例（百分比）
     } emConstValue;
 
 private:
@@ -168,6 +175,28 @@ public:
      */
     inline x_uint32_t count_sockfd(void) const { return m_xio_manager.count(); }
 
+    /**********************************************************/
+    /**
+     * @brief 返回连接相关对象池（每种对象）的预分配数量（依据 最大连接数 与 预分配比例 计算）。
+     */
+    inline x_uint32_t objpool_count(void) const
+    {
+        return (x_uint32_t)(((x_uint64_t)m_xwct_config.xut_epoll_maxsockfds *
+                             m_xwct_config.xut_objpool_warmup) / 100);
+    }
+
+    /**********************************************************/
+    /**
+     * @brief 读取指定统计项排名前 N 位的连接（IO 通道对象）的运行统计信息快照。
+     * @see   x_tcp_io_manager_t::snapshot_top()
+     */
+    inline x_size_t snapshot_top(x_uint32_t xut_counter,
+                                 x_uint32_t xut_topn,
+                                 std::vector< x_tcp_io_cstat_t > & xvec_cstat)
+    {
+        return m_xio_manager.snapshot_top(xut_counter, xut_topn, xvec_cstat);
+    }
+
     /**********************************************************/
     /**
      * @brief 相关的工作配置参数。
@@ -264,9 +293,13 @@ protected:
 
     /**********************************************************/
     /**
-     * @brief 设置套接字是否监听 写就绪 事件。
+     * @brief 设置套接字是否监听 读就绪、写就绪 事件。
+     * 
+     * @param [in ] xfdt_sockfd : 指定的套接字。
+     * @param [in ] xbt_pollin  : 是否监听 读就绪 事件（IO 通道对象处于背压状态时，暂停监听）。
+     * @param [in ] xbt_pollout : 是否监听 写就绪 事件。
      */
-    x_int32_t set_pollout(x_sockfd_t xfdt_sockfd, x_bool_t xbt_pollout);
+    x_int32_t set_pollmask(x_sockfd_t xfdt_sockfd, x_bool_t xbt_pollin, x_bool_t xbt_pollout);
 
     /**********************************************************/
     /**
@@ -355,6 +388,19 @@ private:
      */
     x_int32_t io_handle_write(x_int32_t xit_nthread, x_sockfd_t xfdt_sockfd);
 
+    /**********************************************************/
+    /**
+     * @brief 工作线程中，处理 套接字错误（EPOLLERR）事件 的操作接口。
+     * 
+     * @param [in ] xit_nthread : 工作线程的索引编号。
+     * @param [in ] xfdt_sockfd : 套接字描述符。
+     * 
+     * @return x_int32_t
+     *         - 返回 0，表示套接字仍然有效（如 仅为 MSG_ZEROCOPY 的完成通知）；
+     *         - 返回 其他值（错误码），表示套接字已失效。
+     */
+    x_int32_t io_handle_errqueue(x_int32_t xit_nthread, x_sockfd_t xfdt_sockfd);
+
     // data members
 private:
     x_workconf_t m_xwct_config;   ///< 相关的工作配置参数
@@ -0,0 +1,322 @@
+/**
+ * @file    xtcp_io_tstat.cpp
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xtcp_io_tstat.cpp
+ * 创建日期：2019年03月14日
+ * 文件标识：
+ * 文件摘要：IO 任务对象（x_tcp_io_task_t）的 排队延迟 与 执行时长 的统计工具类。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2019年03月14日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#include "xcomm.h"
+#include "xtcp_io_tstat.h"
+
+#include <mutex>
+
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @struct x_tstat_slot_t
+ * @brief  单个线程的统计槽（仅由其所属线程写入）。
+ */
+struct x_tstat_slot_t
+{
+    using x_counter_t = std::atomic< x_uint64_t >;
+
+    /**
+     * @struct x_hist_t
+     * @brief  统计槽中的单个直方图。
+     */
+    struct x_hist_t
+    {
+        x_counter_t xult_count;
+        x_counter_t xult_sum_ns;
+        x_counter_t xult_max_ns;
+        x_counter_t xult_buckets[x_tcp_io_tstat_t::ECV_HIST_BUCKETS];
+    };
+
+    x_hist_t       xhist[x_tcp_io_tstat_t::ECV_EVENT_TYPES][x_tcp_io_tstat_t::ETSTAT_KINDS];
+    x_bool_t       xbt_inuse;   ///< 是否有线程正在使用该统计槽（受 _S_tstat_lock 保护）
+    x_tstat_slot_t * xnext_ptr; ///< 链表中的下一个统计槽
+
+    x_tstat_slot_t(void)
+        : xbt_inuse(X_TRUE)
+        , xnext_ptr(X_NULL)
+    {
+        for (auto & xhist_event : xhist)
+        {
+            for (x_hist_t & xhist_kind : xhist_event)
+            {
+                xhist_kind.xult_count.store(0);
+                xhist_kind.xult_sum_ns.store(0);
+                xhist_kind.xult_max_ns.store(0);
+                for (x_counter_t & xult_bucket : xhist_kind.xult_buckets)
+                    xult_bucket.store(0);
+            }
+        }
+    }
+};
+
+/** 统计槽链表的操作锁 */
+static std::mutex _S_tstat_lock;
+
+/** 统计槽链表（统计槽只增不减，线程退出后由后续线程复用） */
+static x_tstat_slot_t * _S_tstat_slots = X_NULL;
+
+/**
+ * @struct x_tstat_owner_t
+ * @brief  线程局部的统计槽持有者，线程退出时归还统计槽。
+ */
+struct x_tstat_owner_t
+{
+    x_tstat_slot_t * xslot_ptr = X_NULL;
+
+    ~x_tstat_owner_t(void)
+    {
+        if (X_NULL != xslot_ptr)
+        {
+            std::lock_guard< std::mutex > xautolock(_S_tstat_lock);
+            xslot_ptr->xbt_inuse = X_FALSE;
+            xslot_ptr = X_NULL;
+        }
+    }
+};
+
+static thread_local x_tstat_owner_t _S_tstat_owner;
+
+/**********************************************************/
+/**
+ * @brief 获取当前线程的统计槽（首次调用时，复用空闲的或新建统计槽）。
+ */
+static x_tstat_slot_t * tstat_slot(void)
+{
+    if (X_NULL != _S_tstat_owner.xslot_ptr)
+    {
+        return _S_tstat_owner.xslot_ptr;
+    }
+
+    std::lock_guard< std::mutex > xautolock(_S_tstat_lock);
+
+    x_tstat_slot_t * xslot_ptr = _S_tstat_slots;
+    while ((X_NULL != xslot_ptr) && xslot_ptr->xbt_inuse)
+    {
+        xslot_ptr = xslot_ptr->xnext_ptr;
+    }
+
+    if (X_NULL == xslot_ptr)
+    {
+        xslot_ptr = new x_tstat_slot_t();
+        xslot_ptr->xnext_ptr = _S_tstat_slots;
+        _S_tstat_slots = xslot_ptr;
+    }
+
+    xslot_ptr->xbt_inuse = X_TRUE;
+    _S_tstat_owner.xslot_ptr = xslot_ptr;
+
+    return xslot_ptr;
+}
+
+/**********************************************************/
+/**
+ * @brief IO 事件类型 转换为 统计数组的索引号（EIO_TASK_CREATED ~ EIO_TASK_MSGPUMP 依次为 0x0010 ~ 0x0050）。
+ * 
+ * @return x_uint32_t
+ *         - 返回 ECV_EVENT_TYPES 时，表示事件类型无效。
+ */
+static inline x_uint32_t tstat_index(x_uint32_t xut_event)
+{
+    x_uint32_t xut_index = (xut_event >> 4) - 1;
+    return ((0 == (xut_event & 0x000F)) && (xut_index < x_tcp_io_tstat_t::ECV_EVENT_TYPES)) ?
+           xut_index : x_tcp_io_tstat_t::ECV_EVENT_TYPES;
+}
+
+/**********************************************************/
+/**
+ * @brief 将样本值写入单个直方图（仅由所属线程写入，使用 relaxed 读写，避免 LOCK 指令开销）。
+ */
+static inline x_void_t tstat_hist_add(x_tstat_slot_t::x_hist_t & xhist, x_int64_t xlit_value)
+{
+    const x_uint64_t xult_value = (xlit_value > 0) ? (x_uint64_t)xlit_value : 0;
+
+    // 区间索引号 即 样本值的有效二进制位数
+#ifdef _MSC_VER
+    x_uint32_t xut_bucket = 0;
+    for (x_uint64_t xult_bits = xult_value; 0 != xult_bits; xult_bits >>= 1)
+        ++xut_bucket;
+#else // !_MSC_VER
+    x_uint32_t xut_bucket = (0 == xult_value) ? 0 : (64 - __builtin_clzll(xult_value));
+#endif // _MSC_VER
+    if (xut_bucket >= x_tcp_io_tstat_t::ECV_HIST_BUCKETS)
+        xut_bucket = x_tcp_io_tstat_t::ECV_HIST_BUCKETS - 1;
+
+    xhist.xult_count.store(xhist.xult_count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    xhist.xult_sum_ns.store(xhist.xult_sum_ns.load(std::memory_order_relaxed) + xult_value, std::memory_order_relaxed);
+    if (xult_value > xhist.xult_max_ns.load(std::memory_order_relaxed))
+        xhist.xult_max_ns.store(xult_value, std::memory_order_relaxed);
+    xhist.xult_buckets[xut_bucket].store(
+        xhist.xult_buckets[xut_bucket].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// x_tcp_io_tstat_t
+
+//====================================================================
+
+// 
+// x_tcp_io_tstat_t::x_histogram_t
+// 
+
+/**********************************************************/
+/**
+ * @brief 估算样本的百分位值（以所在区间的上界估算，单位 纳秒）。
+ * 
+ * @param [in ] xut_percent : 百分位（如 50、99）。
+ */
+x_uint64_t x_tcp_io_tstat_t::x_histogram_t::percentile_ns(x_uint32_t xut_percent) const
+{
+    if (0 == xult_count)
+    {
+        return 0;
+    }
+
+    const x_uint64_t xult_rank = (xult_count * limit_upper(xut_percent, 100U) + 99) / 100;
+
+    x_uint64_t xult_accum = 0;
+    for (x_uint32_t xut_iter = 0; xut_iter < ECV_HIST_BUCKETS; ++xut_iter)
+    {
+        xult_accum += xult_buckets[xut_iter];
+        if ((xult_accum >= xult_rank) && (xult_accum > 0))
+        {
+            // 区间上界不超过实际的最大值
+            x_uint64_t xult_upper = (0 == xut_iter) ? 0 : ((1ULL << xut_iter) - 1);
+            return (xult_upper < xult_max_ns) ? xult_upper : xult_max_ns;
+        }
+    }
+
+    return xult_max_ns;
+}
+
+//====================================================================
+
+// 
+// x_tcp_io_tstat_t : common invoking
+// 
+
+/**********************************************************/
+/**
+ * @brief 记录一次任务执行的统计数据（由工作线程调用）。
+ * 
+ * @param [in ] xut_event   : 任务对象的 IO 事件类型（参看 x_tcp_io_task_t::emIoTaskEventType）。
+ * @param [in ] xlit_delay  : 排队延迟（单位 纳秒）。
+ * @param [in ] xlit_svtime : 执行时长（单位 纳秒）。
+ */
+x_void_t x_tcp_io_tstat_t::record(x_uint32_t xut_event, x_int64_t xlit_delay, x_int64_t xlit_svtime)
+{
+    const x_uint32_t xut_index = tstat_index(xut_event);
+    if (xut_index >= ECV_EVENT_TYPES)
+    {
+        return;
+    }
+
+    x_tstat_slot_t * xslot_ptr = tstat_slot();
+    tstat_hist_add(xslot_ptr->xhist[xut_index][ETSTAT_DELAY  ], xlit_delay );
+    tstat_hist_add(xslot_ptr->xhist[xut_index][ETSTAT_SERVICE], xlit_svtime);
+}
+
+/**********************************************************/
+/**
+ * @brief 合并所有线程的统计数据，读取指定事件类型的直方图。
+ * 
+ * @param [in ] xut_event : 任务对象的 IO 事件类型（参看 x_tcp_io_task_t::emIoTaskEventType）。
+ * @param [in ] xut_kind  : 统计项的类型（参看 emStatKind）。
+ * @param [out] xhistogram: 操作成功返回的直方图数据。
+ * 
+ * @return x_bool_t
+ *         - 成功，返回 X_TRUE；
+ *         - 失败，返回 X_FALSE（参数无效）。
+ */
+x_bool_t x_tcp_io_tstat_t::snapshot(x_uint32_t xut_event, x_uint32_t xut_kind, x_histogram_t & xhistogram)
+{
+    const x_uint32_t xut_index = tstat_index(xut_event);
+    if ((xut_index >= ECV_EVENT_TYPES) || (xut_kind >= ETSTAT_KINDS))
+    {
+        return X_FALSE;
+    }
+
+    memset(&xhistogram, 0, sizeof(x_histogram_t));
+
+    std::lock_guard< std::mutex > xautolock(_S_tstat_lock);
+
+    for (x_tstat_slot_t * xslot_ptr = _S_tstat_slots; X_NULL != xslot_ptr; xslot_ptr = xslot_ptr->xnext_ptr)
+    {
+        const x_tstat_slot_t::x_hist_t & xhist = xslot_ptr->xhist[xut_index][xut_kind];
+
+        xhistogram.xult_count  += xhist.xult_count.load(std::memory_order_relaxed);
+        xhistogram.xult_sum_ns += xhist.xult_sum_ns.load(std::memory_order_relaxed);
+        xhistogram.xult_max_ns  = limit_lower(xhistogram.xult_max_ns, xhist.xult_max_ns.load(std::memory_order_relaxed));
+
+        for (x_uint32_t xut_iter = 0; xut_iter < ECV_HIST_BUCKETS; ++xut_iter)
+        {
+            xhistogram.xult_buckets[xut_iter] += xhist.xult_buckets[xut_iter].load(std::memory_order_relaxed);
+        }
+    }
+
+    return X_TRUE;
+}
+
+/**********************************************************/
+/**
+ * @brief 将各个事件类型的统计数据输出至日志。
+ */
+x_void_t x_tcp_io_tstat_t::dump_log(void)
+{
+    static x_cstring_t xszt_event[ECV_EVENT_TYPES] =
+    {
+        "EIO_TASK_CREATED",
+        "EIO_TASK_DESTROY",
+        "EIO_TASK_READING",
+        "EIO_TASK_WRITING",
+        "EIO_TASK_MSGPUMP",
+    };
+
+    x_histogram_t xhist_delay;
+    x_histogram_t xhist_svtime;
+
+    for (x_uint32_t xut_index = 0; xut_index < ECV_EVENT_TYPES; ++xut_index)
+    {
+        const x_uint32_t xut_event = (xut_index + 1) << 4;
+
+        snapshot(xut_event, ETSTAT_DELAY  , xhist_delay );
+        snapshot(xut_event, ETSTAT_SERVICE, xhist_svtime);
+
+        if (0 == xhist_delay.xult_count)
+        {
+            continue;
+        }
+
+        LOGI("[%s] count[%llu] delay(us)[mean:%llu, p50:%llu, p99:%llu, max:%llu] "
+             "service(us)[mean:%llu, p50:%llu, p99:%llu, max:%llu]",
+             xszt_event[xut_index],
+             xhist_delay.xult_count,
+             xhist_delay.mean_ns() / 1000ULL,
+             xhist_delay.percentile_ns(50) / 1000ULL,
+             xhist_delay.percentile_ns(99) / 1000ULL,
+             xhist_delay.xult_max_ns / 1000ULL,
+             xhist_svtime.mean_ns() / 1000ULL,
+             xhist_svtime.percentile_ns(50) / 1000ULL,
+             xhist_svtime.percentile_ns(99) / 1000ULL,
+             xhist_svtime.xult_max_ns / 1000ULL);
+    }
+}
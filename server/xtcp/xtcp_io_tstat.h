@@ -0,0 +1,133 @@
+/**
+ * @file    xtcp_io_tstat.h
+ * <pre>
+ * Copyright (c) 2019, Gaaagaa All rights reserved.
+ * 
+ * 文件名称：xtcp_io_tstat.h
+ * 创建日期：2019年03月14日
+ * 文件标识：
+ * 文件摘要：IO 任务对象（x_tcp_io_task_t）的 排队延迟 与 执行时长 的统计工具类。
+ * 
+ * 当前版本：1.0.0.0
+ * 作    者：
+ * 完成日期：2019年03月14日
+ * 版本摘要：
+ * 
+ * 历史版本：
+ * 原作者  ：
+ * 完成日期：
+ * 版本摘要：
+ * </pre>
+ */
+
+#ifndef __XTCP_IO_TSTAT_H__
+#define __XTCP_IO_TSTAT_H__
+
+#include "xtypes.h"
+#include <atomic>
+
+////////////////////////////////////////////////////////////////////////////////
+// x_tcp_io_tstat_t
+
+/**
+ * @class x_tcp_io_tstat_t
+ * @brief IO 任务对象的 排队延迟 与 执行时长 的统计工具类（按 IO 事件类型分别统计）。
+ * 
+ * @note
+ * <pre>
+ *   1. 统计值以 2 的幂次（单位 纳秒）划分区间，记录为直方图；
+ *   2. 每个工作线程写入各自的统计槽（仅有 relaxed 原子读写，无锁竞争），
+ *      读取时（snapshot()）再合并所有统计槽的数据；
+ *   3. 线程退出后，其统计槽保留数据，并由后续新建的线程继续使用。
+ * </pre>
+ */
+class x_tcp_io_tstat_t
+{
+    // common data types
+public:
+    /**
+     * @enum  emConstValue
+     * @brief 相关的枚举常量值。
+     */
+    typedef enum emConstValue
+    {
+        ECV_EVENT_TYPES  = 5,    ///< 统计的 IO 事件类型数量（EIO_TASK_CREATED ~ EIO_TASK_MSGPUMP）
+        ECV_HIST_BUCKETS = 40,   ///< 直方图的区间数量（第 i 个区间为 [2^(i-1), 2^i) 纳秒，末区间含所有更大值）
+    } emConstValue;
+
+    /**
+     * @enum  emStatKind
+     * @brief 统计项的类型。
+     */
+    typedef enum emStatKind
+    {
+        ETSTAT_DELAY   = 0,      ///< 排队延迟（任务提交至开始执行的时长）
+        ETSTAT_SERVICE = 1,      ///< 执行时长
+        ETSTAT_KINDS   = 2,      ///< 统计项的类型数量
+    } emStatKind;
+
+    /**
+     * @struct x_histogram_t
+     * @brief  合并后的直方图数据。
+     */
+    typedef struct x_histogram_t
+    {
+        x_uint64_t xult_count;                      ///< 统计的样本数量
+        x_uint64_t xult_sum_ns;                     ///< 样本值的累加和（单位 纳秒）
+        x_uint64_t xult_max_ns;                     ///< 样本的最大值（单位 纳秒）
+        x_uint64_t xult_buckets[ECV_HIST_BUCKETS];  ///< 各个区间的样本数量
+
+        /**********************************************************/
+        /**
+         * @brief 返回样本的平均值（单位 纳秒）。
+         */
+        inline x_uint64_t mean_ns(void) const
+        {
+            return (xult_count > 0) ? (xult_sum_ns / xult_count) : 0;
+        }
+
+        /**********************************************************/
+        /**
+         * @brief 估算样本的百分位值（以所在区间的上界估算，单位 纳秒）。
+         * 
+         * @param [in ] xut_percent : 百分位（如 50、99）。
+         */
+        x_uint64_t percentile_ns(x_uint32_t xut_percent) const;
+    } x_histogram_t;
+
+    // common invoking
+public:
+    /**********************************************************/
+    /**
+     * @brief 记录一次任务执行的统计数据（由工作线程调用）。
+     * 
+     * @param [in ] xut_event   : 任务对象的 IO 事件类型（参看 x_tcp_io_task_t::emIoTaskEventType）。
+     * @param [in ] xlit_delay  : 排队延迟（单位 纳秒）。
+     * @param [in ] xlit_svtime : 执行时长（单位 纳秒）。
+     */
+    static x_void_t record(x_uint32_t xut_event, x_int64_t xlit_delay, x_int64_t xlit_svtime);
+
+    /**********************************************************/
+    /**
+     * @brief 合并所有线程的统计数据，读取指定事件类型的直方图。
+     * 
+     * @param [in ] xut_event : 任务对象的 IO 事件类型（参看 x_tcp_io_task_t::emIoTaskEventType）。
+     * @param [in ] xut_kind  : 统计项的类型（参看 emStatKind）。
+     * @param [out] xhistogram: 操作成功返回的直方图数据。
+     * 
+     * @return x_bool_t
+     *         - 成功，返回 X_TRUE；
+     *         - 失败，返回 X_FALSE（参数无效）。
+     */
+    static x_bool_t snapshot(x_uint32_t xut_event, x_uint32_t xut_kind, x_histogram_t & xhistogram);
+
+    /**********************************************************/
+    /**
+     * @brief 将各个事件类型的统计数据输出至日志。
+     */
+    static x_void_t dump_log(void);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif // __XTCP_IO_TSTAT_H__